@@ -0,0 +1,218 @@
+/* This file is part of CPUSim
+ *
+ * Native disassembly benchmark for the patched cs.c of CPUSim.
+ * Measures instructions per second and heap allocations for:
+ *   decode:        cs_disasm without instruction details
+ *   decode_detail: cs_disasm with CS_OPT_DETAIL (as used by disassemblerService.ts)
+ *   detail_export: cs_disasm with CS_OPT_DETAIL followed by print_insn_detail for every instruction
+ *
+ * Usage: capstone_benchmark [iterations] [synthetic corpus size in bytes]
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <capstone/capstone.h>
+
+#include "corpus.h"
+
+#define DEFAULT_ITERATIONS 2000
+#define DEFAULT_SYNTHETIC_SIZE (1024 * 1024)
+// same buffer size as in disassemblerService.ts
+#define DETAIL_BUFFER_SIZE 2000
+
+// defined in the patched cs.c
+int print_insn_detail(csh ud, cs_insn *ins, char *outputString);
+
+typedef enum benchmark_mode {
+	MODE_DECODE,
+	MODE_DECODE_DETAIL,
+	MODE_DETAIL_EXPORT,
+} benchmark_mode;
+
+static const char *mode_names[] = { "decode", "decode_detail", "detail_export" };
+
+typedef struct allocation_counter {
+	unsigned long long allocations;
+	unsigned long long bytes;
+} allocation_counter;
+
+static allocation_counter counter;
+
+static void *counting_malloc(size_t size)
+{
+	counter.allocations++;
+	counter.bytes += size;
+	return malloc(size);
+}
+
+static void *counting_calloc(size_t nmemb, size_t size)
+{
+	counter.allocations++;
+	counter.bytes += nmemb * size;
+	return calloc(nmemb, size);
+}
+
+static void *counting_realloc(void *ptr, size_t size)
+{
+	counter.allocations++;
+	counter.bytes += size;
+	return realloc(ptr, size);
+}
+
+static double now_seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static size_t decode_once(csh handle, const uint8_t *code, size_t size, benchmark_mode mode, char *detail)
+{
+	cs_insn *insn;
+	size_t count, i;
+
+	count = cs_disasm(handle, code, size, 0, 0, &insn);
+	if (mode == MODE_DETAIL_EXPORT) {
+		for (i = 0; i < count; i++) {
+			print_insn_detail(handle, &insn[i], detail);
+		}
+	}
+	if (count) {
+		cs_free(insn, count);
+	}
+	return count;
+}
+
+static void run_benchmark(csh handle, const char *corpus_name, const corpus_entry *entries, size_t entry_count,
+		benchmark_mode mode, unsigned int iterations)
+{
+	char detail[DETAIL_BUFFER_SIZE];
+	unsigned long long instructions = 0;
+	double start, seconds;
+	unsigned int iteration;
+	size_t i;
+
+	cs_option(handle, CS_OPT_DETAIL, mode == MODE_DECODE ? CS_OPT_OFF : CS_OPT_ON);
+	memset(&counter, 0, sizeof(counter));
+
+	start = now_seconds();
+	for (iteration = 0; iteration < iterations; iteration++) {
+		for (i = 0; i < entry_count; i++) {
+			instructions += decode_once(handle, entries[i].code, entries[i].size, mode, detail);
+		}
+	}
+	seconds = now_seconds() - start;
+
+	printf("%-14s %-10s %12llu %10.3f %14.0f %12llu %14llu %10.2f\n",
+			mode_names[mode], corpus_name, instructions, seconds,
+			seconds > 0 ? (double)instructions / seconds : 0.0,
+			counter.allocations, counter.bytes,
+			instructions ? (double)counter.allocations / (double)instructions : 0.0);
+}
+
+/*
+ * Builds a synthetic corpus by concatenating randomly chosen (fixed seed) valid instructions of the seed corpus.
+ * Data bytes of the seed programs are left out because decoding stops at the first invalid instruction.
+ */
+static uint8_t *build_synthetic_corpus(csh handle, size_t target_size, size_t *size)
+{
+	const uint8_t *slices[1024];
+	uint16_t slice_sizes[1024];
+	size_t slice_count = 0, i, j, count, position = 0;
+	uint32_t random = 0x43505553; // "CPUS"
+	uint8_t *synthetic;
+	cs_insn *insn;
+
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_OFF);
+	for (i = 0; i < CORPUS_ENTRIES; i++) {
+		count = cs_disasm(handle, corpus[i].code, corpus[i].size, 0, 0, &insn);
+		for (j = 0; j < count && slice_count < 1024; j++) {
+			slices[slice_count] = corpus[i].code + insn[j].address;
+			slice_sizes[slice_count] = insn[j].size;
+			slice_count++;
+		}
+		if (count) {
+			cs_free(insn, count);
+		}
+	}
+
+	synthetic = malloc(target_size + 16);
+	if (synthetic == NULL || slice_count == 0) {
+		free(synthetic);
+		return NULL;
+	}
+	while (position < target_size) {
+		random = random * 1664525u + 1013904223u;
+		i = (random >> 8) % slice_count;
+		memcpy(synthetic + position, slices[i], slice_sizes[i]);
+		position += slice_sizes[i];
+	}
+	*size = position;
+	return synthetic;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned int iterations = DEFAULT_ITERATIONS;
+	size_t synthetic_target = DEFAULT_SYNTHETIC_SIZE;
+	corpus_entry synthetic_entry;
+	uint8_t *synthetic;
+	cs_opt_mem mem;
+	csh handle;
+	int mode;
+
+	if (argc > 1) {
+		iterations = (unsigned int)strtoul(argv[1], NULL, 10);
+	}
+	if (argc > 2) {
+		synthetic_target = (size_t)strtoul(argv[2], NULL, 10);
+	}
+
+	mem.malloc = counting_malloc;
+	mem.calloc = counting_calloc;
+	mem.realloc = counting_realloc;
+	mem.free = free;
+	mem.vsnprintf = vsnprintf;
+	cs_option(0, CS_OPT_MEM, (size_t)&mem);
+
+	if (cs_open(CS_ARCH_X86, CS_MODE_64, &handle) != CS_ERR_OK) {
+		fprintf(stderr, "cs_open failed\n");
+		return 1;
+	}
+
+	synthetic_entry.name = "synthetic";
+	synthetic_entry.code = synthetic = build_synthetic_corpus(handle, synthetic_target, &synthetic_entry.size);
+	if (synthetic == NULL) {
+		fprintf(stderr, "could not build the synthetic corpus\n");
+		cs_close(&handle);
+		return 1;
+	}
+
+	printf("seed corpus: %u programs x %u iterations, synthetic corpus: %zu bytes\n",
+			(unsigned int)CORPUS_ENTRIES, iterations, synthetic_entry.size);
+	printf("%-14s %-10s %12s %10s %14s %12s %14s %10s\n",
+			"mode", "corpus", "instructions", "seconds", "instructions/s", "allocations", "alloc bytes", "alloc/insn");
+	for (mode = MODE_DECODE; mode <= MODE_DETAIL_EXPORT; mode++) {
+		run_benchmark(handle, "seed", corpus, CORPUS_ENTRIES, (benchmark_mode)mode, iterations);
+		run_benchmark(handle, "synthetic", &synthetic_entry, 1, (benchmark_mode)mode, 1);
+	}
+
+	free(synthetic);
+	cs_close(&handle);
+	return 0;
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+# This file is part of CPUSim
+#
+# Checks the print_insn_detail output of the CPUSIM_COMPACT_DETAIL build (build.py --cpusim) against the full build.
+# Every field read by x86/src/services/disassembler/instructionOperandsService.ts has to be printed with the same
+# value as in the full build, and the compact build must not print anything else.
+#
+#   check_compact_detail.py <capstone_detail_dump_full> <capstone_detail_dump_compact>
+#
+# CPUSim is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, version 2 of the License only.
+#
+# CPUSim is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+
+import json
+import subprocess
+import sys
+
+# keep in sync with createInstructionOperandsFromJSON and createOperandFromJSON in instructionOperandsService.ts
+# (EFLAGS is only read if EFLAGS_MASKS is missing, the compact build always prints EFLAGS_MASKS)
+DETAIL_FIELDS = {
+    'Opcode', 'operands', 'registers_read', 'registers_modified', 'registers_read_mask', 'registers_modified_mask',
+    'EFLAGS_MASKS', 'FPU_FLAGS',
+}
+OPERAND_FIELDS = {'type', 'value', 'reg_base', 'reg_index', 'scale', 'disp', 'size', 'access'}
+
+
+def dump(executable):
+    output = subprocess.run([executable], check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    return [json.loads(line) for line in output.splitlines() if line]
+
+
+def pick(detail, fields):
+    return {key: value for key, value in detail.items() if key in fields}
+
+
+def expected_compact(full_detail):
+    expected = pick(full_detail, DETAIL_FIELDS)
+    if 'operands' in expected:
+        expected['operands'] = [pick(operand, OPERAND_FIELDS) for operand in expected['operands']]
+    return expected
+
+
+def main():
+    if len(sys.argv) != 3:
+        print('usage: check_compact_detail.py <full dump> <compact dump>', file=sys.stderr)
+        return 2
+    full = dump(sys.argv[1])
+    compact = dump(sys.argv[2])
+    if len(full) != len(compact):
+        print('instruction count differs: full %d, compact %d' % (len(full), len(compact)))
+        return 1
+    if not compact:
+        print('the corpus did not decode')
+        return 1
+
+    errors = 0
+    for full_line, compact_line in zip(full, compact):
+        location = '%s at 0x%x' % (full_line['program'], full_line['address'])
+        if (compact_line['program'], compact_line['address']) != (full_line['program'], full_line['address']):
+            print('%s: instruction boundaries differ' % location)
+            return 1
+        detail = compact_line['detail']
+        extra = set(detail) - DETAIL_FIELDS
+        extra_operand = set().union(*(set(operand) for operand in detail.get('operands', []))) - OPERAND_FIELDS
+        if extra or extra_operand:
+            print('%s: fields not read by CPUSim printed: %s' % (location, sorted(extra | extra_operand)))
+            errors += 1
+        expected = expected_compact(full_line['detail'])
+        if detail != expected:
+            print('%s:\n  expected %s\n  printed  %s' % (location, json.dumps(expected), json.dumps(detail)))
+            errors += 1
+
+    print('%d instructions compared, %d errors' % (len(full), errors))
+    return 1 if errors else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,124 @@
+/* This file is part of CPUSim
+ *
+ * Corpus of the native disassembly benchmark.
+ * The demo programs are the NASM output of x86/src/services/editorService/demoPrograms.ts,
+ * the test programs are machineCode0 and machineCode1 of x86/tests/unit/services/testDataNasm.ts.
+ * Regenerate the entries when these sources change.
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CPUSIM_BENCHMARK_CORPUS_H
+#define CPUSIM_BENCHMARK_CORPUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct corpus_entry {
+	const char *name;
+	const uint8_t *code;
+	size_t size;
+} corpus_entry;
+
+static const uint8_t demo_add[] = {
+	0x48, 0x8b, 0x04, 0x25, 0x00, 0x00, 0x00, 0x00, 0x48, 0x8b, 0x1c, 0x25,
+	0x30, 0x00, 0x00, 0x00, 0x48, 0x01, 0xc3, 0x48, 0x89, 0x1c, 0x25, 0x20,
+	0x00, 0x00, 0x00,
+};
+
+static const uint8_t demo_swap[] = {
+	0x48, 0x8b, 0x04, 0x25, 0x20, 0x00, 0x00, 0x00, 0x48, 0x8b, 0x1c, 0x25,
+	0x28, 0x00, 0x00, 0x00, 0x48, 0x89, 0x1c, 0x25, 0x20, 0x00, 0x00, 0x00,
+	0x48, 0x89, 0x04, 0x25, 0x28, 0x00, 0x00, 0x00, 0x37, 0x13, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xfe, 0xca, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t demo_multiply[] = {
+	0xb8, 0x4e, 0x00, 0x00, 0x00, 0xbb, 0x03, 0x00, 0x00, 0x00, 0x48, 0x01,
+	0xc1, 0x48, 0xff, 0xcb, 0x48, 0x83, 0xfb, 0x00, 0x75, 0xf4, 0x48, 0x89,
+	0x0c, 0x25, 0x50, 0x00, 0x00, 0x00, 0x48, 0x31, 0xc0, 0x48, 0x31, 0xc9,
+};
+
+static const uint8_t demo_stack[] = {
+	0x6a, 0x06, 0xff, 0x34, 0x25, 0x06, 0x00, 0x00, 0x00, 0x48, 0x8b, 0x04,
+	0x25, 0x00, 0x00, 0x00, 0x00, 0x50, 0x5b, 0x8f, 0x04, 0x25, 0x40, 0x00,
+	0x00, 0x00,
+};
+
+static const uint8_t demo_jump[] = {
+	0x48, 0xff, 0xc0, 0x48, 0x83, 0xf8, 0x03, 0x75, 0xf7,
+};
+
+static const uint8_t demo_surprise[] = {
+	0x8a, 0x04, 0x25, 0x74, 0x00, 0x00, 0x00, 0x8a, 0x04, 0x25, 0x78, 0x00,
+	0x00, 0x00, 0x8a, 0x04, 0x25, 0x96, 0x00, 0x00, 0x00, 0x8a, 0x04, 0x25,
+	0xa4, 0x00, 0x00, 0x00, 0x8a, 0x04, 0x25, 0xb5, 0x00, 0x00, 0x00, 0x8a,
+	0x04, 0x25, 0xc6, 0x00, 0x00, 0x00, 0x8a, 0x04, 0x25, 0xb7, 0x00, 0x00,
+	0x00, 0x8a, 0x04, 0x25, 0xa8, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t test_code_0[] = {
+	0x48, 0x8b, 0x04, 0x25, 0x20, 0x00, 0x00, 0x00, 0x48, 0x8b, 0x1c, 0x25,
+	0x28, 0x00, 0x00, 0x00, 0x48, 0x89, 0x1c, 0x25, 0x20, 0x00, 0x00, 0x00,
+	0x48, 0x89, 0x04, 0x25, 0x28, 0x00, 0x00, 0x00, 0x37, 0x13, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xfe, 0xca, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t test_code_1[] = {
+	0x55, 0x48, 0x8b, 0x04, 0x25, 0xcf, 0x00, 0x00, 0x00, 0xbf, 0x01, 0x00,
+	0x00, 0x00, 0xb9, 0x04, 0x00, 0x00, 0x00, 0x48, 0x0f, 0xaf, 0x04, 0x25,
+	0xf7, 0x00, 0x00, 0x00, 0x48, 0x03, 0x04, 0xfd, 0xcf, 0x00, 0x00, 0x00,
+	0x48, 0xff, 0xc7, 0xe2, 0xea, 0x48, 0x89, 0xc6, 0x48, 0xbf, 0xb8, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x48,
+	0x8b, 0x04, 0x25, 0x1f, 0x01, 0x00, 0x00, 0x48, 0x8b, 0x0c, 0x25, 0x27,
+	0x01, 0x00, 0x00, 0x48, 0x0f, 0xaf, 0x04, 0x25, 0xf7, 0x00, 0x00, 0x00,
+	0x48, 0x03, 0x04, 0xcd, 0xf7, 0x00, 0x00, 0x00, 0xe2, 0xed, 0x48, 0x89,
+	0xc6, 0x48, 0xbf, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb8,
+	0x00, 0x00, 0x00, 0x00, 0x48, 0x8b, 0x0c, 0x25, 0x67, 0x01, 0x00, 0x00,
+	0xdd, 0x04, 0xcd, 0x2f, 0x01, 0x00, 0x00, 0xdc, 0x0c, 0x25, 0x57, 0x01,
+	0x00, 0x00, 0xdc, 0x04, 0xcd, 0x27, 0x01, 0x00, 0x00, 0xe2, 0xf0, 0xdd,
+	0x1c, 0x25, 0x5f, 0x01, 0x00, 0x00, 0xf3, 0x0f, 0x7e, 0x04, 0x25, 0x5f,
+	0x01, 0x00, 0x00, 0x48, 0xbf, 0xc8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xb8, 0x01, 0x00, 0x00, 0x00, 0x5d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+	0xc3, 0x00, 0x00, 0x00, 0x61, 0x20, 0x20, 0x25, 0x6c, 0x64, 0x0a, 0x00,
+	0x61, 0x61, 0x20, 0x25, 0x6c, 0x64, 0x0a, 0x00, 0x61, 0x66, 0x20, 0x25,
+	0x65, 0x0a, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf9, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf7,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x16,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf9, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0xc0, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x36, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x1c, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x40, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x1c, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04,
+	0x00, 0x00, 0x00,
+};
+
+static const corpus_entry corpus[] = {
+	{ "demo add", demo_add, sizeof(demo_add) },
+	{ "demo swap", demo_swap, sizeof(demo_swap) },
+	{ "demo multiply", demo_multiply, sizeof(demo_multiply) },
+	{ "demo stack", demo_stack, sizeof(demo_stack) },
+	{ "demo jump", demo_jump, sizeof(demo_jump) },
+	{ "demo surprise", demo_surprise, sizeof(demo_surprise) },
+	{ "testDataNasm machineCode0", test_code_0, sizeof(test_code_0) },
+	{ "testDataNasm machineCode1", test_code_1, sizeof(test_code_1) },
+};
+
+#define CORPUS_ENTRIES (sizeof(corpus) / sizeof(corpus[0]))
+
+#endif
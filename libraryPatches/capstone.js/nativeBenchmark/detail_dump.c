@@ -0,0 +1,65 @@
+/* This file is part of CPUSim
+ *
+ * Prints the output of print_insn_detail for every instruction of the benchmark corpus,
+ * one JSON object per line: { "program": <corpus entry>, "address": <offset>, "detail": <print_insn_detail> }
+ * Linked once against the full and once against the CPUSIM_COMPACT_DETAIL build, see check_compact_detail.py.
+ *
+ * Usage: capstone_detail_dump
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <capstone/capstone.h>
+
+#include "corpus.h"
+
+// same buffer size as in disassemblerService.ts
+#define DETAIL_BUFFER_SIZE 2000
+
+// defined in the patched cs.c
+int print_insn_detail(csh ud, cs_insn *ins, char *outputString);
+
+int main(void)
+{
+	char detail[DETAIL_BUFFER_SIZE];
+	cs_insn *insn;
+	size_t count, i, j;
+	csh handle;
+
+	if (cs_open(CS_ARCH_X86, CS_MODE_64, &handle) != CS_ERR_OK) {
+		fprintf(stderr, "cs_open failed\n");
+		return 1;
+	}
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+	for (i = 0; i < CORPUS_ENTRIES; i++) {
+		count = cs_disasm(handle, corpus[i].code, corpus[i].size, 0, 0, &insn);
+		for (j = 0; j < count; j++) {
+			if (print_insn_detail(handle, &insn[j], detail) != 0) {
+				fprintf(stderr, "%s: no detail at 0x%llx\n", corpus[i].name, (unsigned long long)insn[j].address);
+				cs_free(insn, count);
+				cs_close(&handle);
+				return 1;
+			}
+			printf("{ \"program\": \"%s\", \"address\": %llu, \"detail\": %s }\n",
+					corpus[i].name, (unsigned long long)insn[j].address, detail);
+		}
+		if (count) {
+			cs_free(insn, count);
+		}
+	}
+
+	cs_close(&handle);
+	return 0;
+}
@@ -0,0 +1,137 @@
+/* This file is part of CPUSim
+ *
+ * Checks the addresses, sizes and access modes written by resolve_memory_operands of the patched cs.c
+ * for explicit, RIP-relative and implicit stack operands. Registered as ctest "resolve_memory_operands".
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <capstone/capstone.h>
+
+#define MAX_ACCESSES 4
+
+// same layout as in the patched cs.c
+typedef struct cpusim_memory_access {
+	uint64_t address;
+	uint32_t size;
+	uint32_t access;
+} cpusim_memory_access;
+
+// defined in the patched cs.c
+int resolve_memory_operands(csh ud, cs_insn *ins, const uint64_t *registers, cpusim_memory_access *accesses, int maxAccesses);
+
+typedef struct register_value {
+	x86_reg reg;
+	uint64_t value;
+} register_value;
+
+typedef struct resolver_case {
+	const char *name;
+	uint8_t code[16];
+	size_t size;
+	uint64_t address;
+	register_value registers[3];
+	int count;
+	cpusim_memory_access expected[MAX_ACCESSES];
+} resolver_case;
+
+static const resolver_case cases[] = {
+	{ "push qword [0x0]", { 0xff, 0x34, 0x25, 0x00, 0x00, 0x00, 0x00 }, 7, 0x7,
+		{ { X86_REG_RSP, 0x120 } }, 2,
+		{ { 0x0, 8, CS_AC_READ }, { 0x118, 8, CS_AC_WRITE } } },
+	{ "pop rbx", { 0x5b }, 1, 0x0,
+		{ { X86_REG_RSP, 0x118 } }, 1,
+		{ { 0x118, 8, CS_AC_READ } } },
+	{ "call 0x15", { 0xe8, 0x00, 0x00, 0x00, 0x00 }, 5, 0x10,
+		{ { X86_REG_RSP, 0x120 } }, 1,
+		{ { 0x118, 8, CS_AC_WRITE } } },
+	{ "ret", { 0xc3 }, 1, 0x0,
+		{ { X86_REG_RSP, 0x118 } }, 1,
+		{ { 0x118, 8, CS_AC_READ } } },
+	{ "leave", { 0xc9 }, 1, 0x0,
+		{ { X86_REG_RSP, 0x80 }, { X86_REG_RBP, 0x100 } }, 1,
+		{ { 0x100, 8, CS_AC_READ } } },
+	{ "mov rax, qword [rip + 0x10]", { 0x48, 0x8b, 0x05, 0x10, 0x00, 0x00, 0x00 }, 7, 0x20,
+		{ { X86_REG_RIP, 0x20 } }, 1,
+		{ { 0x37, 8, CS_AC_READ } } },
+	{ "mov dword [rbx + rcx*4 + 8], eax", { 0x89, 0x44, 0x8b, 0x08 }, 4, 0x0,
+		{ { X86_REG_RBX, 0x100 }, { X86_REG_RCX, 2 } }, 1,
+		{ { 0x110, 4, CS_AC_WRITE } } },
+	{ "add qword [rbx], rax", { 0x48, 0x01, 0x03 }, 3, 0x0,
+		{ { X86_REG_RBX, 0x40 } }, 1,
+		{ { 0x40, 8, CS_AC_READ | CS_AC_WRITE } } },
+	{ "mov eax, dword [ebx]", { 0x67, 0x8b, 0x03 }, 3, 0x0,
+		{ { X86_REG_RBX, 0x100000010ULL } }, 1,
+		{ { 0x10, 4, CS_AC_READ } } },
+	{ "lea rax, [rbx + 8]", { 0x48, 0x8d, 0x43, 0x08 }, 4, 0x0,
+		{ { X86_REG_RBX, 0x100 } }, 0,
+		{ { 0 } } },
+};
+
+static int check_case(csh handle, const resolver_case *test)
+{
+	uint64_t registers[X86_REG_ENDING];
+	cpusim_memory_access accesses[MAX_ACCESSES];
+	cs_insn *insn;
+	int count, i, failed = 0;
+
+	memset(registers, 0, sizeof(registers));
+	for (i = 0; i < 3 && test->registers[i].reg != X86_REG_INVALID; i++) {
+		registers[test->registers[i].reg] = test->registers[i].value;
+	}
+
+	if (cs_disasm(handle, test->code, test->size, test->address, 1, &insn) != 1) {
+		printf("%s: not decoded\n", test->name);
+		return 1;
+	}
+	count = resolve_memory_operands(handle, insn, registers, accesses, MAX_ACCESSES);
+	cs_free(insn, 1);
+
+	if (count != test->count) {
+		printf("%s: %d accesses instead of %d\n", test->name, count, test->count);
+		return 1;
+	}
+	for (i = 0; i < count; i++) {
+		if (accesses[i].address != test->expected[i].address || accesses[i].size != test->expected[i].size
+				|| accesses[i].access != test->expected[i].access) {
+			printf("%s: access %d is 0x%llx/%u/%u instead of 0x%llx/%u/%u\n", test->name, i,
+					(unsigned long long)accesses[i].address, accesses[i].size, accesses[i].access,
+					(unsigned long long)test->expected[i].address, test->expected[i].size, test->expected[i].access);
+			failed = 1;
+		}
+	}
+	return failed;
+}
+
+int main(void)
+{
+	size_t i, failed = 0;
+	csh handle;
+
+	if (cs_open(CS_ARCH_X86, CS_MODE_64, &handle) != CS_ERR_OK) {
+		fprintf(stderr, "cs_open failed\n");
+		return 1;
+	}
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		failed += check_case(handle, &cases[i]);
+	}
+
+	cs_close(&handle);
+	printf("%zu cases, %zu failed\n", sizeof(cases) / sizeof(cases[0]), failed);
+	return failed ? 1 : 0;
+}
@@ -10,6 +10,8 @@
 #    version/commit d7a29d82b320e471203b69d43aaf03b5 of Emscripten sdk
 
 # Patched: added export for custom function '_print_insn_detail', change Emscripten export options, print last command, prepend "/* eslint-disable */\n" to library
+# Patched: added export for custom function '_resolve_memory_operands'
+# Patched: added the X86-only profile "--cpusim" (trimmed exports, constants and detail tables, see CPUSIM_* lists below)
 
 from __future__ import print_function
 import os
@@ -40,6 +42,7 @@ EXPORTED_FUNCTIONS = [
     '_cs_op_count',
     '_cs_op_index',
     '_print_insn_detail',
+    '_resolve_memory_operands',
 ]
 
 EXPORTED_CONSTANTS = [
@@ -53,6 +56,39 @@ EXPORTED_CONSTANTS = [
     'bindings/python/capstone/xcore_const.py',
 ]
 
+# Profile "--cpusim": only the functions, runtime methods and constants used by disassemblerService.ts
+CPUSIM_EXPORTED_FUNCTIONS = [
+    '_malloc',
+    '_free',
+    '_cs_open',
+    '_cs_disasm',
+    '_cs_free',
+    '_cs_close',
+    '_cs_option',
+    '_cs_errno',
+    '_cs_strerror',
+    '_cs_disasm_iter',
+    '_cs_malloc',
+    '_cs_insn_group',
+    '_print_insn_detail',
+    '_resolve_memory_operands',
+]
+
+CPUSIM_EXPORTED_METHODS = [
+    'ccall', 'getValue', 'setValue', 'UTF8ToString'
+]
+
+CPUSIM_EXPORTED_CONSTANTS = [
+    'bindings/python/capstone/x86_const.py',
+]
+
+CPUSIM_TARGETS = ['X86']
+
+# CAPSTONE_X86_REDUCE is not used: it removes the FPU and SSE instructions which students may still assemble
+# CPUSIM_COMPACT_DETAIL limits print_insn_detail to the fields read by instructionOperandsService.ts
+CPUSIM_CMAKE_OPTIONS = ' -DCAPSTONE_X86_ATT_DISABLE=ON'
+CPUSIM_C_FLAGS = ' -DCPUSIM_COMPACT_DETAIL'
+
 AVAILABLE_TARGETS = [
     'ARM', 'ARM64', 'MIPS', 'PPC', 'SPARC', 'SYSZ', 'XCORE', 'X86'
 ]
@@ -60,9 +96,9 @@ AVAILABLE_TARGETS = [
 # Directories
 CAPSTONE_DIR = os.path.abspath("capstone")
 
-def generateConstants():
+def generateConstants(cpusim):
     out = open('src/capstone-constants.js', 'w')
-    for path in EXPORTED_CONSTANTS:
+    for path in (CPUSIM_EXPORTED_CONSTANTS if cpusim else EXPORTED_CONSTANTS):
         path = os.path.join(CAPSTONE_DIR, path)
         with open(path, 'r') as f:
             code = f.read()
@@ -72,7 +108,7 @@ def generateConstants():
         out.write(code)
     out.close()
 
-def compileCapstone(targets):
+def compileCapstone(targets, cpusim):
     # Clean CMake cache
     try:
         os.remove('capstone/CMakeCache.txt')
@@ -83,7 +119,11 @@ def compileCapstone(targets):
     cmd = 'cmake'
     cmd += os.path.expandvars(' -DCMAKE_TOOLCHAIN_FILE=$EMSCRIPTEN/cmake/Modules/Platform/Emscripten.cmake')
     cmd += ' -DCMAKE_BUILD_TYPE=Release'
-    cmd += ' -DCMAKE_C_FLAGS=\"-Wno-warn-absolute-paths\"'
+    if cpusim:
+        cmd += ' -DCMAKE_C_FLAGS=\"-Wno-warn-absolute-paths' + CPUSIM_C_FLAGS + '\"'
+        cmd += CPUSIM_CMAKE_OPTIONS
+    else:
+        cmd += ' -DCMAKE_C_FLAGS=\"-Wno-warn-absolute-paths\"'
     cmd += ' -DCAPSTONE_BUILD_TESTS=OFF'
     cmd += ' -DCAPSTONE_BUILD_SHARED=OFF'
     if targets:
@@ -112,10 +152,14 @@ def compileCapstone(targets):
     os.chdir('..')
 
     # Compile static library to JavaScript
-    exports = EXPORTED_FUNCTIONS[:]
-    methods = [
-        'ccall', 'getValue', 'setValue', 'writeArrayToMemory', 'UTF8ToString'
-    ]
+    if cpusim:
+        exports = CPUSIM_EXPORTED_FUNCTIONS[:]
+        methods = CPUSIM_EXPORTED_METHODS[:]
+    else:
+        exports = EXPORTED_FUNCTIONS[:]
+        methods = [
+            'ccall', 'getValue', 'setValue', 'writeArrayToMemory', 'UTF8ToString'
+        ]
     cmd = os.path.expandvars('$EMSCRIPTEN/emcc')
     cmd += ' -Os --memory-init-file 0'
     cmd += ' capstone/libcapstone.a'
@@ -126,6 +170,10 @@ def compileCapstone(targets):
     cmd += ' -s WASM=0'
     cmd += ' -s EXPORT_ES6=1'
     cmd += ' -s USE_ES6_IMPORT_META=0'
+    if cpusim:
+        # Capstone never touches the file system, the runtime does not need to ship it
+        cmd += ' -s FILESYSTEM=0'
+        cmd += ' -s ASSERTIONS=0'
     if targets:
         cmd += ' -o src/libcapstone-%s.out.js' % '-'.join(targets).lower()
     else:
@@ -143,10 +191,14 @@ if __name__ == "__main__":
     if not os.listdir(CAPSTONE_DIR):
         os.system("git submodule update --init")
     # Compile Capstone
-    targets = sorted(sys.argv[1:])
+    cpusim = '--cpusim' in sys.argv[1:]
+    if cpusim:
+        targets = CPUSIM_TARGETS[:]
+    else:
+        targets = sorted(sys.argv[1:])
     if os.name in ['nt', 'posix']:
-        generateConstants()
-        compileCapstone(targets)
+        generateConstants(cpusim)
+        compileCapstone(targets, cpusim)
     else:
         print("Your operating system is not supported by this script:")
         print("Please, use Emscripten to compile Capstone manually to src/libcapstone.out.js")
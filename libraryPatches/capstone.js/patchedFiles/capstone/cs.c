@@ -70,7 +70,12 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 #include <capstone/capstone.h>
 
+#ifdef __EMSCRIPTEN__
 #include <emscripten.h>
+#else
+// native host build (see libraryPatches/capstone.js/nativeBenchmark)
+#define EMSCRIPTEN_KEEPALIVE
+#endif
 
 #include "utils.h"
 #include "MCRegisterInfo.h"
@@ -1612,6 +1617,19 @@ cs_err CAPSTONE_API cs_regs_access(csh ud, const cs_insn *insn,
 
 #define TEMP_STRING_SIZE 80
 
+// memory access of an instruction as written by resolve_memory_operands (16 bytes, read by disassemblerService.ts)
+typedef struct cpusim_memory_access {
+	uint64_t address;
+	uint32_t size;
+	uint32_t access;	// CS_AC_READ and/or CS_AC_WRITE
+} cpusim_memory_access;
+
+/*
+ * CPUSIM_COMPACT_DETAIL is set by the "cpusim" profile of build.py.
+ * print_insn_detail then only prints the fields read by instructionOperandsService.ts:
+ * Opcode, operands (without segment and AVX attributes), registers_read, registers_modified and EFLAGS_MASKS.
+ */
+
 static void print_string_hex_to_string(const char *comment, unsigned char *str, size_t len, char * dest)
 {
 	unsigned char *c;
@@ -1630,154 +1648,221 @@ static void print_string_hex_to_string(const char *comment, unsigned char *str,
     strcat(dest, temp);
 }
 
-static const char *get_eflag_name(uint64_t flag)
+/*
+ * Flag tables indexed by the bit position of the X86_EFLAGS_* and X86_FPU_FLAGS_* constants.
+ * The positions are computed at compile time, so printing a flag only needs a table lookup per set bit.
+ */
+// order corresponds to FlagAccessMode in InstructionOperands.ts
+enum cpusim_flag_access {
+	FLAG_ACCESS_MOD,
+	FLAG_ACCESS_UNDEF,
+	FLAG_ACCESS_RESET,
+	FLAG_ACCESS_TEST,
+	FLAG_ACCESS_SET,
+	FLAG_ACCESS_PRIOR,
+	FLAG_ACCESS_COUNT,
+};
+
+typedef struct cpusim_flag_entry {
+	const char *json;	// JSON object printed in the flag lists, NULL if the bit is unknown
+	uint8_t position;	// position of the flag in the EFLAGS register or the FPU status word
+	uint8_t access;		// enum cpusim_flag_access
+} cpusim_flag_entry;
+
+#define FLAG_ENTRY(constant, name, position, access) \
+	[__builtin_ctzll(constant)] = { "{ \"name\": \"" #name "\", \"access\": \"" #access "\" }", position, FLAG_ACCESS_##access }
+
+// positions of the flags in the EFLAGS register
+#define EFLAGS_POSITION_CF 0
+#define EFLAGS_POSITION_PF 2
+#define EFLAGS_POSITION_AF 4
+#define EFLAGS_POSITION_ZF 6
+#define EFLAGS_POSITION_SF 7
+#define EFLAGS_POSITION_TF 8
+#define EFLAGS_POSITION_IF 9
+#define EFLAGS_POSITION_DF 10
+#define EFLAGS_POSITION_OF 11
+#define EFLAGS_POSITION_NT 14
+#define EFLAGS_POSITION_RF 16
+
+// positions of the condition codes in the FPU status word
+#define FPU_POSITION_C0 8
+#define FPU_POSITION_C1 9
+#define FPU_POSITION_C2 10
+#define FPU_POSITION_C3 14
+
+static const cpusim_flag_entry eflag_table[64] = {
+	FLAG_ENTRY(X86_EFLAGS_UNDEFINED_OF, OF, EFLAGS_POSITION_OF, UNDEF),
+	FLAG_ENTRY(X86_EFLAGS_UNDEFINED_SF, SF, EFLAGS_POSITION_SF, UNDEF),
+	FLAG_ENTRY(X86_EFLAGS_UNDEFINED_ZF, ZF, EFLAGS_POSITION_ZF, UNDEF),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_AF, AF, EFLAGS_POSITION_AF, MOD),
+	FLAG_ENTRY(X86_EFLAGS_UNDEFINED_PF, PF, EFLAGS_POSITION_PF, UNDEF),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_CF, CF, EFLAGS_POSITION_CF, MOD),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_SF, SF, EFLAGS_POSITION_SF, MOD),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_ZF, ZF, EFLAGS_POSITION_ZF, MOD),
+	FLAG_ENTRY(X86_EFLAGS_UNDEFINED_AF, AF, EFLAGS_POSITION_AF, UNDEF),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_PF, PF, EFLAGS_POSITION_PF, MOD),
+	FLAG_ENTRY(X86_EFLAGS_UNDEFINED_CF, CF, EFLAGS_POSITION_CF, UNDEF),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_OF, OF, EFLAGS_POSITION_OF, MOD),
+	FLAG_ENTRY(X86_EFLAGS_RESET_OF, OF, EFLAGS_POSITION_OF, RESET),
+	FLAG_ENTRY(X86_EFLAGS_RESET_CF, CF, EFLAGS_POSITION_CF, RESET),
+	FLAG_ENTRY(X86_EFLAGS_RESET_DF, DF, EFLAGS_POSITION_DF, RESET),
+	FLAG_ENTRY(X86_EFLAGS_RESET_IF, IF, EFLAGS_POSITION_IF, RESET),
+	FLAG_ENTRY(X86_EFLAGS_TEST_OF, OF, EFLAGS_POSITION_OF, TEST),
+	FLAG_ENTRY(X86_EFLAGS_TEST_SF, SF, EFLAGS_POSITION_SF, TEST),
+	FLAG_ENTRY(X86_EFLAGS_TEST_ZF, ZF, EFLAGS_POSITION_ZF, TEST),
+	FLAG_ENTRY(X86_EFLAGS_TEST_PF, PF, EFLAGS_POSITION_PF, TEST),
+	FLAG_ENTRY(X86_EFLAGS_TEST_CF, CF, EFLAGS_POSITION_CF, TEST),
+	FLAG_ENTRY(X86_EFLAGS_RESET_SF, SF, EFLAGS_POSITION_SF, RESET),
+	FLAG_ENTRY(X86_EFLAGS_RESET_AF, AF, EFLAGS_POSITION_AF, RESET),
+	FLAG_ENTRY(X86_EFLAGS_RESET_TF, TF, EFLAGS_POSITION_TF, RESET),
+	FLAG_ENTRY(X86_EFLAGS_RESET_NT, NT, EFLAGS_POSITION_NT, RESET),
+	FLAG_ENTRY(X86_EFLAGS_PRIOR_OF, OF, EFLAGS_POSITION_OF, PRIOR),
+	FLAG_ENTRY(X86_EFLAGS_PRIOR_SF, SF, EFLAGS_POSITION_SF, PRIOR),
+	FLAG_ENTRY(X86_EFLAGS_PRIOR_ZF, ZF, EFLAGS_POSITION_ZF, PRIOR),
+	FLAG_ENTRY(X86_EFLAGS_PRIOR_AF, AF, EFLAGS_POSITION_AF, PRIOR),
+	FLAG_ENTRY(X86_EFLAGS_PRIOR_PF, PF, EFLAGS_POSITION_PF, PRIOR),
+	FLAG_ENTRY(X86_EFLAGS_PRIOR_CF, CF, EFLAGS_POSITION_CF, PRIOR),
+	FLAG_ENTRY(X86_EFLAGS_PRIOR_TF, TF, EFLAGS_POSITION_TF, PRIOR),
+	FLAG_ENTRY(X86_EFLAGS_PRIOR_IF, IF, EFLAGS_POSITION_IF, PRIOR),
+	FLAG_ENTRY(X86_EFLAGS_PRIOR_DF, DF, EFLAGS_POSITION_DF, PRIOR),
+	FLAG_ENTRY(X86_EFLAGS_TEST_NT, NT, EFLAGS_POSITION_NT, TEST),
+	FLAG_ENTRY(X86_EFLAGS_TEST_DF, DF, EFLAGS_POSITION_DF, TEST),
+	FLAG_ENTRY(X86_EFLAGS_RESET_PF, PF, EFLAGS_POSITION_PF, RESET),
+	FLAG_ENTRY(X86_EFLAGS_PRIOR_NT, NT, EFLAGS_POSITION_NT, PRIOR),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_TF, TF, EFLAGS_POSITION_TF, MOD),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_IF, IF, EFLAGS_POSITION_IF, MOD),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_DF, DF, EFLAGS_POSITION_DF, MOD),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_NT, NT, EFLAGS_POSITION_NT, MOD),
+	FLAG_ENTRY(X86_EFLAGS_MODIFY_RF, RF, EFLAGS_POSITION_RF, MOD),
+	FLAG_ENTRY(X86_EFLAGS_SET_CF, CF, EFLAGS_POSITION_CF, SET),
+	FLAG_ENTRY(X86_EFLAGS_SET_DF, DF, EFLAGS_POSITION_DF, SET),
+	FLAG_ENTRY(X86_EFLAGS_SET_IF, IF, EFLAGS_POSITION_IF, SET),
+};
+
+static const cpusim_flag_entry fpu_flag_table[64] = {
+	FLAG_ENTRY(X86_FPU_FLAGS_MODIFY_C0, C0, FPU_POSITION_C0, MOD),
+	FLAG_ENTRY(X86_FPU_FLAGS_MODIFY_C1, C1, FPU_POSITION_C1, MOD),
+	FLAG_ENTRY(X86_FPU_FLAGS_MODIFY_C2, C2, FPU_POSITION_C2, MOD),
+	FLAG_ENTRY(X86_FPU_FLAGS_MODIFY_C3, C3, FPU_POSITION_C3, MOD),
+	FLAG_ENTRY(X86_FPU_FLAGS_RESET_C0, C0, FPU_POSITION_C0, RESET),
+	FLAG_ENTRY(X86_FPU_FLAGS_RESET_C1, C1, FPU_POSITION_C1, RESET),
+	FLAG_ENTRY(X86_FPU_FLAGS_RESET_C2, C2, FPU_POSITION_C2, RESET),
+	FLAG_ENTRY(X86_FPU_FLAGS_RESET_C3, C3, FPU_POSITION_C3, RESET),
+	FLAG_ENTRY(X86_FPU_FLAGS_SET_C0, C0, FPU_POSITION_C0, SET),
+	FLAG_ENTRY(X86_FPU_FLAGS_SET_C1, C1, FPU_POSITION_C1, SET),
+	FLAG_ENTRY(X86_FPU_FLAGS_SET_C2, C2, FPU_POSITION_C2, SET),
+	FLAG_ENTRY(X86_FPU_FLAGS_SET_C3, C3, FPU_POSITION_C3, SET),
+	FLAG_ENTRY(X86_FPU_FLAGS_UNDEFINED_C0, C0, FPU_POSITION_C0, UNDEF),
+	FLAG_ENTRY(X86_FPU_FLAGS_UNDEFINED_C1, C1, FPU_POSITION_C1, UNDEF),
+	FLAG_ENTRY(X86_FPU_FLAGS_UNDEFINED_C2, C2, FPU_POSITION_C2, UNDEF),
+	FLAG_ENTRY(X86_FPU_FLAGS_UNDEFINED_C3, C3, FPU_POSITION_C3, UNDEF),
+	FLAG_ENTRY(X86_FPU_FLAGS_TEST_C0, C0, FPU_POSITION_C0, TEST),
+	FLAG_ENTRY(X86_FPU_FLAGS_TEST_C1, C1, FPU_POSITION_C1, TEST),
+	FLAG_ENTRY(X86_FPU_FLAGS_TEST_C2, C2, FPU_POSITION_C2, TEST),
+	FLAG_ENTRY(X86_FPU_FLAGS_TEST_C3, C3, FPU_POSITION_C3, TEST),
+};
+
+#undef FLAG_ENTRY
+
+static int count_trailing_zeros(uint64_t value)
+{
+	return __builtin_ctzll(value);
+}
+
+/*
+ * Prints the JSON objects of all set flags, iterating over the set bits only.
+ */
+static void print_flag_list(uint64_t flags, const cpusim_flag_entry *table, char *dest)
 {
-	switch(flag) {
-		default:
-			return NULL;
-		case X86_EFLAGS_UNDEFINED_OF:
-			return "{ \"name\": \"OF\", \"access\": \"UNDEF\" }";
-		case X86_EFLAGS_UNDEFINED_SF:
-			return "{ \"name\": \"SF\", \"access\": \"UNDEF\" }";
-		case X86_EFLAGS_UNDEFINED_ZF:
-			return "{ \"name\": \"ZF\", \"access\": \"UNDEF\" }";
-		case X86_EFLAGS_MODIFY_AF:
-			return "{ \"name\": \"AF\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_UNDEFINED_PF:
-			return "{ \"name\": \"PF\", \"access\": \"UNDEF\" }";
-		case X86_EFLAGS_MODIFY_CF:
-			return "{ \"name\": \"CF\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_MODIFY_SF:
-			return "{ \"name\": \"SF\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_MODIFY_ZF:
-			return "{ \"name\": \"ZF\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_UNDEFINED_AF:
-			return "{ \"name\": \"AF\", \"access\": \"UNDEF\" }";
-		case X86_EFLAGS_MODIFY_PF:
-			return "{ \"name\": \"PF\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_UNDEFINED_CF:
-			return "{ \"name\": \"CF\", \"access\": \"UNDEF\" }";
-		case X86_EFLAGS_MODIFY_OF:
-			return "{ \"name\": \"OF\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_RESET_OF:
-			return "{ \"name\": \"OF\", \"access\": \"RESET\" }";
-		case X86_EFLAGS_RESET_CF:
-			return "{ \"name\": \"CF\", \"access\": \"RESET\" }";
-		case X86_EFLAGS_RESET_DF:
-			return "{ \"name\": \"DF\", \"access\": \"RESET\" }";
-		case X86_EFLAGS_RESET_IF:
-			return "{ \"name\": \"IF\", \"access\": \"RESET\" }";
-		case X86_EFLAGS_TEST_OF:
-			return "{ \"name\": \"OF\", \"access\": \"TEST\" }";
-		case X86_EFLAGS_TEST_SF:
-			return "{ \"name\": \"SF\", \"access\": \"TEST\" }";
-		case X86_EFLAGS_TEST_ZF:
-			return "{ \"name\": \"ZF\", \"access\": \"TEST\" }";
-		case X86_EFLAGS_TEST_PF:
-			return "{ \"name\": \"PF\", \"access\": \"TEST\" }";
-		case X86_EFLAGS_TEST_CF:
-			return "{ \"name\": \"CF\", \"access\": \"TEST\" }";
-		case X86_EFLAGS_RESET_SF:
-			return "{ \"name\": \"SF\", \"access\": \"RESET\" }";
-		case X86_EFLAGS_RESET_AF:
-			return "{ \"name\": \"AF\", \"access\": \"RESET\" }";
-		case X86_EFLAGS_RESET_TF:
-			return "{ \"name\": \"TF\", \"access\": \"RESET\" }";
-		case X86_EFLAGS_RESET_NT:
-			return "{ \"name\": \"NT\", \"access\": \"RESET\" }";
-		case X86_EFLAGS_PRIOR_OF:
-			return "{ \"name\": \"OF\", \"access\": \"PRIOR\" }";
-		case X86_EFLAGS_PRIOR_SF:
-			return "{ \"name\": \"SF\", \"access\": \"PRIOR\" }";
-		case X86_EFLAGS_PRIOR_ZF:
-			return "{ \"name\": \"ZF\", \"access\": \"PRIOR\" }";
-		case X86_EFLAGS_PRIOR_AF:
-			return "{ \"name\": \"AF\", \"access\": \"PRIOR\" }";
-		case X86_EFLAGS_PRIOR_PF:
-			return "{ \"name\": \"PF\", \"access\": \"PRIOR\" }";
-		case X86_EFLAGS_PRIOR_CF:
-			return "{ \"name\": \"CF\", \"access\": \"PRIOR\" }";
-		case X86_EFLAGS_PRIOR_TF:
-			return "{ \"name\": \"TF\", \"access\": \"PRIOR\" }";
-		case X86_EFLAGS_PRIOR_IF:
-			return "{ \"name\": \"IF\", \"access\": \"PRIOR\" }";
-		case X86_EFLAGS_PRIOR_DF:
-			return "{ \"name\": \"DF\", \"access\": \"PRIOR\" }";
-		case X86_EFLAGS_TEST_NT:
-			return "{ \"name\": \"NT\", \"access\": \"TEST\" }";
-		case X86_EFLAGS_TEST_DF:
-			return "{ \"name\": \"DF\", \"access\": \"TEST\" }";
-		case X86_EFLAGS_RESET_PF:
-			return "{ \"name\": \"PF\", \"access\": \"RESET\" }";
-		case X86_EFLAGS_PRIOR_NT:
-			return "{ \"name\": \"NT\", \"access\": \"PRIOR\" }";
-		case X86_EFLAGS_MODIFY_TF:
-			return "{ \"name\": \"TF\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_MODIFY_IF:
-			return "{ \"name\": \"IF\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_MODIFY_DF:
-			return "{ \"name\": \"DF\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_MODIFY_NT:
-			return "{ \"name\": \"NT\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_MODIFY_RF:
-			return "{ \"name\": \"RF\", \"access\": \"MOD\" }";
-		case X86_EFLAGS_SET_CF:
-			return "{ \"name\": \"CF\", \"access\": \"SET\" }";
-		case X86_EFLAGS_SET_DF:
-			return "{ \"name\": \"DF\", \"access\": \"SET\" }";
-		case X86_EFLAGS_SET_IF:
-			return "{ \"name\": \"IF\", \"access\": \"SET\" }";
+	int first = 1;
+
+	while (flags) {
+		const cpusim_flag_entry *entry = &table[count_trailing_zeros(flags)];
+		flags &= flags - 1;
+		if (entry->json == NULL)
+			continue;
+		if (!first)
+			strcat(dest, ", ");
+		strcat(dest, entry->json);
+		first = 0;
 	}
 }
 
-static const char *get_fpu_flag_name(uint64_t flag)
+/*
+ * Collects one mask per access mode (enum cpusim_flag_access).
+ * Bit n of a mask is set if the flag at position n of the EFLAGS register has this access mode.
+ */
+static void get_eflags_access_masks(uint64_t eflags, uint32_t masks[FLAG_ACCESS_COUNT])
 {
-	switch (flag) {
-		default:
-			return NULL;
-		case X86_FPU_FLAGS_MODIFY_C0:
-			return "{ \"name\": \"C0\", \"access\": \"MOD\" }";
-		case X86_FPU_FLAGS_MODIFY_C1:
-			return "{ \"name\": \"C1\", \"access\": \"MOD\" }";
-		case X86_FPU_FLAGS_MODIFY_C2:
-			return "{ \"name\": \"C2\", \"access\": \"MOD\" }";
-		case X86_FPU_FLAGS_MODIFY_C3:
-			return "{ \"name\": \"C3\", \"access\": \"MOD\" }";
-		case X86_FPU_FLAGS_RESET_C0:
-			return "{ \"name\": \"C0\", \"access\": \"RESET\" }";
-		case X86_FPU_FLAGS_RESET_C1:
-			return "{ \"name\": \"C1\", \"access\": \"RESET\" }";
-		case X86_FPU_FLAGS_RESET_C2:
-			return "{ \"name\": \"C2\", \"access\": \"RESET\" }";
-		case X86_FPU_FLAGS_RESET_C3:
-			return "{ \"name\": \"C3\", \"access\": \"RESET\" }";
-		case X86_FPU_FLAGS_SET_C0:
-			return "{ \"name\": \"C0\", \"access\": \"SET\" }";
-		case X86_FPU_FLAGS_SET_C1:
-			return "{ \"name\": \"C1\", \"access\": \"SET\" }";
-		case X86_FPU_FLAGS_SET_C2:
-			return "{ \"name\": \"C2\", \"access\": \"SET\" }";
-		case X86_FPU_FLAGS_SET_C3:
-			return "{ \"name\": \"C3\", \"access\": \"SET\" }";
-		case X86_FPU_FLAGS_UNDEFINED_C0:
-			return "{ \"name\": \"C0\", \"access\": \"UNDEF\" }";
-		case X86_FPU_FLAGS_UNDEFINED_C1:
-			return "{ \"name\": \"C1\", \"access\": \"UNDEF\" }";
-		case X86_FPU_FLAGS_UNDEFINED_C2:
-			return "{ \"name\": \"C2\", \"access\": \"UNDEF\" }";
-		case X86_FPU_FLAGS_UNDEFINED_C3:
-			return "{ \"name\": \"C3\", \"access\": \"UNDEF\" }";
-		case X86_FPU_FLAGS_TEST_C0:
-			return "{ \"name\": \"C0\", \"access\": \"TEST\" }";
-		case X86_FPU_FLAGS_TEST_C1:
-			return "{ \"name\": \"C1\", \"access\": \"TEST\" }";
-		case X86_FPU_FLAGS_TEST_C2:
-			return "{ \"name\": \"C2\", \"access\": \"TEST\" }";
-		case X86_FPU_FLAGS_TEST_C3:
-			return "{ \"name\": \"C3\", \"access\": \"TEST\" }";
+	memset(masks, 0, sizeof(uint32_t) * FLAG_ACCESS_COUNT);
+
+	while (eflags) {
+		const cpusim_flag_entry *entry = &eflag_table[count_trailing_zeros(eflags)];
+		eflags &= eflags - 1;
+		if (entry->json != NULL)
+			masks[entry->access] |= (uint32_t)1 << entry->position;
 	}
 }
 
+// 64-bit register containing a general purpose register, X86_REG_INVALID for all other registers
+static const uint8_t parent_register_table[X86_REG_ENDING] = {
+	[X86_REG_RAX] = X86_REG_RAX, [X86_REG_EAX] = X86_REG_RAX, [X86_REG_AX] = X86_REG_RAX, [X86_REG_AL] = X86_REG_RAX, [X86_REG_AH] = X86_REG_RAX,
+	[X86_REG_RBX] = X86_REG_RBX, [X86_REG_EBX] = X86_REG_RBX, [X86_REG_BX] = X86_REG_RBX, [X86_REG_BL] = X86_REG_RBX, [X86_REG_BH] = X86_REG_RBX,
+	[X86_REG_RCX] = X86_REG_RCX, [X86_REG_ECX] = X86_REG_RCX, [X86_REG_CX] = X86_REG_RCX, [X86_REG_CL] = X86_REG_RCX, [X86_REG_CH] = X86_REG_RCX,
+	[X86_REG_RDX] = X86_REG_RDX, [X86_REG_EDX] = X86_REG_RDX, [X86_REG_DX] = X86_REG_RDX, [X86_REG_DL] = X86_REG_RDX, [X86_REG_DH] = X86_REG_RDX,
+	[X86_REG_RSI] = X86_REG_RSI, [X86_REG_ESI] = X86_REG_RSI, [X86_REG_SI] = X86_REG_RSI, [X86_REG_SIL] = X86_REG_RSI,
+	[X86_REG_RDI] = X86_REG_RDI, [X86_REG_EDI] = X86_REG_RDI, [X86_REG_DI] = X86_REG_RDI, [X86_REG_DIL] = X86_REG_RDI,
+	[X86_REG_RBP] = X86_REG_RBP, [X86_REG_EBP] = X86_REG_RBP, [X86_REG_BP] = X86_REG_RBP, [X86_REG_BPL] = X86_REG_RBP,
+	[X86_REG_RSP] = X86_REG_RSP, [X86_REG_ESP] = X86_REG_RSP, [X86_REG_SP] = X86_REG_RSP, [X86_REG_SPL] = X86_REG_RSP,
+	[X86_REG_R8] = X86_REG_R8, [X86_REG_R8D] = X86_REG_R8, [X86_REG_R8W] = X86_REG_R8, [X86_REG_R8B] = X86_REG_R8,
+	[X86_REG_R9] = X86_REG_R9, [X86_REG_R9D] = X86_REG_R9, [X86_REG_R9W] = X86_REG_R9, [X86_REG_R9B] = X86_REG_R9,
+	[X86_REG_R10] = X86_REG_R10, [X86_REG_R10D] = X86_REG_R10, [X86_REG_R10W] = X86_REG_R10, [X86_REG_R10B] = X86_REG_R10,
+	[X86_REG_R11] = X86_REG_R11, [X86_REG_R11D] = X86_REG_R11, [X86_REG_R11W] = X86_REG_R11, [X86_REG_R11B] = X86_REG_R11,
+	[X86_REG_R12] = X86_REG_R12, [X86_REG_R12D] = X86_REG_R12, [X86_REG_R12W] = X86_REG_R12, [X86_REG_R12B] = X86_REG_R12,
+	[X86_REG_R13] = X86_REG_R13, [X86_REG_R13D] = X86_REG_R13, [X86_REG_R13W] = X86_REG_R13, [X86_REG_R13B] = X86_REG_R13,
+	[X86_REG_R14] = X86_REG_R14, [X86_REG_R14D] = X86_REG_R14, [X86_REG_R14W] = X86_REG_R14, [X86_REG_R14B] = X86_REG_R14,
+	[X86_REG_R15] = X86_REG_R15, [X86_REG_R15D] = X86_REG_R15, [X86_REG_R15W] = X86_REG_R15, [X86_REG_R15B] = X86_REG_R15,
+	[X86_REG_RIP] = X86_REG_RIP, [X86_REG_EIP] = X86_REG_RIP, [X86_REG_IP] = X86_REG_RIP,
+};
+
+static x86_reg get_parent_register(x86_reg reg)
+{
+	if (reg <= X86_REG_INVALID || reg >= X86_REG_ENDING || parent_register_table[reg] == X86_REG_INVALID)
+		return reg;
+	return (x86_reg)parent_register_table[reg];
+}
+
+// number of 32-bit words of a register mask, bit n stands for the register with x86_reg n
+#define REGISTER_MASK_WORDS ((X86_REG_ENDING + 31) / 32)
+
+static void add_register_to_mask(uint32_t *mask, x86_reg reg)
+{
+	reg = get_parent_register(reg);
+	// flag accesses are printed in EFLAGS_MASKS
+	if (reg == X86_REG_EFLAGS)
+		return;
+	mask[reg >> 5] |= (uint32_t)1 << (reg & 31);
+}
+
+static void print_register_mask(const char *name, const uint32_t *mask, char *dest)
+{
+	char temp[TEMP_STRING_SIZE];
+	int word;
+
+	sprintf(temp, ", \"%s\": [ ", name);
+	strcat(dest, temp);
+	for (word = 0; word < REGISTER_MASK_WORDS; word++) {
+		if (word == 0) {
+			sprintf(temp, "%u", mask[word]);
+		} else {
+			sprintf(temp, ", %u", mask[word]);
+		}
+		strcat(dest, temp);
+	}
+	strcat(dest, " ]");
+}
+
 /*
  * PRECONDITION: outputString needs to be long enough to hold the data!
  * 				 There are no overflow checks!
@@ -1785,10 +1870,12 @@ static const char *get_fpu_flag_name(uint64_t flag)
 EMSCRIPTEN_KEEPALIVE
 int print_insn_detail(csh ud, cs_insn *ins, char * outputString)
 {
-	int count, i;
+	int count, i, group;
 	cs_x86 *x86;
 	cs_regs regs_read, regs_write;
 	uint8_t regs_read_count, regs_write_count;
+	uint32_t flagMasks[FLAG_ACCESS_COUNT];
+	uint32_t readMask[REGISTER_MASK_WORDS], writeMask[REGISTER_MASK_WORDS];
 
 	//char outputString[2000];
 	strcpy (outputString,"");
@@ -1803,6 +1890,9 @@ int print_insn_detail(csh ud, cs_insn *ins, char * outputString)
     sprintf(tempString, "{ ");
     strcat(outputString, tempString);
 
+#ifdef CPUSIM_COMPACT_DETAIL
+	print_string_hex_to_string("\"Opcode\": ", x86->opcode, 4, outputString);
+#else
 	print_string_hex_to_string("\"Prefix\": ", x86->prefix, 4, outputString);
 
 	print_string_hex_to_string(", \"Opcode\": ", x86->opcode, 4, outputString);
@@ -1915,9 +2005,14 @@ int print_insn_detail(csh ud, cs_insn *ins, char * outputString)
         sprintf(tempString, "] ");
         strcat(outputString, tempString);
 	}
+#endif
 
 	if (x86->op_count) {
+#ifdef CPUSIM_COMPACT_DETAIL
+		sprintf(tempString, ", \"operands\": [");
+#else
 		sprintf(tempString, ", \"op_count\": \"%u\", \"operands\": [", x86->op_count);
+#endif
 		strcat(outputString, tempString);
 	}
 
@@ -1942,10 +2037,12 @@ int print_insn_detail(csh ud, cs_insn *ins, char * outputString)
 			case X86_OP_MEM:
 				sprintf(tempString, "\"type\": \"MEM\"");
 				strcat(outputString, tempString);
+#ifndef CPUSIM_COMPACT_DETAIL
 				if (op->mem.segment != X86_REG_INVALID) {
 					sprintf(tempString, ", \"reg_segment\": \"%s\"", cs_reg_name(ud, op->mem.segment));
 					strcat(outputString, tempString);
 				}
+#endif
 				if (op->mem.base != X86_REG_INVALID) {
 					sprintf(tempString, ", \"reg_base\": \"%s\"", cs_reg_name(ud, op->mem.base));
 					strcat(outputString, tempString);
@@ -1967,6 +2064,7 @@ int print_insn_detail(csh ud, cs_insn *ins, char * outputString)
 				break;
 		}
 
+#ifndef CPUSIM_COMPACT_DETAIL
 		// AVX broadcast type
 		if (op->avx_bcast != X86_AVX_BCAST_INVALID) {
 			sprintf(tempString, ", \"avx_bcast\": \"%u\"", op->avx_bcast);
@@ -1978,6 +2076,7 @@ int print_insn_detail(csh ud, cs_insn *ins, char * outputString)
 			sprintf(tempString, ", \"avx_zero_opmask\": \"TRUE\"");
 			strcat(outputString, tempString);
 		}
+#endif
 
 		sprintf(tempString, ", \"size\": \"%u\"",op->size);
 		strcat(outputString, tempString);
@@ -2010,6 +2109,16 @@ int print_insn_detail(csh ud, cs_insn *ins, char * outputString)
 	if (!cs_regs_access(ud, ins,
 				regs_read, &regs_read_count,
 				regs_write, &regs_write_count)) {
+		// masks of the accessed registers, normalized to the 64-bit registers
+		memset(readMask, 0, sizeof(readMask));
+		memset(writeMask, 0, sizeof(writeMask));
+		for (i = 0; i < regs_read_count; i++)
+			add_register_to_mask(readMask, regs_read[i]);
+		for (i = 0; i < regs_write_count; i++)
+			add_register_to_mask(writeMask, regs_write[i]);
+		print_register_mask("registers_read_mask", readMask, outputString);
+		print_register_mask("registers_modified_mask", writeMask, outputString);
+
 		if (regs_read_count) {
 			sprintf(tempString, ", \"registers_read\": [");
 			strcat(outputString, tempString);
@@ -2042,38 +2151,26 @@ int print_insn_detail(csh ud, cs_insn *ins, char * outputString)
 	}
 
 	if (x86->eflags || x86->fpu_flags) {
-		for(i = 0; i < ins->detail->groups_count; i++) {
-			if (ins->detail->groups[i] == X86_GRP_FPU) {
-				sprintf(tempString, ", \"FPU_FLAGS\": [ ");
-				strcat(outputString, tempString);
-				for(i = 0; i <= 63; i++)
-					if (x86->fpu_flags & ((uint64_t)1 << i)) {
-				        if (i == 0) {
-				            sprintf(tempString, " %s", get_fpu_flag_name((uint64_t)1 << i));
-				        } else {
-						    sprintf(tempString, ", %s ", get_fpu_flag_name((uint64_t)1 << i));
-                        }
-						strcat(outputString, tempString);
-					}
-				sprintf(tempString, "] ");
-				strcat(outputString, tempString);
+		// eflags and fpu_flags share their memory, the FPU group decides which one is valid
+		for (group = 0; group < ins->detail->groups_count; group++) {
+			if (ins->detail->groups[group] == X86_GRP_FPU)
 				break;
-			}
 		}
 
-		if (i == ins->detail->groups_count) {
-			sprintf(tempString, ", \"EFLAGS\": [");
-			strcat(outputString, tempString);
-			for(i = 0; i <= 63; i++)
-				if (x86->eflags & ((uint64_t)1 << i)) {
-				    if (i == 0) {
-				        sprintf(tempString, " %s", get_eflag_name((uint64_t)1 << i));
-				    } else {
-					    sprintf(tempString, ", %s", get_eflag_name((uint64_t)1 << i));
-                    }
-					strcat(outputString, tempString);
-				}
-			sprintf(tempString, "] ");
+		if (group < ins->detail->groups_count) {
+			strcat(outputString, ", \"FPU_FLAGS\": [ ");
+			print_flag_list(x86->fpu_flags, fpu_flag_table, outputString);
+			strcat(outputString, "] ");
+		} else {
+			get_eflags_access_masks(x86->eflags, flagMasks);
+#ifndef CPUSIM_COMPACT_DETAIL
+			strcat(outputString, ", \"EFLAGS\": [ ");
+			print_flag_list(x86->eflags, eflag_table, outputString);
+			strcat(outputString, "] ");
+#endif
+			sprintf(tempString, ", \"EFLAGS_MASKS\": [ %u, %u, %u, %u, %u, %u ]",
+					flagMasks[FLAG_ACCESS_MOD], flagMasks[FLAG_ACCESS_UNDEF], flagMasks[FLAG_ACCESS_RESET],
+					flagMasks[FLAG_ACCESS_TEST], flagMasks[FLAG_ACCESS_SET], flagMasks[FLAG_ACCESS_PRIOR]);
 			strcat(outputString, tempString);
 		}
 	}
@@ -2084,3 +2181,102 @@ int print_insn_detail(csh ud, cs_insn *ins, char * outputString)
 	return 0;
 }
 
+/**
+ * Code below is written for CPUSim.
+ * Resolution of the memory addresses accessed by an instruction, without executing it.
+ */
+
+static uint64_t read_register(const uint64_t *registers, x86_reg reg)
+{
+	switch (reg) {
+		case X86_REG_AH: case X86_REG_BH: case X86_REG_CH: case X86_REG_DH:
+			return (registers[get_parent_register(reg)] >> 8) & 0xff;
+		default:
+			return registers[get_parent_register(reg)];
+	}
+}
+
+static uint64_t mask_address(uint64_t address, uint8_t addr_size)
+{
+	if (addr_size >= 8)
+		return address;
+	return address & (((uint64_t)1 << (addr_size * 8)) - 1);
+}
+
+static int add_memory_access(cpusim_memory_access *accesses, int count, int maxAccesses,
+		uint64_t address, uint32_t size, uint32_t access)
+{
+	if (count < maxAccesses) {
+		accesses[count].address = address;
+		accesses[count].size = size;
+		accesses[count].access = access;
+	}
+	return count + 1;
+}
+
+/*
+ * Writes the memory accesses of an instruction to accesses and returns their number (-1 without instruction details).
+ * registers is a snapshot indexed by x86_reg (which matches RegisterID of Unicorn), only the 64-bit registers are read.
+ * Explicit memory operands are resolved as base + index * scale + disp, RIP-relative operands use the address of the
+ * next instruction. Implicit stack accesses of push, pop, call, ret, leave, pushf and popf are resolved from RSP/RBP.
+ * Segment bases (fs, gs) are not applied. Memory operands without access (lea) are skipped.
+ * If more than maxAccesses accesses exist, the return value is larger than maxAccesses and only maxAccesses are written.
+ */
+EMSCRIPTEN_KEEPALIVE
+int resolve_memory_operands(csh ud, cs_insn *ins, const uint64_t *registers, cpusim_memory_access *accesses, int maxAccesses)
+{
+	cs_x86 *x86;
+	uint64_t address, stackPointer;
+	uint32_t size;
+	int count = 0, i;
+
+	if (ins->detail == NULL)
+		return -1;
+
+	x86 = &(ins->detail->x86);
+
+	for (i = 0; i < x86->op_count; i++) {
+		cs_x86_op *op = &(x86->operands[i]);
+		if (op->type != X86_OP_MEM || op->access == 0)
+			continue;
+		address = (uint64_t)op->mem.disp;
+		if (op->mem.base == X86_REG_RIP || op->mem.base == X86_REG_EIP)
+			address += ins->address + ins->size;
+		else if (op->mem.base != X86_REG_INVALID)
+			address += read_register(registers, op->mem.base);
+		if (op->mem.index != X86_REG_INVALID)
+			address += read_register(registers, op->mem.index) * (uint64_t)op->mem.scale;
+		count = add_memory_access(accesses, count, maxAccesses,
+				mask_address(address, x86->addr_size), op->size, op->access);
+	}
+
+	stackPointer = registers[X86_REG_RSP];
+	switch (ins->id) {
+		default:
+			break;
+		case X86_INS_PUSH:
+			size = x86->op_count ? x86->operands[0].size : 8;
+			count = add_memory_access(accesses, count, maxAccesses, stackPointer - size, size, CS_AC_WRITE);
+			break;
+		case X86_INS_PUSHFQ:
+			count = add_memory_access(accesses, count, maxAccesses, stackPointer - 8, 8, CS_AC_WRITE);
+			break;
+		case X86_INS_CALL:
+			count = add_memory_access(accesses, count, maxAccesses, stackPointer - 8, 8, CS_AC_WRITE);
+			break;
+		case X86_INS_POP:
+			size = x86->op_count ? x86->operands[0].size : 8;
+			count = add_memory_access(accesses, count, maxAccesses, stackPointer, size, CS_AC_READ);
+			break;
+		case X86_INS_POPFQ:
+		case X86_INS_RET:
+			count = add_memory_access(accesses, count, maxAccesses, stackPointer, 8, CS_AC_READ);
+			break;
+		case X86_INS_LEAVE:
+			// mov rsp, rbp; pop rbp
+			count = add_memory_access(accesses, count, maxAccesses, registers[X86_REG_RBP], 8, CS_AC_READ);
+			break;
+	}
+
+	return count;
+}
@@ -0,0 +1,172 @@
+/* This file is part of CPUSim
+ *
+ * Native benchmark for the memory diff and search primitives of CPUSim.
+ * The results are checked against naive implementations first, then the throughput is measured for:
+ *   memcpy:  copying the memory, as uc_mem_read does before every scan
+ *   diff:    cpusim_mem_diff of the memory and a snapshot with a few changed bytes
+ *   search:  cpusim_mem_search of a 32-bit value
+ *
+ * Usage: memscan_benchmark [iterations] [memory size in bytes]
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cpusim_memscan.h"
+
+#define DEFAULT_ITERATIONS 50
+#define DEFAULT_MEMORY_SIZE (16 * 1024 * 1024)
+#define MAX_RESULTS 4096
+#define BASE_ADDRESS 0x1000
+
+static uint32_t expected[2 * MAX_RESULTS];
+static uint32_t actual[2 * MAX_RESULTS];
+
+static double now_seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static size_t naive_diff(const uint8_t *live, const uint8_t *snapshot, size_t length, uint32_t *ranges)
+{
+	size_t count = 0;
+	size_t i = 0;
+	while (i < length) {
+		if (live[i] == snapshot[i]) {
+			i++;
+			continue;
+		}
+		size_t start = i;
+		while (i < length && live[i] != snapshot[i])
+			i++;
+		if (count < MAX_RESULTS) {
+			ranges[2 * count] = BASE_ADDRESS + (uint32_t)start;
+			ranges[2 * count + 1] = BASE_ADDRESS + (uint32_t)i;
+		}
+		count++;
+	}
+	return count;
+}
+
+static size_t naive_search(const uint8_t *memory, size_t length, const uint8_t *pattern, size_t pattern_length,
+		uint32_t alignment, uint32_t *matches)
+{
+	size_t count = 0;
+	for (size_t i = 0; i + pattern_length <= length; i++) {
+		if ((BASE_ADDRESS + i) % alignment == 0 && memcmp(memory + i, pattern, pattern_length) == 0) {
+			if (count < MAX_RESULTS)
+				matches[count] = BASE_ADDRESS + (uint32_t)i;
+			count++;
+		}
+	}
+	return count;
+}
+
+static int check(const char *name, size_t expected_count, size_t actual_count, size_t values_per_result)
+{
+	size_t written = (expected_count < MAX_RESULTS ? expected_count : MAX_RESULTS) * values_per_result;
+	if (expected_count != actual_count || memcmp(expected, actual, written * sizeof(uint32_t)) != 0) {
+		fprintf(stderr, "%s: mismatch, expected %zu results, got %zu\n", name, expected_count, actual_count);
+		return 1;
+	}
+	return 0;
+}
+
+// random buffers with runs of equal bytes, so the word and byte paths are both taken
+static int check_against_naive(void)
+{
+	int failures = 0;
+	srand(42);
+	for (int round = 0; round < 2000; round++) {
+		size_t length = (size_t)(rand() % 300);
+		uint8_t *live = malloc(length + 1);
+		uint8_t *snapshot = malloc(length + 1);
+		for (size_t i = 0; i < length; i++) {
+			live[i] = (uint8_t)(rand() % 4 == 0 ? rand() : 0);
+			snapshot[i] = rand() % 3 == 0 ? (uint8_t)rand() : live[i];
+		}
+		size_t count = naive_diff(live, snapshot, length, expected);
+		failures += check("diff", count, cpusim_mem_diff(live, snapshot, length, BASE_ADDRESS, actual, MAX_RESULTS), 2);
+
+		uint8_t pattern[8];
+		size_t pattern_length = (size_t)(1 << (rand() % 4));
+		for (size_t i = 0; i < pattern_length; i++)
+			pattern[i] = (uint8_t)(rand() % 2 == 0 ? 0 : rand() % 4);
+		uint32_t alignment = rand() % 2 == 0 ? 1 : (uint32_t)pattern_length;
+		count = naive_search(live, length, pattern, pattern_length, alignment, expected);
+		failures += check("search", count,
+			cpusim_mem_search(live, length, BASE_ADDRESS, pattern, pattern_length, alignment, actual, MAX_RESULTS), 1);
+		free(live);
+		free(snapshot);
+	}
+	return failures;
+}
+
+static void report(const char *name, double seconds, size_t bytes, int iterations)
+{
+	printf("%-8s %8.2f GB/s\n", name, (double)bytes * iterations / seconds / 1e9);
+}
+
+int main(int argc, char **argv)
+{
+	int iterations = argc > 1 ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+	size_t size = argc > 2 ? (size_t)strtoul(argv[2], NULL, 0) : DEFAULT_MEMORY_SIZE;
+
+	int failures = check_against_naive();
+	if (failures > 0) {
+		fprintf(stderr, "%d checks failed\n", failures);
+		return 1;
+	}
+	printf("checked against naive implementations\n");
+
+	uint8_t *memory = calloc(size, 1);
+	uint8_t *snapshot = calloc(size, 1);
+	uint8_t *copy = malloc(size);
+	for (size_t i = 0; i < size; i += 4096)
+		memory[i] = (uint8_t)i;
+	memcpy(snapshot, memory, size);
+	for (size_t i = 0; i < size; i += size / 64)
+		snapshot[i + 7] ^= 0xFF;
+	const uint8_t value[4] = { 0xEF, 0xBE, 0xAD, 0xDE };
+	memcpy(memory + size / 2, value, sizeof(value));
+
+	size_t results = 0;
+	double start = now_seconds();
+	for (int i = 0; i < iterations; i++) {
+		memcpy(copy, memory, size);
+		results += copy[i % size];
+	}
+	report("memcpy", now_seconds() - start, size, iterations);
+
+	start = now_seconds();
+	for (int i = 0; i < iterations; i++)
+		results += cpusim_mem_diff(memory, snapshot, size, BASE_ADDRESS, actual, MAX_RESULTS);
+	report("diff", now_seconds() - start, size, iterations);
+
+	start = now_seconds();
+	for (int i = 0; i < iterations; i++)
+		results += cpusim_mem_search(memory, size, BASE_ADDRESS, value, sizeof(value), 4, actual, MAX_RESULTS);
+	report("search", now_seconds() - start, size, iterations);
+
+	printf("(%zu results)\n", results);
+	free(memory);
+	free(snapshot);
+	free(copy);
+	return 0;
+}
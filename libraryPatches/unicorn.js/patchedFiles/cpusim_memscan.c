@@ -0,0 +1,145 @@
+/* This file is part of CPUSim
+ *
+ * Memory diff and search primitives, linked into the Unicorn.js bundle and called by emulatorService.ts.
+ * Both work on buffers in the Emscripten heap, the guest memory is copied there with uc_mem_read.
+ *
+ * Built with -msimd128 (WASM=1) 16 bytes are compared at once with wasm SIMD,
+ * otherwise (WASM=0 as in the CPUSim build) 8 bytes at once with 64-bit words.
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+#include "cpusim_memscan.h"
+
+#define ONES_64 0x0101010101010101ULL
+#define HIGH_BITS_64 0x8080808080808080ULL
+
+// true if one of the bytes of the word is zero
+static int has_zero_byte(uint64_t word)
+{
+	return ((word - ONES_64) & ~word & HIGH_BITS_64) != 0;
+}
+
+static uint64_t load_word(const uint8_t *bytes)
+{
+	uint64_t word;
+	memcpy(&word, bytes, sizeof(word));
+	return word;
+}
+
+// number of leading bytes which are equal in both buffers
+static size_t equal_prefix(const uint8_t *a, const uint8_t *b, size_t length)
+{
+	size_t i = 0;
+#ifdef __wasm_simd128__
+	while (i + 16 <= length && wasm_i8x16_all_true(wasm_i8x16_eq(wasm_v128_load(a + i), wasm_v128_load(b + i))))
+		i += 16;
+#else
+	while (i + 8 <= length && load_word(a + i) == load_word(b + i))
+		i += 8;
+#endif
+	while (i < length && a[i] == b[i])
+		i++;
+	return i;
+}
+
+// number of leading bytes which differ in both buffers
+static size_t different_prefix(const uint8_t *a, const uint8_t *b, size_t length)
+{
+	size_t i = 0;
+#ifdef __wasm_simd128__
+	while (i + 16 <= length && wasm_i8x16_all_true(wasm_v128_not(wasm_i8x16_eq(wasm_v128_load(a + i), wasm_v128_load(b + i)))))
+		i += 16;
+#else
+	while (i + 8 <= length && !has_zero_byte(load_word(a + i) ^ load_word(b + i)))
+		i += 8;
+#endif
+	while (i < length && a[i] != b[i])
+		i++;
+	return i;
+}
+
+// first occurrence of the byte, like memchr
+static const uint8_t *find_byte(const uint8_t *bytes, uint8_t byte, size_t length)
+{
+	size_t i = 0;
+#ifdef __wasm_simd128__
+	const v128_t splat = wasm_i8x16_splat((int8_t)byte);
+	while (i + 16 <= length && wasm_i8x16_all_true(wasm_v128_not(wasm_i8x16_eq(wasm_v128_load(bytes + i), splat))))
+		i += 16;
+#else
+	const uint64_t splat = ONES_64 * byte;
+	while (i + 8 <= length && !has_zero_byte(load_word(bytes + i) ^ splat))
+		i += 8;
+#endif
+	while (i < length) {
+		if (bytes[i] == byte)
+			return bytes + i;
+		i++;
+	}
+	return NULL;
+}
+
+size_t cpusim_mem_diff(const uint8_t *live, const uint8_t *snapshot, size_t length, uint32_t address,
+		uint32_t *ranges, size_t max_ranges)
+{
+	size_t count = 0;
+	size_t offset = equal_prefix(live, snapshot, length);
+
+	while (offset < length) {
+		size_t end = offset + different_prefix(live + offset, snapshot + offset, length - offset);
+		if (count < max_ranges) {
+			ranges[2 * count] = address + (uint32_t)offset;
+			ranges[2 * count + 1] = address + (uint32_t)end;
+		}
+		count++;
+		offset = end + equal_prefix(live + end, snapshot + end, length - end);
+	}
+	return count;
+}
+
+size_t cpusim_mem_search(const uint8_t *memory, size_t length, uint32_t address,
+		const uint8_t *pattern, size_t pattern_length, uint32_t alignment,
+		uint32_t *matches, size_t max_matches)
+{
+	size_t count = 0;
+	size_t offset = 0;
+
+	if (pattern_length == 0 || pattern_length > length)
+		return 0;
+	if (alignment == 0)
+		alignment = 1;
+
+	// candidates are found by the first byte of the pattern and compared afterwards
+	while (offset + pattern_length <= length) {
+		const uint8_t *candidate = find_byte(memory + offset, pattern[0], length - pattern_length + 1 - offset);
+		if (candidate == NULL)
+			break;
+		offset = (size_t)(candidate - memory);
+		if ((address + offset) % alignment == 0 && memcmp(candidate + 1, pattern + 1, pattern_length - 1) == 0) {
+			if (count < max_matches)
+				matches[count] = address + (uint32_t)offset;
+			count++;
+		}
+		offset++;
+	}
+	return count;
+}
@@ -0,0 +1,39 @@
+/* This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CPUSIM_MEMSCAN_H
+#define CPUSIM_MEMSCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Compares a copy of guest memory starting at address with a snapshot of the same length.
+ * Writes the changed ranges as pairs of start and end address (exclusive) and returns the number of changed ranges.
+ * Only the first max_ranges ranges are written.
+ */
+size_t cpusim_mem_diff(const uint8_t *live, const uint8_t *snapshot, size_t length, uint32_t address,
+		uint32_t *ranges, size_t max_ranges);
+
+/*
+ * Searches a copy of guest memory starting at address for the pattern, at addresses which are a multiple of alignment.
+ * Writes the addresses of the matches and returns the number of matches. Only the first max_matches matches are written.
+ * Matches may overlap.
+ */
+size_t cpusim_mem_search(const uint8_t *memory, size_t length, uint32_t address,
+		const uint8_t *pattern, size_t pattern_length, uint32_t alignment,
+		uint32_t *matches, size_t max_matches);
+
+#endif
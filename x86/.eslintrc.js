@@ -27,6 +27,7 @@ module.exports = {
       files: [
         '**/__tests__/*.{j,t}s?(x)',
         '**/tests/unit/**/*.spec.{j,t}s?(x)',
+        '**/tests/bench/**/*.bench.{j,t}s?(x)',
       ],
       env: {
         mocha: true,
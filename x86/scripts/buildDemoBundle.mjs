@@ -0,0 +1,217 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Assembles the demo programs of src/services/editorService/demoPrograms.ts with NASM and decodes them with Capstone
+ * and ndisasm, then writes src/services/editorService/demoProgramBundle.ts.
+ * Loading a demo in the editor then needs neither NASM nor a Capstone decode at runtime.
+ *
+ * Run with `npm run build:demos` whenever the demo programs or one of the libraries in lib/ change.
+ */
+
+/* eslint-disable no-await-in-loop, no-restricted-syntax */
+import { createRequire } from 'module';
+import { readFileSync, writeFileSync } from 'fs';
+import { dirname, resolve } from 'path';
+import { fileURLToPath } from 'url';
+
+const scriptDirectory = dirname(fileURLToPath(import.meta.url));
+const projectDirectory = resolve(scriptDirectory, '..');
+const libDirectory = resolve(projectDirectory, 'lib');
+const demoProgramsFile = resolve(projectDirectory, 'src/services/editorService/demoPrograms.ts');
+const bundleFile = resolve(projectDirectory, 'src/services/editorService/demoProgramBundle.ts');
+const headerSource = readFileSync(resolve(projectDirectory, 'src/services/interfaces/codeEditor/PrebuiltProgram.ts'), 'utf8');
+const licenseHeader = headerSource.slice(0, headerSource.indexOf('\n */\n') + 4);
+
+// must match defaultMemoryMap.codeAddress, decodes depend on the address of the instruction
+const codeAddress = 0x0000;
+// mapLinesToMemory reads the bytes up to the end of the memory region, the code is followed by zeros there
+const trailingZeros = 16;
+
+// The emscripten modules in lib/ are ES modules written for the browser and webpack, in node they expect CommonJS globals.
+const require = createRequire(import.meta.url);
+globalThis.require = require;
+globalThis.__dirname = libDirectory;
+
+async function loadModule(name) {
+  return (await import(resolve(libDirectory, name))).default;
+}
+
+function toHex(bytes) {
+  return Array.from(bytes, (byte) => byte.toString(16).toUpperCase().padStart(2, '0')).join('');
+}
+
+async function loadDemoPrograms() {
+  const typescript = require('typescript');
+  const { outputText } = typescript.transpileModule(readFileSync(demoProgramsFile, 'utf8'), {
+    compilerOptions: { module: typescript.ModuleKind.ESNext, target: typescript.ScriptTarget.ES2020 },
+  });
+  const demoModule = await import(`data:text/javascript;base64,${Buffer.from(outputText).toString('base64')}`);
+  return demoModule.default;
+}
+
+async function assemble(Nasm, source) {
+  let error = '';
+  const nasmInstance = await Nasm({
+    print(text) { error = text; },
+    printErr(text) { error = text; },
+    noInitialRun: true,
+    noExitRuntime: true,
+  });
+  nasmInstance.FS.writeFile('/assembly.asm', source);
+  nasmInstance.FS.writeFile('/output.out', Uint8Array.from([]));
+  nasmInstance.callMain(['-fbin', '/assembly.asm', '-o', '/output.out']);
+  if (error !== '') {
+    throw new Error(error);
+  }
+  return nasmInstance.FS.readFile('/output.out');
+}
+
+// Same output as getFirstInstruction of ndisasm.ts
+async function disassembleWithNdisasm(Ndisasm, bytes) {
+  let output = '';
+  const ndisasmInstance = await Ndisasm({
+    print(text) { output += `${text}\n`; },
+    printErr(text) { throw new Error(text); },
+    noInitialRun: true,
+    noExitRuntime: true,
+  });
+  ndisasmInstance.FS.writeFile('/binary.o', bytes);
+  await ndisasmInstance.callMain(['/binary.o', '-b64']);
+  const line = output.split('\n')[0];
+  const offset = line.split(' ', 1)[0];
+  const dataAndInstruction = line.substr(offset.length).trimStart();
+  const data = dataAndInstruction.split(' ', 1)[0];
+  return dataAndInstruction.substr(data.length).trimStart().replace(',', ', ');
+}
+
+// Reads the same fields of cs_insn as Disassembler.buildInstruction and Disassembler.readInstructionDetail
+function createCapstone(MCapstone) {
+  const handlePointer = MCapstone._malloc(4);
+  if (MCapstone.ccall('cs_open', 'number', ['number', 'number', 'pointer'], [3, 1 << 3, handlePointer]) !== 0) {
+    throw new Error('cs_open failed');
+  }
+  const handle = MCapstone.getValue(handlePointer, 'i32');
+  MCapstone.ccall('cs_option', 'number', ['pointer', 'number', 'number'], [handle, 2, 3]);
+
+  return (bytes, address) => {
+    const bufferPointer = MCapstone._malloc(bytes.length);
+    MCapstone.HEAPU8.set(bytes, bufferPointer);
+    const instructionPointerPointer = MCapstone._malloc(4);
+    const count = MCapstone.ccall(
+      'cs_disasm',
+      'number',
+      ['number', 'pointer', 'number', 'number', 'number', 'pointer'],
+      [handle, bufferPointer, bytes.length, address, 0, 1, instructionPointerPointer],
+    );
+    MCapstone._free(bufferPointer);
+    if (count === 0) {
+      MCapstone._free(instructionPointerPointer);
+      return undefined;
+    }
+    const pointer = MCapstone.getValue(instructionPointerPointer, 'i32');
+    MCapstone._free(instructionPointerPointer);
+
+    const size = MCapstone.getValue(pointer + 16, 'i16');
+    const capstoneAssembly = `${MCapstone.UTF8ToString(pointer + 34)} ${MCapstone.UTF8ToString(pointer + 66)}`;
+    const detailPointer = MCapstone._malloc(2000);
+    MCapstone.ccall('print_insn_detail', 'number', ['number', 'number', 'number'], [handle, pointer, detailPointer]);
+    const detail = MCapstone.UTF8ToString(detailPointer).split('[,').join('[');
+    MCapstone._free(detailPointer);
+    MCapstone.ccall('cs_free', 'void', ['pointer', 'number'], [pointer, count]);
+    return { size, capstoneAssembly, detail };
+  };
+}
+
+async function decodeProgram(decode, Ndisasm, machineCode) {
+  const memory = new Uint8Array(machineCode.length + trailingZeros);
+  memory.set(machineCode);
+  const instructions = [];
+  let offset = 0;
+  while (offset < machineCode.length) {
+    const decoded = decode(memory.subarray(offset), codeAddress + offset);
+    if (decoded === undefined) {
+      break;
+    }
+    const bytes = memory.slice(offset, offset + decoded.size);
+    instructions.push({
+      address: codeAddress + offset,
+      bytes: toHex(bytes),
+      capstoneAssembly: decoded.capstoneAssembly,
+      nasmAssembly: await disassembleWithNdisasm(Ndisasm, bytes),
+      detail: decoded.detail,
+    });
+    offset += decoded.size;
+  }
+  return instructions;
+}
+
+function toLiteral(value, indentation) {
+  if (typeof value === 'string') {
+    return `'${value.replace(/\\/g, '\\\\').replace(/'/g, '\\\'').replace(/\n/g, '\\n')
+      .replace(/\t/g, '\\t')}'`;
+  }
+  if (typeof value === 'number') {
+    return `0x${value.toString(16).toUpperCase()}`;
+  }
+  const innerIndentation = `${indentation}  `;
+  if (Array.isArray(value)) {
+    return `[\n${value.map((item) => `${innerIndentation}${toLiteral(item, innerIndentation)},\n`).join('')}${indentation}]`;
+  }
+  const properties = Object.entries(value).map(([key, item]) => `${innerIndentation}${key}: ${toLiteral(item, innerIndentation)},\n`);
+  return `{\n${properties.join('')}${indentation}}`;
+}
+
+async function buildDemoBundle() {
+  const [Nasm, Ndisasm, Capstone] = await Promise.all([loadModule('nasm.js'), loadModule('ndisasm.js'), loadModule('libcapstone-x86.out.js')]);
+  const decode = createCapstone(await Capstone());
+  const demoPrograms = await loadDemoPrograms();
+
+  const bundle = [];
+  for (const { label, program } of demoPrograms) {
+    const machineCode = await assemble(Nasm, program);
+    bundle.push({
+      label,
+      source: program,
+      codeAddress,
+      machineCode: toHex(machineCode),
+      instructions: await decodeProgram(decode, Ndisasm, machineCode),
+    });
+  }
+
+  const content = `${licenseHeader}
+
+// This file is generated by scripts/buildDemoBundle.mjs (npm run build:demos), do not edit it by hand.
+
+import PrebuiltProgram from '@/services/interfaces/codeEditor/PrebuiltProgram';
+
+const demoProgramBundle: Array<PrebuiltProgram> = ${toLiteral(bundle, '')};
+export default demoProgramBundle;
+`;
+  writeFileSync(bundleFile, content);
+  console.log(`Wrote ${bundle.length} demo programs to ${bundleFile}`);
+}
+
+buildDemoBundle().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
@@ -0,0 +1,41 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Webpack loader for the Emscripten libraries in lib/, used by production builds.
+ * It replaces a library by a module exporting its gzip compressed source, which engineModuleService.ts decompresses
+ * and evaluates when the engine is first needed. The build stays a single bundle that works offline,
+ * but the browser parses a compact string at startup instead of several MB of asm.js.
+ * The source is evaluated with new Function, so a Content-Security-Policy of the page needs 'unsafe-eval'.
+ */
+
+const zlib = require('zlib');
+
+const moduleExport = /export\s+default\s+Module\s*;?\s*$/;
+
+module.exports = function compressedEngineLoader(source) {
+  if (!moduleExport.test(source)) {
+    throw new Error(`${this.resourcePath} does not end with "export default Module;"`);
+  }
+  const compressedSource = zlib.gzipSync(Buffer.from(source.replace(moduleExport, '')), { level: 9 }).toString('base64');
+  return `export default { compressedSource: ${JSON.stringify(compressedSource)} };\n`;
+};
@@ -24,6 +24,7 @@ import { createApp } from 'vue';
 import { Quasar, Notify } from 'quasar';
 import App from './App.vue';
 import router from './router';
+import { enableTracingFromLocation } from './services/helper/traceService';
 
 import './styles/quasar.scss';
 import './styles/bootstrap-icons.css';
@@ -34,6 +35,9 @@ const quasarConfig = {
   plugins: { Notify },
 };
 
+// phases of the simulator are traced if the URL carries the query flag "trace"
+enableTracingFromLocation();
+
 const app = createApp(App);
 app.use(router);
 app.use(Quasar, quasarConfig);
@@ -30,6 +30,10 @@ export const routeCodeEditor = 'CodeEditor';
 
 export const routeSimulator = 'SimulatorWithMachineCodeAndAssembly';
 
+export const routeSharedEditor = 'CodeEditorWithSharedProgram';
+
+export const routeSharedSimulator = 'SimulatorWithSharedProgram';
+
 export const routes: Array<RouteRecordRaw> = [
   {
     path: '/', redirect: '/editor',
@@ -47,6 +51,14 @@ export const routes: Array<RouteRecordRaw> = [
       ...route.params,
     }),
   },
+  {
+    path: '/edit/:sharedProgramFromURL',
+    name: routeSharedEditor,
+    component: Editor,
+    props: (route) => ({
+      ...route.params,
+    }),
+  },
   {
     path: '/simulator', redirect: '/editor',
   },
@@ -64,6 +76,14 @@ export const routes: Array<RouteRecordRaw> = [
       ...route.params,
     }),
   },
+  {
+    path: '/run/:sharedProgramFromURL',
+    name: routeSharedSimulator,
+    component: Simulator,
+    props: (route) => ({
+      ...route.params,
+    }),
+  },
   {
     path: '/fail', redirect: '/editor',
   },
@@ -56,7 +56,8 @@ import {
 } from '@/services/animationService/attentionAnimation';
 import Register from '@/services/interfaces/Register';
 import MemoryDataLine from '@/services/interfaces/MemoryDataLine';
-import { getMemory } from '@/services/dataServices/memoryService';
+import { getEmptyMemoryDataChange, updateDirtyMemoryLines } from '@/services/dataServices/dirtyMemoryService';
+import MemoryDataChange from '@/services/interfaces/reverseDebugger/MemoryDataChange';
 import { getLongSizeRegister } from '@/services/dataServices/registerAssignmentService';
 import {
   showFlagBytesExecutionZone,
@@ -72,8 +73,8 @@ import {
 } from '@/services/dataServices/registerService';
 import getInstructionPointer from '@/services/dataServices/instructionPointerService';
 
-function updateMemoryInSimulator(state: State, program: Program) {
-  state.memoryData = getMemory(program);
+function updateMemoryInSimulator(state: State, program: Program, memoryDataChange: MemoryDataChange) {
+  updateDirtyMemoryLines(state.memoryData, program, memoryDataChange);
 }
 
 function getRegisterIndexInSimulator(register: RegisterID, state: State) {
@@ -109,13 +110,13 @@ function updateAllFlagsInSimulator(state: State, program: Program) {
   state.flags = getFlags(program.ucInstance, program.flagsToShow);
 }
 
-function updateStateInSimulator(state: State, program: Program, memoryAccess: Array<MemoryDataLine>) {
+function updateStateInSimulator(state: State, program: Program, memoryAccess: Array<MemoryDataLine>, memoryDataChange: MemoryDataChange) {
   updateUsedBytesInByteInformation(memoryAccess, state.byteInformation.usedBytes);
   updateStackPointerInByteInformation(state, program);
   updateBasePointerInByteInformation(state, program);
   updateAllRegistersInSimulator(state, program);
   updateAllFlagsInSimulator(state, program);
-  updateMemoryInSimulator(state, program);
+  updateMemoryInSimulator(state, program, memoryDataChange);
   updateInstructionPointerInSimulator(state, program);
 }
 
@@ -160,12 +161,12 @@ async function animateImmediateAccess(immediates: Array<MemoryDataLine>) {
   }, Promise.resolve());
 }
 
-async function animateMemoryWrite(accessedMemoryLines: Array<MemoryDataLine>, state: State, program: Program) {
+async function animateMemoryWrite(accessedMemoryLines: Array<MemoryDataLine>, state: State, program: Program, memoryDataChange: MemoryDataChange) {
   await accessedMemoryLines.reduce(async (previousMemoryLine, memoryLine, index) => {
     await previousMemoryLine;
     await animateAttentionMemory(memoryLine, true, index);
     await animateMemoryLine(memoryLine, true, index);
-    updateMemoryInSimulator(state, program);
+    updateMemoryInSimulator(state, program, memoryDataChange);
   }, Promise.resolve());
 }
 
@@ -196,10 +197,12 @@ async function animateReadAccess(state: State) {
   await animateImmediateAccess(accessedElements.immediateAccess);
 }
 
-async function animateWriteAccess(state: State, program: Program) {
+async function animateWriteAccess(state: State, program: Program, memoryDataChange: MemoryDataChange) {
   const accessedElements = state.currentAccessedElements;
   updateUsedBytesInByteInformation(accessedElements.memoryWriteAccess, state.byteInformation.usedBytes);
-  await animateMemoryWrite(accessedElements.memoryWriteAccess, state, program);
+  await animateMemoryWrite(accessedElements.memoryWriteAccess, state, program, memoryDataChange);
+  // pages which were only read are shown as well
+  updateMemoryInSimulator(state, program, memoryDataChange);
   await animateRegisterWrite(accessedElements.registerWriteAccess, state, program);
   updateStackPointerInByteInformation(state, program);
   updateBasePointerInByteInformation(state, program);
@@ -211,19 +214,22 @@ async function animateWriteAccess(state: State, program: Program) {
   updateAllFlagsInSimulator(state, program);
 }
 
-export async function animateInstructionGeneric(state: State, program: Program, animateThisStep: boolean) {
+// Returns the memory lines patched during the step, required to step back
+export async function animateInstructionGeneric(state: State, program: Program, animateThisStep: boolean): Promise<MemoryDataChange> {
+  const memoryDataChange = getEmptyMemoryDataChange();
   if (animateThisStep) {
     await animateAttentionCurrentInstructionAssemblyBlock();
     await animateReadAccess(state);
     await animateExecutionBox(true);
-    await animateWriteAccess(state, program);
+    await animateWriteAccess(state, program, memoryDataChange);
     await animateExecutionBox(false);
     showFlagBytesExecutionZone(false, false);
   } else {
     const accessedElements = state.currentAccessedElements;
     const memoryAccess = accessedElements.memoryReadAccess.concat(accessedElements.memoryWriteAccess);
-    updateStateInSimulator(state, program, memoryAccess);
+    updateStateInSimulator(state, program, memoryAccess, memoryDataChange);
   }
+  return memoryDataChange;
 }
 
 export async function animateGetInstruction(currentInstruction: Instruction, state: State, animateThisStep: boolean) {
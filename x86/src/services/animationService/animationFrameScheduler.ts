@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+export interface PhaseFrameTiming {
+  phase: string;
+  byteMoves: number;
+  frames: number;
+  durationInMs: number;
+  averageFrameTimeInMs: number;
+  longestFrameTimeInMs: number;
+}
+
+interface ActivePhase {
+  timing: PhaseFrameTiming;
+  startTime: number;
+  lastFrameTime: number;
+}
+
+const maximumPhaseFrameTimings = 100;
+
+const phaseFrameTimings: Array<PhaseFrameTiming> = [];
+
+const activePhases: Set<ActivePhase> = new Set();
+
+let frameLoopRunning = false;
+
+export function requestFrame(callback: (time: number) => void) {
+  if (typeof window.requestAnimationFrame === 'function') {
+    window.requestAnimationFrame(callback);
+  } else {
+    window.setTimeout(() => callback(performance.now()), 16);
+  }
+}
+
+function recordFrame(time: number) {
+  activePhases.forEach((activePhase) => {
+    const { timing } = activePhase;
+    const frameTime = time - activePhase.lastFrameTime;
+    timing.frames += 1;
+    timing.longestFrameTimeInMs = Math.max(timing.longestFrameTimeInMs, frameTime);
+    activePhase.lastFrameTime = time;
+  });
+  if (activePhases.size > 0) {
+    requestFrame(recordFrame);
+  } else {
+    frameLoopRunning = false;
+  }
+}
+
+function finishPhase(activePhase: ActivePhase) {
+  activePhases.delete(activePhase);
+  const { timing } = activePhase;
+  timing.durationInMs = performance.now() - activePhase.startTime;
+  timing.averageFrameTimeInMs = timing.frames > 0 ? timing.durationInMs / timing.frames : 0;
+  phaseFrameTimings.push(timing);
+  if (phaseFrameTimings.length > maximumPhaseFrameTimings) {
+    phaseFrameTimings.shift();
+  }
+}
+
+// All running phases share one frame loop, which stops as soon as no phase is animated anymore.
+export function measurePhaseFrames(phase: string, byteMoves: number, phaseEnd: Promise<unknown>) {
+  const startTime = performance.now();
+  const activePhase: ActivePhase = {
+    timing: {
+      phase,
+      byteMoves,
+      frames: 0,
+      durationInMs: 0,
+      averageFrameTimeInMs: 0,
+      longestFrameTimeInMs: 0,
+    },
+    startTime,
+    lastFrameTime: startTime,
+  };
+  activePhases.add(activePhase);
+  if (!frameLoopRunning) {
+    frameLoopRunning = true;
+    requestFrame(recordFrame);
+  }
+  phaseEnd.then(() => finishPhase(activePhase));
+}
+
+// Frame timings of the last animated phases, oldest first
+export function getPhaseFrameTimings(): Array<PhaseFrameTiming> {
+  return phaseFrameTimings.slice();
+}
+
+export function clearPhaseFrameTimings() {
+  phaseFrameTimings.length = 0;
+}
@@ -28,33 +28,37 @@ import { getLocationIdsInLongSizeRegister } from '@/services/dataServices/regist
 import Flag from '@/services/interfaces/Flag';
 import {
   createLocationIds,
+  createLocationIdNumbers,
   getAnimationIdFlag,
   getAnimationIdImmediate,
-  getAnimationIdMemory,
+  getAnimationKeyMemory,
   getAnimationIdRegister,
   getLocationIdsFromBytes,
   getLocationIdsForCurrentInstruction, getAnimationIdJumpDestination,
 } from '@/services/helper/htmlIdService';
 import {
-  moveByte,
+  ByteMove,
+  moveBytes,
   moveExecutionBoxLeft,
   moveExecutionBoxRight,
   changeAnimationSpeed,
 } from '@/services/animationService/animationServiceHelper';
 import htmlId from '@/services/helper/htmlIds';
 import JumpDestination from '@/services/interfaces/JumpDestination';
+import { revealMemoryAddresses } from '@/services/animationService/scrollHelper';
+import { ElementKey } from '@/services/helper/elementRegistryService';
 
 export async function animateGetInstruction(instruction: Instruction) {
   const startAddressInstructionInMemory = parseInt(instruction.address.address, 16);
   const instructionSize = instruction.content.length;
   const targetForAnimation = getLocationIdsForCurrentInstruction(1)[0];
-  const locationIds = createLocationIds(startAddressInstructionInMemory, instructionSize);
+  const addresses = createLocationIdNumbers(startAddressInstructionInMemory, instructionSize);
+  await revealMemoryAddresses(addresses);
 
-  const allAnimations: Promise<unknown>[] = [];
-  locationIds.forEach((byteForAnimation, index) => {
-    allAnimations.push(moveByte(byteForAnimation, targetForAnimation, index));
-  });
-  return Promise.all(allAnimations);
+  const byteMoves: Array<ByteMove> = addresses.map((byteForAnimation, index) => ({
+    fromKey: byteForAnimation, toKey: targetForAnimation, byteNumberForOffset: index,
+  }));
+  return moveBytes('getInstruction', byteMoves);
 }
 
 export async function animateExecutionBox(toTheLeft: boolean) {
@@ -65,75 +69,67 @@ export async function animateExecutionBox(toTheLeft: boolean) {
   }
 }
 
-async function animateMoveByte(byteForAnimation: string, targetForAnimation: string, writeToMemory: boolean): Promise<unknown> {
+function getByteMove(byteForAnimation: ElementKey, targetForAnimation: ElementKey, writeToMemory: boolean): ByteMove {
   if (writeToMemory) {
-    return moveByte(targetForAnimation, byteForAnimation, 0);
+    return { fromKey: targetForAnimation, toKey: byteForAnimation, byteNumberForOffset: 0 };
   }
-  return moveByte(byteForAnimation, targetForAnimation, 0);
+  return { fromKey: byteForAnimation, toKey: targetForAnimation, byteNumberForOffset: 0 };
 }
 
 export async function animateRegister(register: Register, writeToMemory: boolean, index: number) {
   const registerName = register.name;
   const locationIdsLongSizeRegister: Array<string> = getLocationIdsInLongSizeRegister(getRegisterIdFromName(registerName));
   const locationIdsRegister: Array<string> = getLocationIdsFromBytes(register.content);
-  const allAnimations: Promise<unknown>[] = [];
 
-  locationIdsLongSizeRegister.forEach((registerForAnimation, indexRegisterByte) => {
+  const byteMoves: Array<ByteMove> = locationIdsLongSizeRegister.map((registerForAnimation, indexRegisterByte) => {
     const targetForAnimation = getAnimationIdRegister(locationIdsRegister[indexRegisterByte], writeToMemory, index);
-    allAnimations.push(animateMoveByte(registerForAnimation, targetForAnimation, writeToMemory));
+    return getByteMove(registerForAnimation, targetForAnimation, writeToMemory);
   });
-  return Promise.all(allAnimations);
+  return moveBytes('register', byteMoves);
 }
 
 export async function animateJumpDestination(jumpDestination: JumpDestination, currentInstruction: Instruction, writeToMemory: boolean, index: number) {
-  const allAnimations: Promise<unknown>[] = [];
   const locationIDs: Array<string> = getLocationIdsFromBytes(jumpDestination.content);
 
-  locationIDs.forEach((locationID) => {
-    const modifiedLocationIDs = getAnimationIdJumpDestination(locationID, writeToMemory, index);
-    allAnimations.push(moveByte(modifiedLocationIDs, htmlId.ipBlock, 0));
-  });
-  return Promise.all(allAnimations);
+  const byteMoves: Array<ByteMove> = locationIDs.map((locationID) => ({
+    fromKey: getAnimationIdJumpDestination(locationID, writeToMemory, index), toKey: htmlId.ipBlock, byteNumberForOffset: 0,
+  }));
+  return moveBytes('jumpDestination', byteMoves);
 }
 
 export async function animateFlag(flag: Flag, writeAccess: boolean) {
   const flagForAnimation = createLocationIds(0, 1, flag.name)[0];
   const targetForAnimation = getAnimationIdFlag(flagForAnimation, writeAccess);
-  return animateMoveByte(flagForAnimation, targetForAnimation, writeAccess);
+  return moveBytes('flag', [getByteMove(flagForAnimation, targetForAnimation, writeAccess)]);
 }
 
 export async function animateMemoryLine(memoryLine: MemoryDataLine, writeToMemory: boolean, index: number) {
-  const locationIds = getLocationIdsFromBytes(memoryLine.dataBytes);
-
-  const allAnimations: Promise<unknown>[] = [];
+  // the bytes of an accessed memory line are consecutive, so their keys follow from the line address
+  const addresses = createLocationIdNumbers(parseInt(memoryLine.address.address, 16), memoryLine.dataBytes.length);
+  await revealMemoryAddresses(addresses);
 
-  locationIds.forEach((byteForAnimation) => {
-    const targetForAnimation = getAnimationIdMemory(byteForAnimation, writeToMemory, index);
-    allAnimations.push(animateMoveByte(byteForAnimation, targetForAnimation, writeToMemory));
+  const byteMoves: Array<ByteMove> = addresses.map((byteForAnimation) => {
+    const targetForAnimation = getAnimationKeyMemory(byteForAnimation, writeToMemory, index);
+    return getByteMove(byteForAnimation, targetForAnimation, writeToMemory);
   });
-  return Promise.all(allAnimations);
+  return moveBytes('memoryLine', byteMoves);
 }
 
 export async function animateImmediate(immediate: MemoryDataLine) {
-  const allAnimations: Promise<unknown>[] = [];
   const locationIds: Array<string> = getLocationIdsFromBytes(immediate.dataBytes);
 
-  locationIds.forEach((locationId) => {
-    const targetForAnimation = getAnimationIdImmediate(locationId);
-    allAnimations.push(animateMoveByte(locationId, targetForAnimation, false));
-  });
-  return Promise.all(allAnimations);
+  const byteMoves: Array<ByteMove> = locationIds.map((locationId) => getByteMove(locationId, getAnimationIdImmediate(locationId), false));
+  return moveBytes('immediate', byteMoves);
 }
 
 export async function animateIncreaseInstructionPointer(currentInstruction: Instruction) {
   const instructionSize = currentInstruction.content.length;
-  const allAnimations: Promise<unknown>[] = [];
   const locationIDs: Array<string> = getLocationIdsForCurrentInstruction(instructionSize);
-  locationIDs.forEach((locationID) => {
-    allAnimations.push(moveByte(locationID, htmlId.ipBlock, 0));
-  });
 
-  return Promise.all(allAnimations);
+  const byteMoves: Array<ByteMove> = locationIDs.map((locationID) => ({
+    fromKey: locationID, toKey: htmlId.ipBlock, byteNumberForOffset: 0,
+  }));
+  return moveBytes('increaseInstructionPointer', byteMoves);
 }
 
 export async function changeAnimationServiceSpeed(speed: number) {
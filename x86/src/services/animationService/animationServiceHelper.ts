@@ -26,6 +26,8 @@ import {
 } from '@/services/animationService/documentHelper';
 import Coordinate from '@/services/interfaces/Coordinate';
 import htmlId, { htmlClass } from '@/services/helper/htmlIds';
+import { ElementKey, getRegisteredElement } from '@/services/helper/elementRegistryService';
+import { measurePhaseFrames, requestFrame } from '@/services/animationService/animationFrameScheduler';
 
 let animationSpeed = 1;
 
@@ -35,46 +37,123 @@ function setMoveByteAnimationParameters(elementToAnimate: HTMLElement, translate
   elementToAnimate.style.setProperty('--animationSpeed', `${animationSpeed}`);
 }
 
-function getTranslation(originalElement: Element, targetElement: Element, byteNumberForOffset: number): Coordinate {
-  let byteOffset: number;
-  const byteOffsetCalculatorElement = document.getElementById('byteOffsetCalculator');
-  if (byteOffsetCalculatorElement) {
-    byteOffset = byteOffsetCalculatorElement.getBoundingClientRect().width;
-  } else {
-    throw new Error('Byte offset calculator did not work');
-  }
-  const originalRect = originalElement.getBoundingClientRect();
-  const targetElementRect = targetElement.getBoundingClientRect();
-
+function getTranslation(originalRect: DOMRect, targetElementRect: DOMRect, byteOffset: number, byteNumberForOffset: number): Coordinate {
   return {
     x: targetElementRect.left - originalRect.left + (byteOffset * byteNumberForOffset),
     y: targetElementRect.top - originalRect.top,
   };
 }
 
+function getByteOffset(): number {
+  const byteOffsetCalculatorElement = getRegisteredElement(htmlId.byteOffsetCalculator);
+  if (byteOffsetCalculatorElement) {
+    return byteOffsetCalculatorElement.getBoundingClientRect().width;
+  }
+  throw new Error('Byte offset calculator did not work');
+}
+
 function startMoveByteAnimation(elementToAnimate: HTMLElement) {
   elementToAnimate.classList.add(htmlClass.moveByte);
 }
 
-export async function moveByte(fromID: string, toID: string, byteNumberForOffset: number) {
-  const copyElement = window.document.getElementById(fromID);
-  const targetElement = window.document.getElementById(toID);
+export interface ByteMove {
+  fromKey: ElementKey;
+  toKey: ElementKey;
+  byteNumberForOffset: number;
+}
 
-  if (copyElement && targetElement) {
-    const clonedNode = copyNode(copyElement);
-    const animationEndPromise = removeClonedElementAfterAnimation(clonedNode as HTMLElement);
+interface ByteMoveBatch {
+  phase: string;
+  byteMoves: Array<ByteMove>;
+  resolve: () => void;
+  reject: (error: Error) => void;
+}
+
+interface MeasuredByteMove {
+  copyElement: HTMLElement;
+  originalRect: DOMRect;
+  translate: Coordinate;
+}
 
-    const translate = getTranslation(copyElement, targetElement, byteNumberForOffset);
-    setMoveByteAnimationParameters(clonedNode as HTMLElement, translate);
+let pendingBatches: Array<ByteMoveBatch> = [];
 
-    startMoveByteAnimation(clonedNode as HTMLElement);
+function measureByteMoves(byteMoves: Array<ByteMove>, byteOffset: number): Array<MeasuredByteMove> {
+  const measuredByteMoves: Array<MeasuredByteMove> = [];
+  byteMoves.forEach((byteMove) => {
+    const copyElement = getRegisteredElement(byteMove.fromKey);
+    const targetElement = getRegisteredElement(byteMove.toKey);
+    if (copyElement && targetElement) {
+      const originalRect = copyElement.getBoundingClientRect();
+      measuredByteMoves.push({
+        copyElement,
+        originalRect,
+        translate: getTranslation(originalRect, targetElement.getBoundingClientRect(), byteOffset, byteMove.byteNumberForOffset),
+      });
+    }
+  });
+  return measuredByteMoves;
+}
+
+function startByteMoves(measuredByteMoves: Array<MeasuredByteMove>): Promise<unknown> {
+  return Promise.all(measuredByteMoves.map((measuredByteMove) => {
+    const clonedNode = copyNode(measuredByteMove.copyElement, measuredByteMove.originalRect) as HTMLElement;
+    const animationEndPromise = removeClonedElementAfterAnimation(clonedNode);
+    setMoveByteAnimationParameters(clonedNode, measuredByteMove.translate);
+    startMoveByteAnimation(clonedNode);
     return animationEndPromise;
+  }));
+}
+
+function rejectBatches(batches: Array<ByteMoveBatch>, error: unknown) {
+  const reason = error instanceof Error ? error : new Error(`Byte move animation failed: ${String(error)}`);
+  batches.forEach((batch) => batch.reject(reason));
+}
+
+// Runs once per frame for all byte moves requested since the last frame: every element is
+// measured first and only then are the clones inserted and animated, so the browser lays out
+// the document once per batch instead of once per byte.
+// A failing measurement or clone rejects every batch of the frame, so no caller waits forever.
+function flushByteMoves() {
+  const batches = pendingBatches;
+  pendingBatches = [];
+  try {
+    const byteOffset = getByteOffset();
+    const measuredBatches = batches.map((batch) => measureByteMoves(batch.byteMoves, byteOffset));
+    batches.forEach((batch, index) => {
+      const phaseEnd = startByteMoves(measuredBatches[index]);
+      measurePhaseFrames(batch.phase, measuredBatches[index].length, phaseEnd);
+      phaseEnd.then(batch.resolve, batch.reject);
+    });
+  } catch (error) {
+    // clones started before the failure remove themselves when their animation ends
+    rejectBatches(batches, error);
   }
-  return Promise.resolve();
+}
+
+// Moves a copy of every source byte onto its target. All moves of one phase are animated together.
+export async function moveBytes(phase: string, byteMoves: Array<ByteMove>): Promise<void> {
+  if (byteMoves.length === 0) {
+    return Promise.resolve();
+  }
+  return new Promise((resolve, reject) => {
+    pendingBatches.push({
+      phase, byteMoves, resolve, reject,
+    });
+    if (pendingBatches.length > 1) {
+      return;
+    }
+    try {
+      requestFrame(flushByteMoves);
+    } catch (error) {
+      const batches = pendingBatches;
+      pendingBatches = [];
+      rejectBatches(batches, error);
+    }
+  });
 }
 
 export async function moveExecutionBoxLeft() {
-  const executionBoxElement = document.getElementById(htmlId.magicBox);
+  const executionBoxElement = getRegisteredElement(htmlId.magicBox);
   if (executionBoxElement) {
     const animationEndPromise = waitForAnimationToFinish(executionBoxElement);
     executionBoxElement.classList.add(htmlClass.magicBoxLeft);
@@ -84,7 +163,7 @@ export async function moveExecutionBoxLeft() {
 }
 
 export async function moveExecutionBoxRight() {
-  const executionBoxElement = document.getElementById(htmlId.magicBox);
+  const executionBoxElement = getRegisteredElement(htmlId.magicBox);
   if (executionBoxElement) {
     executionBoxElement.classList.remove(htmlClass.magicBoxLeft);
   }
@@ -26,6 +26,7 @@ import {
 } from '@/services/animationService/documentHelper';
 import scrollLastElementIntoView from '@/services/animationService/scrollHelper';
 import { htmlClass } from '@/services/helper/htmlIds';
+import { getElementByLocationId } from '@/services/helper/elementRegistryService';
 
 let animationSpeed = 1;
 
@@ -74,7 +75,7 @@ function unhideElement(elementToAnimate: HTMLElement) {
 }
 
 async function elementAttentionWithCloning(locationID: string, attentionMode: AttentionMode) {
-  const copyElement = window.document.getElementById(locationID);
+  const copyElement = getElementByLocationId(locationID);
   if (copyElement) {
     const clonedNode = copyNode(copyElement);
     const animationEndPromise = removeClonedElementAfterAnimation(clonedNode as HTMLElement).then(() => { unhideElement(copyElement); });
@@ -86,7 +87,7 @@ async function elementAttentionWithCloning(locationID: string, attentionMode: At
 }
 
 async function elementAttention(locationID: string, attentionMode: AttentionMode) {
-  const element = window.document.getElementById(locationID);
+  const element = getElementByLocationId(locationID);
   if (element) {
     const animationEndPromise = removeAttentionAnimationAfterAnimation(element, attentionMode);
     startAttentionAnimation(element as HTMLElement, attentionMode);
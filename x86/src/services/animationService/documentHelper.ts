@@ -22,8 +22,7 @@
 
 import htmlId, { htmlClass } from '@/services/helper/htmlIds';
 
-function setInitialClonePosition(clonedElement: HTMLElement, originalElement: HTMLElement) {
-  const originalElementRect = originalElement.getBoundingClientRect();
+function setInitialClonePosition(clonedElement: HTMLElement, originalElementRect: DOMRect) {
   const element = clonedElement;
   element.style.position = 'absolute';
   element.style.top = `${originalElementRect.top}px`;
@@ -31,19 +30,21 @@ function setInitialClonePosition(clonedElement: HTMLElement, originalElement: HT
   element.style.zIndex = '1000';
 }
 
-function insertNodeIntoDocument(nodeToInsert: Node, originalElement: HTMLElement) {
+function insertNodeIntoDocument(nodeToInsert: Node, originalElementRect: DOMRect) {
   const insertAtElement = window.document.getElementsByClassName(htmlClass.qPageContainer)[0];
   insertAtElement.appendChild(nodeToInsert);
-  setInitialClonePosition(nodeToInsert as HTMLElement, originalElement);
+  setInitialClonePosition(nodeToInsert as HTMLElement, originalElementRect);
 }
 
-export function copyNode(elementToCopy: HTMLElement): Node {
+// The rect of the original element can be passed if it was already measured, so a batch of
+// copies can be inserted without forcing a layout between them.
+export function copyNode(elementToCopy: HTMLElement, originalElementRect = elementToCopy.getBoundingClientRect()): Node {
   const clonedNode = elementToCopy.cloneNode(true);
   // Add a class to avoid double animations within the CSS of the clonedElement
   (clonedNode as HTMLElement).classList.add(htmlClass.copyNode);
   // Change id of the clone to be unique
   (clonedNode as HTMLElement).id = `${htmlId.clonePrefix}_${elementToCopy.id}`;
-  insertNodeIntoDocument(clonedNode, elementToCopy);
+  insertNodeIntoDocument(clonedNode, originalElementRect);
   return clonedNode;
 }
 
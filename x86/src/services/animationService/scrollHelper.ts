@@ -21,6 +21,9 @@
  */
 
 import { scrollIntoView } from 'scroll-polyfill';
+import {
+  getElementByLocationId, hasRegisteredElement, isMemoryByteLocationId,
+} from '@/services/helper/elementRegistryService';
 
 async function scrollElementIntoView(elementToScroll: HTMLElement): Promise<unknown> {
   return scrollIntoView(elementToScroll, {
@@ -30,9 +33,36 @@ async function scrollElementIntoView(elementToScroll: HTMLElement): Promise<unkn
   });
 }
 
+type MemoryLineRevealer = (addresses: Array<number>) => Promise<void>;
+
+let memoryLineRevealer: MemoryLineRevealer | undefined;
+
+// The memory view only renders the lines within its scroll window and registers a revealer
+// to render and scroll to the lines of the given addresses.
+export function setMemoryLineRevealer(revealer: MemoryLineRevealer | undefined) {
+  memoryLineRevealer = revealer;
+}
+
+export async function revealMemoryAddresses(addresses: Array<number>) {
+  if (memoryLineRevealer) {
+    const addressesToReveal = addresses.filter((address) => !hasRegisteredElement(address));
+    if (addressesToReveal.length > 0) {
+      await memoryLineRevealer(addressesToReveal);
+    }
+  }
+}
+
+export async function revealMemoryBytes(locationIDs: Array<string>) {
+  const addresses = locationIDs
+    .filter((locationID) => isMemoryByteLocationId(locationID))
+    .map((locationID) => parseInt(locationID, 16));
+  return revealMemoryAddresses(addresses);
+}
+
 export default async function scrollLastElementIntoView(scrollElementToView: boolean, locationIDs: Array<string>) {
   if (scrollElementToView) {
-    const lastElementToScrollIntoView = document.getElementById(locationIDs[locationIDs.length - 1]);
+    await revealMemoryBytes(locationIDs.slice(-1));
+    const lastElementToScrollIntoView = getElementByLocationId(locationIDs[locationIDs.length - 1]);
     if (lastElementToScrollIntoView) {
       await scrollElementIntoView(lastElementToScrollIntoView);
     }
@@ -25,10 +25,11 @@ import {
   getAnimationZoneIdMemory, getAnimationZoneIdRegister,
 } from '@/services/helper/htmlIdService';
 import { htmlClass } from '@/services/helper/htmlIds';
+import { getRegisteredElement } from '@/services/helper/elementRegistryService';
 
 export function showBytesLocationIDs(locationIds: string[], show: boolean) {
   locationIds.forEach((locationId) => {
-    const byteToShowOrHide = document.getElementById(locationId);
+    const byteToShowOrHide = getRegisteredElement(locationId);
 
     if (byteToShowOrHide) {
       if (show) {
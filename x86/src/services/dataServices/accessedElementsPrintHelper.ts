@@ -71,7 +71,7 @@ function printFlagsToString(flags: Array<Flag>, changedElements: Array<string>)
   changedElements.push(`${flagsPrefix}: ${flagStrings.join(', ')}`);
 }
 
-export function printWriteAccessElementsToString(accessedElements: AccessedElements): Array<string> {
+export function printWriteAccessElementsToString(accessedElements: Pick<AccessedElements, 'memoryWriteAccess' | 'registerWriteAccess' | 'flagWriteAccess'>): Array<string> {
   const changedElements: Array<string> = [];
   accessedElements.memoryWriteAccess.forEach((memoryLine) => {
     printMemoryLineToString(memoryLine, changedElements);
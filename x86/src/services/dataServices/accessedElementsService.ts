@@ -36,15 +36,29 @@ import getJumpDestinationFromJumpInstruction from '@/services/dataServices/jumpD
 import Unicorn from '@/services/emulator/emulatorService';
 import { eUC, RegisterID } from '@/services/emulator/emulatorEnums';
 import { getLongSizeRegister } from '@/services/dataServices/registerAssignmentService';
+import { createRegisterMask, registerMaskHasRegistersNotIn } from '@/services/dataServices/registerMaskService';
 import InstructionOperands from '@/services/interfaces/InstructionOperands';
+import { markAccessedPagesResident } from '@/services/dataServices/memoryMapService';
+import { markMemoryLinesDirty } from '@/services/dataServices/dirtyMemoryService';
+import { getDataCache } from '@/services/dataServices/dataCacheService';
 import Program from '@/services/interfaces/Program';
+import ResolvedMemoryAccess from '@/services/interfaces/ResolvedMemoryAccess';
+import MemoryDataLine from '@/services/interfaces/MemoryDataLine';
+import predictMemoryAccesses, {
+  getPredictedReadAccesses,
+  getPredictedWriteAccesses,
+} from '@/services/dataServices/memoryAccessPredictionService';
 import {
   getFlagsLabel,
   getImmediateNames, getJumpLabel,
   getMemoryAccessNames,
   getRegisterNames,
-  printWriteAccessElementsToString,
 } from '@/services/dataServices/accessedElementsPrintHelper';
+import {
+  appendChangeRecord,
+  createChangeHistoryLog,
+  formatChangeHistoryEntry,
+} from '@/services/dataServices/changeHistoryService';
 
 function registersContainsRegisterId(registerId: RegisterID, registers: Array<RegisterID>): boolean {
   const index = registers.findIndex((register) => register === registerId);
@@ -61,7 +75,20 @@ function addNewRegisterToRegistersToShow(newRegisterOperands: Array<RegisterID>,
   return oldRegisters;
 }
 
+function registerMasksContainNewRegisters(operands: InstructionOperands, registersToShow: Array<RegisterID>): boolean {
+  if (!operands.registersReadMask || !operands.registersWriteMask) {
+    return true;
+  }
+  const registersToShowMask = createRegisterMask(registersToShow);
+  return registerMaskHasRegistersNotIn(operands.registersReadMask, registersToShowMask)
+    || registerMaskHasRegistersNotIn(operands.registersWriteMask, registersToShowMask);
+}
+
 export function getNewRegistersToShow(operands: InstructionOperands, registersToShow: Array<RegisterID>): Array<RegisterID> {
+  // most instructions only access registers which are already shown, the masks answer this without scanning the lists
+  if (!registerMasksContainNewRegisters(operands, registersToShow)) {
+    return registersToShow;
+  }
   const registerOperandsRead = operands.registersRead;
   const registerOperandsWrite = operands.registersWrite;
   let registers = registersToShow;
@@ -69,19 +96,69 @@ export function getNewRegistersToShow(operands: InstructionOperands, registersTo
   return addNewRegisterToRegistersToShow(registerOperandsWrite, registers);
 }
 
-export function getReadAccessElements(state: State, ucInstance: Unicorn): AccessedElements {
+interface PredictedMemoryAccesses {
+  reads: Array<ResolvedMemoryAccess>;
+  writes: Array<ResolvedMemoryAccess>;
+}
+
+// Accesses of the current instruction resolved before its execution. Every program has its own emulator and memory
+// hooks, so the predictions are kept per program. A program without an entry records all accesses with its hooks.
+const predictedMemoryAccesses = new WeakMap<Program, PredictedMemoryAccesses>();
+
+// The hooks only record accesses the resolver did not model, like the implicit accesses of enter or string instructions
+function isPredictedAccess(accesses: Array<ResolvedMemoryAccess> | undefined, address: number, size: number): boolean {
+  return accesses !== undefined
+    && accesses.some((access) => address >= access.address && address + size <= access.address + access.size);
+}
+
+function readPredictedMemoryLines(accesses: Array<ResolvedMemoryAccess>, ucInstance: Unicorn): Array<MemoryDataLine> {
+  return accesses.map((access) => getMemoryLineFromReadAccess({
+    addrLo: access.address, addrHi: 0, size: access.size, valueLo: 0, valueHi: 0,
+  }, ucInstance));
+}
+
+// Resolves the memory reads before the instruction is executed. String instructions with a rep prefix access
+// memory once per iteration, they are left to the memory hooks like libraries without resolve_memory_operands.
+function predictMemoryReadAccess(state: State, program: Program): Array<MemoryDataLine> | undefined {
+  const instruction = state.currentInstruction;
+  if (instruction.assemblyInterpretation.trimStart().startsWith('rep')) {
+    return undefined;
+  }
+  const accesses = predictMemoryAccesses(program, instruction);
+  if (accesses === undefined) {
+    return undefined;
+  }
+  try {
+    const reads = getPredictedReadAccesses(accesses);
+    const readAccess = readPredictedMemoryLines(reads, program.ucInstance);
+    predictedMemoryAccesses.set(program, { reads, writes: getPredictedWriteAccesses(accesses) });
+    return readAccess;
+  } catch {
+    // unmapped memory, the instruction faults and the hooks record what was accessed until then
+    return undefined;
+  }
+}
+
+export function getReadAccessElements(state: State, program: Program): AccessedElements {
+  const { ucInstance } = program;
   const registerOperandsRead = state.currentInstruction.operands.registersRead;
   const immediateOperand = state.currentInstruction.operands.immediate;
   const accessedElements = state.currentAccessedElements;
   accessedElements.immediateAccess = getMemoryDataLinesFromImmediateOperands(immediateOperand);
   accessedElements.registerReadAccess = getRegistersFromRegisterIDs(registerOperandsRead, ucInstance);
+  predictedMemoryAccesses.delete(program);
+  const memoryReadAccess = predictMemoryReadAccess(state, program);
+  if (memoryReadAccess !== undefined) {
+    accessedElements.memoryReadAccess = memoryReadAccess;
+  }
   return accessedElements;
 }
 
 // The flags that are both, tested and written are contained in the flagWriteAccess and not in the flagTestAccess.
 // Therefore, it does not matter whether you query the tested flags before or after executing
 // the instruction.
-export function getWriteAccessElements(state: State, ucInstance: Unicorn): AccessedElements {
+export function getWriteAccessElements(state: State, program: Program): AccessedElements {
+  const { ucInstance } = program;
   const { operands } = state.currentInstruction;
   const accessedElements = state.currentAccessedElements;
   const registerOperandsWrite = operands.registersWrite;
@@ -89,14 +166,20 @@ export function getWriteAccessElements(state: State, ucInstance: Unicorn): Acces
   accessedElements.flagTestAccess = getFlagsFromFlagIDs(operands.flagsTest, ucInstance);
   accessedElements.flagWriteAccess = getFlagsFromFlagIDs(operands.flagsWrite, ucInstance);
   accessedElements.jumpDestinationWriteAccess = getJumpDestinationFromJumpInstruction(state, ucInstance);
+  const predicted = predictedMemoryAccesses.get(program);
+  if (predicted !== undefined) {
+    // the hooks already added the writes which were not predicted
+    accessedElements.memoryWriteAccess = [...readPredictedMemoryLines(predicted.writes, ucInstance), ...accessedElements.memoryWriteAccess];
+    predictedMemoryAccesses.delete(program);
+  }
   return accessedElements;
 }
 
+// The step controller keeps compact records, this formats a single one right away
 export default function getChangeHistory(instruction: Instruction, accessedElements: AccessedElements): ChangeHistory {
-  return {
-    instruction: instruction.assemblyInterpretation,
-    changedElements: printWriteAccessElementsToString(accessedElements),
-  };
+  const log = createChangeHistoryLog();
+  appendChangeRecord(log, instruction.assemblyInterpretation, accessedElements, 1);
+  return formatChangeHistoryEntry(log, 0);
 }
 
 export function getOutputNamesForExecutionBox(accessedElements: AccessedElements): Array<string> {
@@ -130,8 +213,21 @@ export function getEmptyAccessedElements(): AccessedElements {
   };
 }
 
+// Runs over whole calls are summarized, only the dirty lines and resident pages are tracked meanwhile.
+// Accesses resolved before the execution are not recorded twice.
+let recordMemoryAccesses = true;
+
+export function setMemoryAccessesRecorded(recorded: boolean) {
+  recordMemoryAccesses = recorded;
+}
+
 export function addMemoryAccessHook(state: State, program: Program) {
   program.ucInstance.hook_add(eUC.HOOK_MEM_READ, (handle: number, type: number, addrLo: number, addrHi: number, size: number) => {
+    markAccessedPagesResident(program, addrLo, size);
+    getDataCache()?.record(addrLo, size, program.ucInstance.instruction_pointer_read());
+    if (!recordMemoryAccesses || isPredictedAccess(predictedMemoryAccesses.get(program)?.reads, addrLo, size)) {
+      return;
+    }
     const memLine = getMemoryLineFromReadAccess({
       addrLo, addrHi, size, valueLo: 0, valueHi: 0,
     }, program.ucInstance);
@@ -139,6 +235,12 @@ export function addMemoryAccessHook(state: State, program: Program) {
   }, 0, 0, -1, []);
 
   program.ucInstance.hook_add(eUC.HOOK_MEM_WRITE, (handle: number, type: number, addrLo: number, addrHi: number, size: number, valueLo: number, valueHi: number) => {
+    markAccessedPagesResident(program, addrLo, size);
+    markMemoryLinesDirty(program, addrLo, size);
+    getDataCache()?.record(addrLo, size, program.ucInstance.instruction_pointer_read());
+    if (!recordMemoryAccesses || isPredictedAccess(predictedMemoryAccesses.get(program)?.writes, addrLo, size)) {
+      return;
+    }
     const memLine = getMemoryLineFromWriteAccess({
       addrLo, addrHi, size, valueLo, valueHi,
     });
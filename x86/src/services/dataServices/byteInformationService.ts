@@ -32,32 +32,30 @@ import { createLocationIdNumbers } from '@/services/helper/htmlIdService';
 import Program from '@/services/interfaces/Program';
 import Instruction from '@/services/interfaces/Instruction';
 import State from '@/services/interfaces/State';
+import ByteSet from '@/services/interfaces/ByteSet';
+import {
+  addByteToSet,
+  byteSetContains,
+  createByteSet,
+} from '@/services/dataServices/byteSetService';
 
-export function byteInformationUsedBytesContainsAddressNumber(address: number, usedBytes: Array<number>): boolean {
-  const index = usedBytes.findIndex((addressUsedByte) => addressUsedByte === address);
-  return index >= 0;
+export function byteInformationUsedBytesContainsAddressNumber(address: number, usedBytes: ByteSet): boolean {
+  return byteSetContains(usedBytes, address);
 }
 
-export function updateUsedBytesInByteInformation(memoryLines: Array<MemoryDataLine>, usedBytes: Array<number>) {
+export function updateUsedBytesInByteInformation(memoryLines: Array<MemoryDataLine>, usedBytes: ByteSet) {
   memoryLines.forEach((line) => {
     line.dataBytes.forEach((byte) => {
-      const addressNumber = parseInt(byte.locationId, 16);
-      if (!byteInformationUsedBytesContainsAddressNumber(addressNumber, usedBytes)) {
-        usedBytes.push(addressNumber);
-      }
+      addByteToSet(usedBytes, parseInt(byte.locationId, 16));
     });
   });
 }
 
-function addPointerToUsedBytesInByteInformation(pointerAddress: number, usedBytes: Array<number>) {
-  if (!byteInformationUsedBytesContainsAddressNumber(pointerAddress, usedBytes)) {
-    usedBytes.push(pointerAddress);
-  }
-}
-
+// addresses are limited to 32 bit, see highestMemoryAddress in memoryMapService
 function getPointerAddressFromRegister(registerId: RegisterID, ucInstance: Unicorn): number {
-  const rbpRegister = getRegisters(ucInstance, [registerId])[0];
-  const addressString = rbpRegister.content[1].content.concat(rbpRegister.content[0].content);
+  const pointerRegister = getRegisters(ucInstance, [registerId])[0];
+  const addressBytes = pointerRegister.content.slice(0, 4).reverse();
+  const addressString = addressBytes.map((byte) => byte.content).join('');
   return parseInt(addressString, 16);
 }
 
@@ -82,38 +80,38 @@ function setCodeInfo(codeAddress: number, codeSizeInBytes: number): CodeInformat
   };
 }
 
-function updatePointerInformation(register: RegisterID, ucInstance: Unicorn, usedBytes: Array<number>): PointerInformation {
+function updatePointerInformation(register: RegisterID, ucInstance: Unicorn, usedBytes: ByteSet): PointerInformation {
   const addressFromPointerRegister = getPointerAddressFromRegister(register, ucInstance);
   const pointerInfo: PointerInformation = getEmptyPointerInfo();
   pointerInfo.pointerAddress = addressFromPointerRegister;
   pointerInfo.pointerBytes = createLocationIdNumbers(addressFromPointerRegister, 8);
-  addPointerToUsedBytesInByteInformation(pointerInfo.pointerAddress, usedBytes);
+  addByteToSet(usedBytes, pointerInfo.pointerAddress);
   return pointerInfo;
 }
 
 export function buildByteInformation(program: Program): ByteInformation {
-  const basePointerAddress = getPointerAddressFromRegister(RegisterID.BP, program.ucInstance);
-  const stackPointerAddress = getPointerAddressFromRegister(RegisterID.SP, program.ucInstance);
-  const usedBytes = [basePointerAddress, stackPointerAddress];
+  const basePointerAddress = getPointerAddressFromRegister(RegisterID.RBP, program.ucInstance);
+  const stackPointerAddress = getPointerAddressFromRegister(RegisterID.RSP, program.ucInstance);
+  const usedBytes = createByteSet([basePointerAddress, stackPointerAddress]);
   return {
     basePointerInformation: setPointerInfo(basePointerAddress),
     stackPointerInformation: setPointerInfo(stackPointerAddress),
     instructionPointerInformation: setPointerInfo(program.codeAddress),
-    unevenInstructionBytes: [],
-    evenInstructionBytes: [],
+    unevenInstructionBytes: createByteSet(),
+    evenInstructionBytes: createByteSet(),
     usedBytes,
     code: setCodeInfo(program.codeAddress, program.codeSizeInBytes),
   };
 }
 
 export function updateBasePointerInByteInformation(state: State, program: Program) {
-  const basePointerInfo = updatePointerInformation(RegisterID.BP, program.ucInstance, state.byteInformation.usedBytes);
+  const basePointerInfo = updatePointerInformation(RegisterID.RBP, program.ucInstance, state.byteInformation.usedBytes);
   state.byteInformation.basePointerInformation.pointerBytes = basePointerInfo.pointerBytes;
   state.byteInformation.basePointerInformation.pointerAddress = basePointerInfo.pointerAddress;
 }
 
 export function updateStackPointerInByteInformation(state: State, program: Program) {
-  const stackPointerInfo = updatePointerInformation(RegisterID.SP, program.ucInstance, state.byteInformation.usedBytes);
+  const stackPointerInfo = updatePointerInformation(RegisterID.RSP, program.ucInstance, state.byteInformation.usedBytes);
   state.byteInformation.stackPointerInformation.pointerBytes = stackPointerInfo.pointerBytes;
   state.byteInformation.stackPointerInformation.pointerAddress = stackPointerInfo.pointerAddress;
 }
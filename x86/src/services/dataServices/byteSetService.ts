@@ -0,0 +1,109 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import ByteSet from '@/services/interfaces/ByteSet';
+import { memoryPageSizeInBytes } from '@/services/dataServices/memoryMapService';
+
+/* eslint no-bitwise: 0 */
+
+const wordsPerPage = memoryPageSizeInBytes / 32;
+
+function getOffsetInPage(address: number): number {
+  return address % memoryPageSizeInBytes;
+}
+
+export function addByteToSet(byteSet: ByteSet, address: number) {
+  const pageAddress = address - getOffsetInPage(address);
+  let page = byteSet.pages[pageAddress];
+  if (page === undefined) {
+    page = new Uint32Array(wordsPerPage);
+    byteSet.pages[pageAddress] = page;
+  }
+  const offset = getOffsetInPage(address);
+  page[offset >>> 5] |= 1 << (offset & 31);
+}
+
+export function addBytesToSet(byteSet: ByteSet, startAddress: number, size: number) {
+  for (let address = startAddress; address < startAddress + size; address += 1) {
+    addByteToSet(byteSet, address);
+  }
+}
+
+export function createByteSet(addresses: Array<number> = []): ByteSet {
+  const byteSet: ByteSet = { pages: {} };
+  addresses.forEach((address) => addByteToSet(byteSet, address));
+  return byteSet;
+}
+
+export function byteSetContains(byteSet: ByteSet, address: number): boolean {
+  const offset = getOffsetInPage(address);
+  const page = byteSet.pages[address - offset];
+  return page !== undefined && (page[offset >>> 5] & (1 << (offset & 31))) !== 0;
+}
+
+// Returns the addresses in ascending order
+export function getAddressesOfByteSet(byteSet: ByteSet): Array<number> {
+  const addresses: Array<number> = [];
+  Object.keys(byteSet.pages)
+    .map((pageAddress) => Number(pageAddress))
+    .sort((a, b) => a - b)
+    .forEach((pageAddress) => {
+      const page = byteSet.pages[pageAddress];
+      for (let offset = 0; offset < memoryPageSizeInBytes; offset += 1) {
+        if ((page[offset >>> 5] & (1 << (offset & 31))) !== 0) {
+          addresses.push(pageAddress + offset);
+        }
+      }
+    });
+  return addresses;
+}
+
+function isEmptyPage(page: Uint32Array | undefined): boolean {
+  return page === undefined || page.every((word) => word === 0);
+}
+
+// Compares page by page, the cost depends on the number of touched pages only
+export function byteSetsEqual(byteSet: ByteSet, otherByteSet: ByteSet): boolean {
+  const pageAddresses = new Set([...Object.keys(byteSet.pages), ...Object.keys(otherByteSet.pages)]);
+  return Array.from(pageAddresses).every((key) => {
+    const pageAddress = Number(key);
+    const page = byteSet.pages[pageAddress];
+    const otherPage = otherByteSet.pages[pageAddress];
+    if (page === undefined || otherPage === undefined) {
+      return isEmptyPage(page) && isEmptyPage(otherPage);
+    }
+    return page.every((word, index) => word === otherPage[index]);
+  });
+}
+
+export function cloneByteSet(byteSet: ByteSet): ByteSet {
+  const clone: ByteSet = { pages: {} };
+  Object.keys(byteSet.pages).forEach((key) => {
+    const pageAddress = Number(key);
+    clone.pages[pageAddress] = Uint32Array.from(byteSet.pages[pageAddress]);
+  });
+  return clone;
+}
+
+export function isByteSet(value: unknown): value is ByteSet {
+  return typeof value === 'object' && value !== null && 'pages' in value;
+}
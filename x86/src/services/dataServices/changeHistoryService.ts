@@ -0,0 +1,209 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { ChangeHistory } from '@/services/interfaces/State';
+import ChangeHistoryLog, { ChangedContainer, ChangeRecord } from '@/services/interfaces/ChangeHistoryLog';
+import AccessedElements from '@/services/interfaces/AccessedElements';
+import Byte from '@/services/interfaces/Byte';
+import { printWriteAccessElementsToString } from '@/services/dataServices/accessedElementsPrintHelper';
+
+// The indices of the interned strings are not part of the log, so it stays plain data for the reverse debugger and sessions.
+// Logs and their snapshots share the string tables, which are only appended to or replaced.
+const internedStringIndices = new WeakMap<Array<string>, Map<string, number>>();
+
+// record and spilled instruction storage handed out to snapshots, it is copied before it is changed below its count
+const sharedStorage = new WeakSet<object>();
+
+const minimumSpillCapacity = 1024;
+
+export function createChangeHistoryLog(): ChangeHistoryLog {
+  return {
+    instructions: [],
+    strings: [],
+    spilledInstructions: new Uint32Array(0),
+    spilledCount: 0,
+    records: [],
+    recordCount: 0,
+  };
+}
+
+function getStringIndices(strings: Array<string>): Map<string, number> {
+  let indices = internedStringIndices.get(strings);
+  if (indices === undefined) {
+    indices = new Map(strings.map((string, index): [string, number] => [string, index]));
+    internedStringIndices.set(strings, indices);
+  }
+  return indices;
+}
+
+function intern(strings: Array<string>, string: string): number {
+  const indices = getStringIndices(strings);
+  let index = indices.get(string);
+  if (index === undefined) {
+    index = strings.length;
+    strings.push(string);
+    indices.set(string, index);
+  }
+  return index;
+}
+
+export function internString(log: ChangeHistoryLog, string: string): number {
+  return intern(log.strings, string);
+}
+
+function internContainer(log: ChangeHistoryLog, name: string, bytes: Array<Byte>): ChangedContainer {
+  return {
+    name: internString(log, name),
+    content: bytes.map((byte) => internString(log, byte.content)),
+  };
+}
+
+export function getChangeHistoryLength(log: ChangeHistoryLog): number {
+  return log.spilledCount + log.recordCount;
+}
+
+// Returns a snapshot of the log in constant time, it shares the storage and keeps the current counts
+export function shareChangeHistory(log: ChangeHistoryLog): ChangeHistoryLog {
+  sharedStorage.add(log.records);
+  sharedStorage.add(log.spilledInstructions);
+  return { ...log };
+}
+
+function appendSpilledInstructions(log: ChangeHistoryLog, records: Array<ChangeRecord>) {
+  const count = log.spilledCount + records.length;
+  if (count > log.spilledInstructions.length) {
+    const grown = new Uint32Array(Math.max(count, log.spilledInstructions.length * 2, minimumSpillCapacity));
+    grown.set(log.spilledInstructions.subarray(0, log.spilledCount));
+    log.spilledInstructions = grown;
+  }
+  records.forEach((record, index) => {
+    log.spilledInstructions[log.spilledCount + index] = record.instruction;
+  });
+  log.spilledCount = count;
+}
+
+// Only the strings of the kept records stay, the records are re-interned into a new table
+function pruneStrings(log: ChangeHistoryLog, records: Array<ChangeRecord>): Array<ChangeRecord> {
+  const previousStrings = log.strings;
+  const strings: Array<string> = [];
+  const reintern = (index: number) => intern(strings, previousStrings[index]);
+  const reinternContainer = (container: ChangedContainer): ChangedContainer => ({
+    name: reintern(container.name),
+    content: container.content.map(reintern),
+  });
+  log.strings = strings;
+  return records.map((record) => ({
+    ...record,
+    memory: record.memory.map(reinternContainer),
+    registers: record.registers.map(reinternContainer),
+    flags: record.flags.map(reinternContainer),
+  }));
+}
+
+// Records are spilled in chunks of a quarter of the window, which keeps appending in amortized constant time
+function spillRecords(log: ChangeHistoryLog, retention: number) {
+  if (log.recordCount > retention) {
+    const spilled = log.recordCount - Math.floor((retention * 3) / 4);
+    appendSpilledInstructions(log, log.records.slice(0, spilled));
+    log.records = pruneStrings(log, log.records.slice(spilled, log.recordCount));
+    log.recordCount = log.records.length;
+  }
+}
+
+// Only the written elements are kept, as interned strings, they are formatted when the entry is shown
+export function appendChangeRecord(log: ChangeHistoryLog, instruction: string, accessedElements: AccessedElements, retention: number) {
+  log.records.push({
+    instructionIndex: getChangeHistoryLength(log),
+    instruction: intern(log.instructions, instruction),
+    memory: accessedElements.memoryWriteAccess.map((memoryLine) => internContainer(log, memoryLine.address.address, memoryLine.dataBytes)),
+    registers: accessedElements.registerWriteAccess.map((register) => internContainer(log, register.name, register.content)),
+    flags: accessedElements.flagWriteAccess.map((flag) => internContainer(log, flag.name, [flag.content])),
+  });
+  log.recordCount = log.records.length;
+  spillRecords(log, retention);
+}
+
+function truncateRecords(log: ChangeHistoryLog, count: number) {
+  if (sharedStorage.has(log.records)) {
+    log.records = log.records.slice(0, count);
+  } else {
+    log.records.splice(count);
+  }
+  log.recordCount = count;
+}
+
+// Stepping back removes the entries of the instructions which are not executed anymore
+export function truncateChangeHistory(log: ChangeHistoryLog, length: number) {
+  if (length < log.spilledCount) {
+    if (sharedStorage.has(log.spilledInstructions)) {
+      log.spilledInstructions = log.spilledInstructions.slice(0, length);
+    }
+    log.spilledCount = length;
+    truncateRecords(log, 0);
+  } else if (length < getChangeHistoryLength(log)) {
+    truncateRecords(log, length - log.spilledCount);
+  }
+}
+
+function getBytes(log: ChangeHistoryLog, container: ChangedContainer): Array<Byte> {
+  return container.content.map((content) => ({ locationId: '', content: log.strings[content] }));
+}
+
+function formatChangeRecord(log: ChangeHistoryLog, record: ChangeRecord): ChangeHistory {
+  return {
+    instruction: log.instructions[record.instruction],
+    changedElements: printWriteAccessElementsToString({
+      memoryWriteAccess: record.memory.map((container) => ({
+        address: { address: log.strings[container.name] },
+        dataBytes: getBytes(log, container),
+      })),
+      registerWriteAccess: record.registers.map((container) => ({
+        name: log.strings[container.name],
+        content: getBytes(log, container),
+      })),
+      flagWriteAccess: record.flags.map((container) => ({
+        name: log.strings[container.name],
+        content: getBytes(log, container)[0],
+      })),
+    }),
+  };
+}
+
+// Spilled entries are shown with their instruction only
+export function formatChangeHistoryEntry(log: ChangeHistoryLog, index: number): ChangeHistory {
+  if (index < log.spilledCount) {
+    return {
+      instruction: log.instructions[log.spilledInstructions[index]],
+      changedElements: [],
+    };
+  }
+  return formatChangeRecord(log, log.records[index - log.spilledCount]);
+}
+
+export function formatChangeHistoryEntries(log: ChangeHistoryLog, from: number, size: number): Array<ChangeHistory> {
+  const entries: Array<ChangeHistory> = [];
+  const until = Math.min(from + size, getChangeHistoryLength(log));
+  for (let index = from; index < until; index += 1) {
+    entries.push(formatChangeHistoryEntry(log, index));
+  }
+  return entries;
+}
@@ -0,0 +1,289 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import DataCacheStatistics, {
+  CacheAccessCounts, DataCacheConfiguration, ReplacementPolicy,
+} from '@/services/interfaces/DataCache';
+import EditorLine from '@/services/interfaces/codeEditor/EditorLine';
+import { memoryLineLength } from '@/services/dataServices/memoryService';
+import { countTrace } from '@/services/helper/traceService';
+
+/*
+ * Model of an L1 data cache, fed by the memory hooks with the loads and stores of the guest.
+ * The hooks only append the accesses to a buffer, they are simulated in batches when the buffer is full
+ * or when the statistics are read, so the model can stay enabled during runs.
+ * Stores allocate lines like loads, the model counts hits and misses and does not track dirty lines.
+ */
+
+/* eslint no-bitwise: 0 */
+
+// address, size and instruction address of each buffered access
+const entriesPerAccess = 3;
+const bufferedAccesses = 4096;
+const emptyWay = -1;
+
+function isPowerOfTwo(value: number): boolean {
+  return Number.isInteger(value) && value > 0 && (value & (value - 1)) === 0;
+}
+
+export function validateDataCacheConfiguration(configuration: DataCacheConfiguration) {
+  const { sizeInBytes, lineSizeInBytes, associativity } = configuration;
+  if (!isPowerOfTwo(sizeInBytes)) {
+    throw new Error(`Cache size ${sizeInBytes} is not a power of two.`);
+  }
+  if (!isPowerOfTwo(lineSizeInBytes) || lineSizeInBytes > sizeInBytes) {
+    throw new Error(`Cache line size ${lineSizeInBytes} is not a power of two up to the cache size.`);
+  }
+  if (!isPowerOfTwo(associativity) || associativity > sizeInBytes / lineSizeInBytes) {
+    throw new Error(`Associativity ${associativity} is not a power of two up to the number of cache lines.`);
+  }
+  if (!Object.values(ReplacementPolicy).includes(configuration.replacementPolicy)) {
+    throw new Error(`Replacement policy ${configuration.replacementPolicy} is not supported.`);
+  }
+  return true;
+}
+
+function createStatistics(): DataCacheStatistics {
+  return {
+    hits: 0, misses: 0, perInstruction: new Map(), perMemoryLine: new Map(),
+  };
+}
+
+function countAccess(counts: Map<number, CacheAccessCounts>, key: number, hit: boolean) {
+  let entry = counts.get(key);
+  if (entry === undefined) {
+    entry = { hits: 0, misses: 0 };
+    counts.set(key, entry);
+  }
+  if (hit) {
+    entry.hits += 1;
+  } else {
+    entry.misses += 1;
+  }
+}
+
+function copyCounts(counts: Map<number, CacheAccessCounts>): Map<number, CacheAccessCounts> {
+  return new Map(Array.from(counts, ([key, entry]) => [key, { ...entry }]));
+}
+
+export class DataCache {
+  readonly configuration: DataCacheConfiguration;
+
+  private readonly lineShift: number;
+
+  private readonly numberOfSets: number;
+
+  private readonly ways: number;
+
+  // line number (address >>> lineShift) cached in each way, the ways of a set are adjacent
+  private readonly tags: Int32Array;
+
+  // time of the last use (LRU) or of the fill (FIFO) of each way
+  private readonly stamps: Uint32Array;
+
+  private clock = 0;
+
+  // xorshift state, the random policy evicts the same ways in every run of a program
+  private randomState = 0x2545F491;
+
+  private readonly buffer = new Uint32Array(bufferedAccesses * entriesPerAccess);
+
+  private bufferedEntries = 0;
+
+  private statistics = createStatistics();
+
+  // handed out until the statistics change, so reading unchanged statistics does not copy the counts again
+  private statisticsCopy?: DataCacheStatistics;
+
+  constructor(configuration: DataCacheConfiguration) {
+    validateDataCacheConfiguration(configuration);
+    this.configuration = { ...configuration };
+    this.lineShift = Math.log2(configuration.lineSizeInBytes);
+    this.ways = configuration.associativity;
+    this.numberOfSets = configuration.sizeInBytes / configuration.lineSizeInBytes / this.ways;
+    this.tags = new Int32Array(this.numberOfSets * this.ways).fill(emptyWay);
+    this.stamps = new Uint32Array(this.numberOfSets * this.ways);
+  }
+
+  record(address: number, sizeInBytes: number, instructionAddress: number) {
+    const { buffer } = this;
+    const entry = this.bufferedEntries;
+    buffer[entry] = address;
+    buffer[entry + 1] = sizeInBytes;
+    buffer[entry + 2] = instructionAddress;
+    this.bufferedEntries = entry + entriesPerAccess;
+    if (this.bufferedEntries === buffer.length) {
+      this.flush();
+    }
+  }
+
+  flush() {
+    const { buffer, statistics } = this;
+    const hitsBefore = statistics.hits;
+    const missesBefore = statistics.misses;
+    if (this.bufferedEntries > 0) {
+      this.statisticsCopy = undefined;
+    }
+    for (let entry = 0; entry < this.bufferedEntries; entry += entriesPerAccess) {
+      this.simulateAccess(buffer[entry], buffer[entry + 1], buffer[entry + 2]);
+    }
+    this.bufferedEntries = 0;
+    if (statistics.hits !== hitsBefore || statistics.misses !== missesBefore) {
+      countTrace('DataCache.hits', statistics.hits - hitsBefore);
+      countTrace('DataCache.misses', statistics.misses - missesBefore);
+    }
+  }
+
+  // simulates the buffered accesses first, the returned statistics are a copy which is shared until they change
+  getStatistics(): Readonly<DataCacheStatistics> {
+    this.flush();
+    if (this.statisticsCopy === undefined) {
+      const { hits, misses } = this.statistics;
+      this.statisticsCopy = {
+        hits,
+        misses,
+        perInstruction: copyCounts(this.statistics.perInstruction),
+        perMemoryLine: copyCounts(this.statistics.perMemoryLine),
+      };
+    }
+    return this.statisticsCopy;
+  }
+
+  reset() {
+    this.tags.fill(emptyWay);
+    this.stamps.fill(0);
+    this.clock = 0;
+    this.bufferedEntries = 0;
+    this.statistics = createStatistics();
+    this.statisticsCopy = undefined;
+  }
+
+  private simulateAccess(address: number, sizeInBytes: number, instructionAddress: number) {
+    const firstLine = address >>> this.lineShift;
+    const lastLine = (address + Math.max(sizeInBytes, 1) - 1) >>> this.lineShift;
+    for (let line = firstLine; line <= lastLine; line += 1) {
+      const hit = this.lookup(line);
+      const firstAccessedByte = Math.max(address, line * this.configuration.lineSizeInBytes);
+      const memoryLineAddress = firstAccessedByte - (firstAccessedByte % memoryLineLength);
+      if (hit) {
+        this.statistics.hits += 1;
+      } else {
+        this.statistics.misses += 1;
+      }
+      countAccess(this.statistics.perInstruction, instructionAddress, hit);
+      countAccess(this.statistics.perMemoryLine, memoryLineAddress, hit);
+    }
+  }
+
+  // Returns true on a hit, a miss fills the line into an empty way or the victim of the replacement policy
+  private lookup(line: number): boolean {
+    const { tags, stamps } = this;
+    const firstWay = (line % this.numberOfSets) * this.ways;
+    const endWay = firstWay + this.ways;
+    this.clock += 1;
+    for (let way = firstWay; way < endWay; way += 1) {
+      if (tags[way] === line) {
+        if (this.configuration.replacementPolicy === ReplacementPolicy.LRU) {
+          stamps[way] = this.clock;
+        }
+        return true;
+      }
+    }
+    const victim = this.selectVictim(firstWay, endWay);
+    tags[victim] = line;
+    stamps[victim] = this.clock;
+    return false;
+  }
+
+  private selectVictim(firstWay: number, endWay: number): number {
+    const { tags, stamps } = this;
+    for (let way = firstWay; way < endWay; way += 1) {
+      if (tags[way] === emptyWay) {
+        return way;
+      }
+    }
+    if (this.configuration.replacementPolicy === ReplacementPolicy.RANDOM) {
+      this.randomState ^= this.randomState << 13;
+      this.randomState ^= this.randomState >>> 17;
+      this.randomState ^= this.randomState << 5;
+      return firstWay + ((this.randomState >>> 0) % this.ways);
+    }
+    // LRU and FIFO evict the way with the oldest stamp, they only differ in when the stamp is updated
+    let victim = firstWay;
+    for (let way = firstWay + 1; way < endWay; way += 1) {
+      if (stamps[way] < stamps[victim]) {
+        victim = way;
+      }
+    }
+    return victim;
+  }
+}
+
+export const defaultDataCacheConfiguration: DataCacheConfiguration = {
+  sizeInBytes: 4096,
+  lineSizeInBytes: 64,
+  associativity: 4,
+  replacementPolicy: ReplacementPolicy.LRU,
+};
+
+// the cache of the simulated program, the memory hooks feed it while it is enabled
+let activeDataCache: DataCache | undefined;
+let sourceLineOfAddress = new Map<number, number>();
+
+export function getDataCache(): DataCache | undefined {
+  return activeDataCache;
+}
+
+/**
+ * Enables the cache model with an empty cache, or disables it without a configuration.
+ * The editor lines attribute the accesses of each instruction to its line in the source.
+ */
+export function setDataCache(configuration?: DataCacheConfiguration, editorLines?: Map<number, EditorLine>) {
+  activeDataCache = configuration !== undefined ? new DataCache(configuration) : undefined;
+  sourceLineOfAddress = new Map(Array.from(editorLines?.values() ?? [], (editorLine) => [
+    parseInt(editorLine.memoryAddressFrom.address, 16), editorLine.line,
+  ]));
+}
+
+export function getDataCacheStatistics(): Readonly<DataCacheStatistics> | undefined {
+  return activeDataCache?.getStatistics();
+}
+
+// Sums the counts of the instructions of each source line, instructions without a line are left out
+export function getCacheCountsPerSourceLine(statistics: DataCacheStatistics): Map<number, CacheAccessCounts> {
+  const perLine = new Map<number, CacheAccessCounts>();
+  statistics.perInstruction.forEach((counts, instructionAddress) => {
+    const line = sourceLineOfAddress.get(instructionAddress);
+    if (line !== undefined) {
+      const lineCounts = perLine.get(line) ?? { hits: 0, misses: 0 };
+      lineCounts.hits += counts.hits;
+      lineCounts.misses += counts.misses;
+      perLine.set(line, lineCounts);
+    }
+  });
+  return perLine;
+}
+
+export function getHitRate(counts: CacheAccessCounts): number {
+  const accesses = counts.hits + counts.misses;
+  return accesses === 0 ? 0 : counts.hits / accesses;
+}
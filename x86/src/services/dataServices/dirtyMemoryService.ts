@@ -0,0 +1,113 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import Program from '@/services/interfaces/Program';
+import MemoryData from '@/services/interfaces/MemoryData';
+import MemoryDataLine from '@/services/interfaces/MemoryDataLine';
+import MemoryDataChange from '@/services/interfaces/reverseDebugger/MemoryDataChange';
+import {
+  buildMemoryDataLinesOfPage,
+  getMemoryLineIndexOfAddress,
+  memoryLineLength,
+  readMemoryLine,
+} from '@/services/dataServices/memoryService';
+import { getResidentPages, memoryPageSizeInBytes } from '@/services/dataServices/memoryMapService';
+
+export function getEmptyMemoryDataChange(): MemoryDataChange {
+  return {
+    replacedLines: [],
+    insertedPages: [],
+  };
+}
+
+// Called by the memory write hook with every write, the set keeps this constant per line
+export function markMemoryLinesDirty(program: Program, address: number, size: number) {
+  const { dirtyMemoryLines } = program;
+  if (dirtyMemoryLines === undefined) {
+    return;
+  }
+  const lastAddress = address + Math.max(size, 1) - 1;
+  for (let line = address - (address % memoryLineLength); line <= lastAddress; line += memoryLineLength) {
+    dirtyMemoryLines.add(line);
+  }
+}
+
+// Pages become resident on access, their lines are inserted at the position of their address
+function insertNewResidentPages(memoryData: MemoryData, program: Program, change: MemoryDataChange) {
+  const lines = memoryData.memoryDataLines;
+  getResidentPages(program).forEach((page) => {
+    if (getMemoryLineIndexOfAddress(lines, page) < 0) {
+      const index = lines.findIndex((line) => parseInt(line.address.address, 16) > page);
+      lines.splice(index < 0 ? lines.length : index, 0, ...buildMemoryDataLinesOfPage(program, page));
+      change.insertedPages.push(page);
+    }
+  });
+}
+
+// Patches only the dirty lines of the memory data in place and records the replaced lines in change.
+// Lines keep their identity if not written, so only the changed lines are rendered again.
+export function updateDirtyMemoryLines(memoryData: MemoryData, program: Program, change: MemoryDataChange) {
+  const { dirtyMemoryLines } = program;
+  if (dirtyMemoryLines === undefined) {
+    return;
+  }
+  insertNewResidentPages(memoryData, program, change);
+  const lines = memoryData.memoryDataLines;
+  dirtyMemoryLines.forEach((lineAddress) => {
+    const index = getMemoryLineIndexOfAddress(lines, lineAddress);
+    if (index >= 0) {
+      change.replacedLines.push(lines[index]);
+      lines[index] = readMemoryLine(program, lineAddress);
+    }
+  });
+  dirtyMemoryLines.clear();
+}
+
+function countLinesOfPage(lines: Array<MemoryDataLine>, firstIndex: number, page: number): number {
+  let index = firstIndex;
+  while (index < lines.length && parseInt(lines[index].address.address, 16) < page + memoryPageSizeInBytes) {
+    index += 1;
+  }
+  return index - firstIndex;
+}
+
+// The inserted pages became resident with the reverted step, so they are removed from the resident pages as well
+export function revertMemoryDataChange(memoryData: MemoryData, change: MemoryDataChange, program: Program) {
+  const lines = memoryData.memoryDataLines;
+  for (let i = change.replacedLines.length - 1; i >= 0; i -= 1) {
+    const replacedLine = change.replacedLines[i];
+    const index = getMemoryLineIndexOfAddress(lines, parseInt(replacedLine.address.address, 16));
+    if (index >= 0) {
+      lines[index] = replacedLine;
+    }
+  }
+  change.insertedPages.forEach((page) => {
+    const index = getMemoryLineIndexOfAddress(lines, page);
+    if (index >= 0) {
+      lines.splice(index, countLinesOfPage(lines, index, page));
+    }
+    const residentIndex = program.residentPages?.indexOf(page) ?? -1;
+    if (residentIndex >= 0) {
+      program.residentPages?.splice(residentIndex, 1);
+    }
+  });
+}
@@ -29,6 +29,7 @@ import { getMemory } from '@/services/dataServices/memoryService';
 import Program from '@/services/interfaces/Program';
 import { buildByteInformation } from '@/services/dataServices/byteInformationService';
 import { getEmptyAccessedElements } from '@/services/dataServices/accessedElementsService';
+import { createChangeHistoryLog } from '@/services/dataServices/changeHistoryService';
 import Instruction from '@/services/interfaces/Instruction';
 import { dataStringsToCurrentInstructionBytes } from '@/services/dataServices/byteService';
 import getInstructionPointer from '@/services/dataServices/instructionPointerService';
@@ -66,6 +67,6 @@ export default function getStateWithEmptyInstruction(program: Program): State {
     instructionPointer,
     currentAccessedElements: getEmptyAccessedElements(),
     byteInformation: buildByteInformation(program),
-    changeHistory: [],
+    changeHistory: createChangeHistoryLog(),
   };
 }
@@ -0,0 +1,68 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import Program from '@/services/interfaces/Program';
+import Instruction from '@/services/interfaces/Instruction';
+import ResolvedMemoryAccess from '@/services/interfaces/ResolvedMemoryAccess';
+import { ReadWriteAccessMode } from '@/services/interfaces/InstructionOperands';
+import { RegisterID } from '@/services/emulator/emulatorEnums';
+import { byteArrayToUInt8Array } from '@/services/dataServices/byteService';
+
+// registers needed to resolve base, index and stack addresses of memory operands
+const addressRegisters: Array<RegisterID> = [
+  RegisterID.RAX, RegisterID.RBX, RegisterID.RCX, RegisterID.RDX,
+  RegisterID.RSI, RegisterID.RDI, RegisterID.RBP, RegisterID.RSP,
+  RegisterID.R8, RegisterID.R9, RegisterID.R10, RegisterID.R11,
+  RegisterID.R12, RegisterID.R13, RegisterID.R14, RegisterID.R15,
+  RegisterID.RIP,
+];
+
+function readAddressRegisters(program: Program): Map<RegisterID, Uint8Array> {
+  const registerValues = new Map<RegisterID, Uint8Array>();
+  addressRegisters.forEach((registerId) => {
+    registerValues.set(registerId, program.ucInstance.register_read(registerId));
+  });
+  return registerValues;
+}
+
+/**
+ * Resolves the memory reads and writes of the instruction before it is executed, based on the current register values.
+ * Returns undefined if the Capstone library does not provide resolve_memory_operands, the memory hooks have to be used then.
+ */
+export default function predictMemoryAccesses(program: Program, instruction: Instruction): Array<ResolvedMemoryAccess> | undefined {
+  if (!program.disassemblerInstance.hasMemoryOperandResolution()) {
+    return undefined;
+  }
+  return program.disassemblerInstance.resolveMemoryAccesses(
+    byteArrayToUInt8Array(instruction.content),
+    parseInt(instruction.address.address, 16),
+    readAddressRegisters(program),
+  );
+}
+
+export function getPredictedReadAccesses(accesses: Array<ResolvedMemoryAccess>): Array<ResolvedMemoryAccess> {
+  return accesses.filter((access) => access.access !== ReadWriteAccessMode.WRITE);
+}
+
+export function getPredictedWriteAccesses(accesses: Array<ResolvedMemoryAccess>): Array<ResolvedMemoryAccess> {
+  return accesses.filter((access) => access.access !== ReadWriteAccessMode.READ);
+}
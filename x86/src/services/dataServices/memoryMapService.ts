@@ -0,0 +1,252 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import MemoryMap, { MemoryRegion } from '@/services/interfaces/MemoryMap';
+import Program from '@/services/interfaces/Program';
+import Unicorn from '@/services/emulator/emulatorService';
+import { eUC } from '@/services/emulator/emulatorEnums';
+
+/* eslint no-bitwise: 0 */
+
+export const memoryPageSizeInBytes = 0x1000;
+// uc_mem_map is called with the lower 32 bit of the address only
+export const highestMemoryAddress = 0xFFFFFFFF;
+
+export const defaultMemoryMap: MemoryMap = {
+  regions: [{
+    name: 'memory',
+    address: 0x0000,
+    sizeInBytes: 4 * 1024,
+    permissions: eUC.PROT_ALL,
+  }],
+  codeAddress: 0x0000,
+  stackPointerAddress: 0x0300,
+};
+
+// Separate code, data, heap and stack regions for the advanced courses
+export const sectionedMemoryMap: MemoryMap = {
+  regions: [{
+    name: 'code',
+    address: 0x00010000,
+    sizeInBytes: 64 * 1024,
+    permissions: eUC.PROT_READ | eUC.PROT_EXEC,
+  }, {
+    name: 'data',
+    address: 0x00100000,
+    sizeInBytes: 1024 * 1024,
+    permissions: eUC.PROT_READ | eUC.PROT_WRITE,
+  }, {
+    name: 'heap',
+    address: 0x00200000,
+    sizeInBytes: 4 * 1024 * 1024,
+    permissions: eUC.PROT_READ | eUC.PROT_WRITE,
+  }, {
+    name: 'stack',
+    address: 0x00800000,
+    sizeInBytes: 1024 * 1024,
+    permissions: eUC.PROT_READ | eUC.PROT_WRITE,
+  }],
+  codeAddress: 0x00010000,
+  stackPointerAddress: 0x00900000 - 0x100,
+};
+
+export interface SelectableMemoryMap {
+  name: string;
+  label: string;
+  memoryMap: MemoryMap;
+}
+
+// Memory maps offered by the editor, the share code stores the index of the selected one
+export const selectableMemoryMaps: Array<SelectableMemoryMap> = [
+  { name: 'default', label: '4 KB', memoryMap: defaultMemoryMap },
+  { name: 'sectioned', label: 'Code, Data, Heap, Stack', memoryMap: sectionedMemoryMap },
+];
+
+export function getMemoryMapByName(name?: string): MemoryMap {
+  return selectableMemoryMaps.find((selectable) => selectable.name === name)?.memoryMap ?? defaultMemoryMap;
+}
+
+// Address given by the org directive of an assembly source, nasm assembles a source without one for address 0
+export function getOriginOfSource(source: string): number {
+  const match = /^\s*\[?\s*org\s+([0-9a-f]+h|0x[0-9a-f]+|\d+)\s*\]?\s*(;.*)?$/im.exec(source);
+  if (match === null) {
+    return 0;
+  }
+  const origin = match[1].toLowerCase();
+  return origin.endsWith('h') ? parseInt(origin.slice(0, -1), 16) : Number(origin);
+}
+
+// Absolute addresses of the machine code only match the memory map if it is loaded at the address it was assembled for
+export function getOriginMismatch(source: string, memoryMapName: string): string | undefined {
+  const { codeAddress } = getMemoryMapByName(memoryMapName);
+  const origin = getOriginOfSource(source);
+  if (origin === codeAddress) {
+    return undefined;
+  }
+  return `The program is assembled for address 0x${origin.toString(16)}, but this memory map loads it at 0x${codeAddress.toString(16)}. `
+    + `Start the program with "org 0x${codeAddress.toString(16)}" or choose another memory map.`;
+}
+
+function isPageAligned(value: number): boolean {
+  return value % memoryPageSizeInBytes === 0;
+}
+
+export function getPageAddress(address: number): number {
+  return address - (address % memoryPageSizeInBytes);
+}
+
+export function getMemoryRegionOfAddress(regions: Array<MemoryRegion>, address: number): MemoryRegion | undefined {
+  return regions.find((region) => address >= region.address && address < region.address + region.sizeInBytes);
+}
+
+function validateMemoryRegion(region: MemoryRegion) {
+  if (region.name === '') {
+    throw new Error('Memory Region has no name.');
+  }
+  if (region.address < 0 || !isPageAligned(region.address)) {
+    throw new Error(`Address ${region.address.toString(16)} of Memory Region ${region.name} is not valid.`);
+  }
+  if (region.sizeInBytes <= 0 || !isPageAligned(region.sizeInBytes)
+    || region.address + region.sizeInBytes - 1 > highestMemoryAddress) {
+    throw new Error(`Size ${region.sizeInBytes} of Memory Region ${region.name} is not valid.`);
+  }
+}
+
+export function validateMemoryMap(memoryMap: MemoryMap) {
+  if (memoryMap.regions.length === 0) {
+    throw new Error('Memory Map has no regions.');
+  }
+  const sortedRegions = [...memoryMap.regions].sort((a, b) => a.address - b.address);
+  sortedRegions.forEach((region, index) => {
+    validateMemoryRegion(region);
+    if (sortedRegions.findIndex((other) => other.name === region.name) !== index) {
+      throw new Error(`Memory Region ${region.name} is defined twice.`);
+    }
+    if (index > 0) {
+      const previousRegion = sortedRegions[index - 1];
+      if (previousRegion.address + previousRegion.sizeInBytes > region.address) {
+        throw new Error(`Memory Region ${region.name} overlaps ${previousRegion.name}.`);
+      }
+    }
+  });
+  const codeRegion = getMemoryRegionOfAddress(memoryMap.regions, memoryMap.codeAddress);
+  if (codeRegion === undefined || (codeRegion.permissions & eUC.PROT_EXEC) === 0) {
+    throw new Error(`Code Address ${memoryMap.codeAddress.toString(16)} is not in an executable Memory Region.`);
+  }
+  if (getMemoryRegionOfAddress(memoryMap.regions, memoryMap.stackPointerAddress) === undefined) {
+    throw new Error(`Stack Pointer ${memoryMap.stackPointerAddress.toString(16)} is not in a Memory Region.`);
+  }
+  return true;
+}
+
+export function mapMemoryRegions(ucInstance: Unicorn, memoryMap: MemoryMap) {
+  memoryMap.regions.forEach((region) => {
+    ucInstance.memory_map(region.address, region.sizeInBytes, region.permissions);
+  });
+}
+
+// Programs without a memory map show their whole memory window
+export function getMemoryRegions(program: Program): Array<MemoryRegion> {
+  if (program.memoryMap !== undefined) {
+    return program.memoryMap.regions;
+  }
+  return [{
+    name: 'memory',
+    address: program.memoryAddress,
+    sizeInBytes: program.memorySizeInBytes,
+    permissions: eUC.PROT_ALL,
+  }];
+}
+
+export function getEndOfMemoryRegion(program: Program, address: number): number {
+  const region = getMemoryRegionOfAddress(getMemoryRegions(program), address);
+  if (region !== undefined) {
+    return region.address + region.sizeInBytes;
+  }
+  if (program.memoryMap === undefined) {
+    return program.memoryAddress + program.memorySizeInBytes;
+  }
+  throw new RangeError(`Address ${address.toString(16)} is not mapped.`);
+}
+
+// Returns the start addresses of all mapped pages touched by an access of size bytes at address.
+function getPagesOfAccess(regions: Array<MemoryRegion>, address: number, size: number): Array<number> {
+  const pages: Array<number> = [];
+  const lastAddress = address + Math.max(size, 1) - 1;
+  for (let page = getPageAddress(address); page <= lastAddress; page += memoryPageSizeInBytes) {
+    if (getMemoryRegionOfAddress(regions, page) !== undefined) {
+      pages.push(page);
+    }
+  }
+  return pages;
+}
+
+// Index of the first page not below page in the sorted pages
+function findPageIndex(pages: Array<number>, page: number): number {
+  let low = 0;
+  let high = pages.length;
+  while (low < high) {
+    const middle = (low + high) >>> 1;
+    if (pages[middle] < page) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+// residentPages is kept sorted, only the pages in it are read from the emulator and shown.
+// Called by the memory hooks with every access, an already resident page is found by binary search.
+export function addResidentPages(residentPages: Array<number>, regions: Array<MemoryRegion>, address: number, size: number) {
+  getPagesOfAccess(regions, address, size).forEach((page) => {
+    const index = findPageIndex(residentPages, page);
+    if (residentPages[index] !== page) {
+      residentPages.splice(index, 0, page);
+    }
+  });
+}
+
+export function getInitialResidentPages(memoryMap: MemoryMap, codeSizeInBytes: number): Array<number> {
+  const residentPages: Array<number> = [];
+  addResidentPages(residentPages, memoryMap.regions, memoryMap.codeAddress, codeSizeInBytes);
+  addResidentPages(residentPages, memoryMap.regions, memoryMap.stackPointerAddress, 1);
+  return residentPages;
+}
+
+// Start addresses of the pages to show, all pages of the memory window for programs without a memory map
+export function getResidentPages(program: Program): Array<number> {
+  if (program.memoryMap !== undefined && program.residentPages !== undefined) {
+    return program.residentPages;
+  }
+  const pages: Array<number> = [];
+  for (let page = program.memoryAddress; page < program.memoryAddress + program.memorySizeInBytes; page += memoryPageSizeInBytes) {
+    pages.push(page);
+  }
+  return pages;
+}
+
+export function markAccessedPagesResident(program: Program, address: number, size: number) {
+  if (program.memoryMap !== undefined && program.residentPages !== undefined) {
+    addResidentPages(program.residentPages, program.memoryMap.regions, address, size);
+  }
+}
@@ -0,0 +1,65 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import Program from '@/services/interfaces/Program';
+import { MemoryPage } from '@/services/interfaces/SimulatorSession';
+import { MemoryRegion } from '@/services/interfaces/MemoryMap';
+import { valueToBytes } from '@/services/helper/memoryScanHelper';
+
+export type ScanValueSize = 1 | 2 | 4 | 8;
+
+// programs without a memory map have a single region, the memory window
+function getMappedRegions(program: Program): Array<Pick<MemoryRegion, 'address' | 'sizeInBytes'>> {
+  if (program.memoryMap !== undefined) {
+    return [...program.memoryMap.regions].sort((a, b) => a.address - b.address);
+  }
+  return [{ address: program.memoryAddress, sizeInBytes: program.memorySizeInBytes }];
+}
+
+function concatResults(results: Array<Uint32Array>): Uint32Array {
+  const concatenated = new Uint32Array(results.reduce((length, result) => length + result.length, 0));
+  results.reduce((offset, result) => {
+    concatenated.set(result, offset);
+    return offset + result.length;
+  }, 0);
+  return concatenated;
+}
+
+export function takeMemorySnapshot(program: Program, address: number, sizeInBytes: number): MemoryPage {
+  return { address, content: program.ucInstance.memory_read(address, sizeInBytes) };
+}
+
+// Pairs of start and end address (exclusive) of the bytes which changed since the snapshot was taken
+export function diffMemorySnapshot(program: Program, snapshot: MemoryPage): Uint32Array {
+  return program.ucInstance.memory_diff(snapshot.address, snapshot.content);
+}
+
+// Addresses of the pattern in all mapped regions, matches crossing two regions are not found
+export function searchMappedMemory(program: Program, pattern: Uint8Array, alignment = 1): Uint32Array {
+  return concatResults(getMappedRegions(program)
+    .map((region) => program.ucInstance.memory_search(region.address, region.sizeInBytes, pattern, alignment)));
+}
+
+// Values are searched at addresses aligned to their size
+export function searchMappedMemoryValue(program: Program, value: bigint, sizeInBytes: ScanValueSize): Uint32Array {
+  return searchMappedMemory(program, valueToBytes(value, sizeInBytes), sizeInBytes);
+}
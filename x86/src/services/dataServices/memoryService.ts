@@ -34,12 +34,18 @@ import fillAddress, {
 } from '@/services/helper/htmlIdService';
 import { MemoryHookInformation } from '@/services/interfaces/AccessedElements';
 import Unicorn from '@/services/emulator/emulatorService';
+import {
+  getEndOfMemoryRegion,
+  getResidentPages,
+  memoryPageSizeInBytes,
+} from '@/services/dataServices/memoryMapService';
+
+export const memoryLineLength = 16;
 
 function bytesToMemoryLines(bytes: Array<Byte>): Array<MemoryDataLine> {
   const memoryLines: Array<MemoryDataLine> = [];
   if (bytes.length > 0) {
     while (bytes.length > 0) {
-      const memoryLineLength = 16;
       memoryLines.push({
         address: { address: bytes[0].locationId },
         dataBytes: bytes.splice(0, memoryLineLength),
@@ -56,19 +62,22 @@ export function uInt8ArrayToMemoryBytes(memoryContent: Uint8Array, startAddress:
   return dataStringsToBytes(memoryContentStringArray, startAddress);
 }
 
-function buildMemoryData(memoryContent: Uint8Array, startAddress: string): MemoryData {
-  const startAddressHex = parseInt(startAddress, 16);
-  const memoryBytes = uInt8ArrayToMemoryBytes(memoryContent, startAddressHex);
-  return {
-    memoryDataLines: bytesToMemoryLines(memoryBytes),
-  };
+export function buildMemoryDataLinesOfPage(program: Program, pageAddress: number): Array<MemoryDataLine> {
+  const endOfMemory = program.memoryAddress + program.memorySizeInBytes;
+  const pageSize = Math.min(memoryPageSizeInBytes, endOfMemory - pageAddress);
+  const memoryContent = program.ucInstance.memory_read(pageAddress, pageSize);
+  return bytesToMemoryLines(uInt8ArrayToMemoryBytes(memoryContent, pageAddress));
 }
 
+// Only resident pages are read, so the cost does not grow with the size of the mapped memory
 export function getMemory(program: Program): MemoryData {
   let memory: MemoryData;
   try {
-    const memoryData = program.ucInstance.memory_read(program.memoryAddress, program.memorySizeInBytes);
-    memory = buildMemoryData(memoryData, program.memoryAddress.toString(16));
+    const memoryDataLines: Array<MemoryDataLine> = [];
+    getResidentPages(program).forEach((pageAddress) => {
+      memoryDataLines.push(...buildMemoryDataLinesOfPage(program, pageAddress));
+    });
+    memory = { memoryDataLines };
   } catch (err: unknown) {
     if (err instanceof Error) {
       throw new Error(`Memory could not be created: ${err.message}`);
@@ -79,6 +88,33 @@ export function getMemory(program: Program): MemoryData {
   return memory;
 }
 
+// Binary search, the memory lines are sorted by address
+export function getMemoryLineIndexOfAddress(memoryLines: Array<MemoryDataLine>, address: number): number {
+  let low = 0;
+  let high = memoryLines.length - 1;
+  while (low <= high) {
+    const middle = Math.floor((low + high) / 2);
+    const lineAddress = parseInt(memoryLines[middle].address.address, 16);
+    if (address < lineAddress) {
+      high = middle - 1;
+    } else if (address >= lineAddress + memoryLineLength) {
+      low = middle + 1;
+    } else {
+      return middle;
+    }
+  }
+  return -1;
+}
+
+export function readMemoryLine(program: Program, lineAddress: number): MemoryDataLine {
+  const lineSize = Math.min(memoryLineLength, getEndOfMemoryRegion(program, lineAddress) - lineAddress);
+  const memoryContent = program.ucInstance.memory_read(lineAddress, lineSize);
+  return {
+    address: fillAddress(lineAddress),
+    dataBytes: uInt8ArrayToMemoryBytes(memoryContent, lineAddress),
+  };
+}
+
 function convertSigned32BitToUnsigned(negativeDecimal: number): number {
   const overFlow = 0x100000000;
   return negativeDecimal + overFlow;
@@ -100,8 +136,8 @@ function createDataStringFromHookValues(valueLo: number, valueHi: number, size:
 
 export function readNextInstructionBytesFromMemory(instructionAddressHex: string, program: Program) {
   const startAddress: number = parseInt(instructionAddressHex, 16);
-  const endOfMemory = program.memoryAddress + program.memorySizeInBytes;
-  const bytesToRead = endOfMemory - startAddress + 1;
+  const endOfMemory = getEndOfMemoryRegion(program, startAddress);
+  const bytesToRead = endOfMemory - startAddress;
   const bytes = bytesToRead >= 8 ? 8 : bytesToRead;
   return program.ucInstance.memory_read(startAddress, bytes);
 }
@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { RegisterID } from '@/services/emulator/emulatorEnums';
+
+/* eslint no-bitwise: 0 */
+
+// Set of registers as bitmask, bit n of the mask stands for the register with RegisterID n.
+// Matches the registers_read_mask and registers_modified_mask printed by print_insn_detail in cs.c.
+export type RegisterMask = Uint32Array;
+
+const registerMaskWords = Math.ceil(RegisterID.ENDING / 32);
+
+export function createRegisterMask(registerIds: Array<RegisterID> = []): RegisterMask {
+  const mask = new Uint32Array(registerMaskWords);
+  registerIds.forEach((registerId) => {
+    mask[registerId >>> 5] |= 1 << (registerId & 31);
+  });
+  return mask;
+}
+
+export function createRegisterMaskFromWords(words: Array<number>): RegisterMask {
+  const mask = new Uint32Array(registerMaskWords);
+  mask.set(words.slice(0, registerMaskWords));
+  return mask;
+}
+
+export function registerMaskContains(mask: RegisterMask, registerId: RegisterID): boolean {
+  return (mask[registerId >>> 5] & (1 << (registerId & 31))) !== 0;
+}
+
+// returns true if a register of mask is not contained in otherMask
+export function registerMaskHasRegistersNotIn(mask: RegisterMask, otherMask: RegisterMask): boolean {
+  for (let word = 0; word < mask.length; word += 1) {
+    if ((mask[word] & ~otherMask[word]) !== 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+export function getRegisterIdsFromMask(mask: RegisterMask): Array<RegisterID> {
+  const registerIds: Array<RegisterID> = [];
+  mask.forEach((word, wordIndex) => {
+    let bits = word;
+    while (bits !== 0) {
+      const bit = 31 - Math.clz32(bits & -bits);
+      registerIds.push(wordIndex * 32 + bit);
+      bits &= bits - 1;
+    }
+  });
+  return registerIds;
+}
@@ -0,0 +1,121 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { markRaw } from 'vue';
+import { isEqual } from 'lodash';
+import State from '@/services/interfaces/State';
+import ChangeHistoryLog from '@/services/interfaces/ChangeHistoryLog';
+import StateSnapshot from '@/services/interfaces/StateSnapshot';
+import MemoryData from '@/services/interfaces/MemoryData';
+import ByteInformation, { PointerInformation } from '@/services/interfaces/ByteInformation';
+import ByteSet from '@/services/interfaces/ByteSet';
+import { byteSetsEqual, cloneByteSet } from '@/services/dataServices/byteSetService';
+import { shareChangeHistory } from '@/services/dataServices/changeHistoryService';
+
+const stateSlices: Array<keyof State> = [
+  'memoryData',
+  'registers',
+  'currentInstruction',
+  'instructionPointer',
+  'flags',
+  'currentAccessedElements',
+  'byteInformation',
+  'changeHistory',
+];
+
+// byte sets and pointer information are changed in place, so the snapshot keeps its own copies
+function snapshotByteSet(byteSet: ByteSet | undefined, previous: ByteSet | undefined): ByteSet | undefined {
+  if (byteSet === undefined) {
+    return undefined;
+  }
+  return previous !== undefined && byteSetsEqual(previous, byteSet) ? previous : cloneByteSet(byteSet);
+}
+
+function snapshotPointerInformation(pointerInformation: PointerInformation, previous: PointerInformation | undefined): PointerInformation {
+  return previous !== undefined && isEqual(previous, pointerInformation) ? previous : { ...pointerInformation };
+}
+
+function snapshotByteInformation(byteInformation: ByteInformation, previous: ByteInformation | undefined): ByteInformation {
+  const snapshot: ByteInformation = {
+    instructionPointerInformation: snapshotPointerInformation(byteInformation.instructionPointerInformation, previous?.instructionPointerInformation),
+    stackPointerInformation: snapshotPointerInformation(byteInformation.stackPointerInformation, previous?.stackPointerInformation),
+    basePointerInformation: snapshotPointerInformation(byteInformation.basePointerInformation, previous?.basePointerInformation),
+    usedBytes: snapshotByteSet(byteInformation.usedBytes, previous?.usedBytes) as ByteSet,
+    evenInstructionBytes: snapshotByteSet(byteInformation.evenInstructionBytes, previous?.evenInstructionBytes),
+    unevenInstructionBytes: snapshotByteSet(byteInformation.unevenInstructionBytes, previous?.unevenInstructionBytes),
+    code: byteInformation.code,
+  };
+  if (previous !== undefined && (Object.keys(snapshot) as Array<keyof ByteInformation>)
+    .every((key) => snapshot[key] === previous[key])) {
+    return previous;
+  }
+  return snapshot;
+}
+
+// the snapshot shares the storage of the log and keeps its counts, unchanged logs keep the previous snapshot
+function snapshotChangeHistory(changeHistory: ChangeHistoryLog, previous: ChangeHistoryLog | undefined): ChangeHistoryLog {
+  if (previous !== undefined && (Object.keys(changeHistory) as Array<keyof ChangeHistoryLog>)
+    .every((key) => previous[key] === changeHistory[key])) {
+    return previous;
+  }
+  return shareChangeHistory(changeHistory);
+}
+
+// memory lines are patched in place, the snapshot keeps its own list, which is only replaced if a line was replaced
+function snapshotMemoryData(memoryData: MemoryData, previous: MemoryData | undefined): MemoryData {
+  const lines = memoryData.memoryDataLines;
+  if (previous !== undefined && previous.memoryDataLines.length === lines.length
+    && previous.memoryDataLines.every((line, index) => line === lines[index])) {
+    return previous;
+  }
+  return { memoryDataLines: lines.slice() };
+}
+
+function snapshotSlice(state: State, slice: keyof State, previous: State | undefined): State[keyof State] {
+  switch (slice) {
+    case 'byteInformation':
+      return snapshotByteInformation(state.byteInformation, previous?.byteInformation);
+    case 'changeHistory':
+      return snapshotChangeHistory(state.changeHistory, previous?.changeHistory);
+    case 'memoryData':
+      return snapshotMemoryData(state.memoryData, previous?.memoryData);
+    default:
+      // all other slices are replaced as a whole by the step controller
+      return state[slice];
+  }
+}
+
+export function createStateSnapshot(state: State, previous?: StateSnapshot): StateSnapshot {
+  const snapshotState: Partial<State> = {};
+  stateSlices.forEach((slice) => {
+    const sliceValue = snapshotSlice(state, slice, previous?.state);
+    // new slices are marked raw as well, the unchanged ones were marked with the previous snapshot
+    if (sliceValue !== previous?.state[slice]) {
+      markRaw(sliceValue);
+    }
+    Object.assign(snapshotState, { [slice]: sliceValue });
+  });
+  // snapshots are never made reactive, the components are updated by replacing the whole snapshot
+  return Object.freeze(markRaw({
+    state: Object.freeze(markRaw(snapshotState as State)),
+  }));
+}
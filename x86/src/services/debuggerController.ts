@@ -26,6 +26,10 @@ import Breakpoint from './interfaces/debugger/Breakpoint';
 import evaluateConditionalString from './debuggerService/expressionParser/expressionParser';
 import Watchpoint from './interfaces/debugger/Watchpoint';
 import { isBreakpoint } from './debuggerService/conditionalTypesService';
+import TurboPlayback from './interfaces/debugger/TurboPlayback';
+import CpuCycleStep, { Step } from './interfaces/CpuCycleStep';
+import { traceSpan } from './helper/traceService';
+import { RunToReturnCommand, RunToReturnResult } from './interfaces/RunToReturn';
 
 export default class DebuggerController {
   private editorLines: Map<number, EditorLine>;
@@ -38,6 +42,16 @@ export default class DebuggerController {
 
   private breakForWatchpoint: boolean;
 
+  private turboPlayback?: TurboPlayback;
+
+  // counted whenever a run reaches the start of an instruction
+  private instructionsSinceCommit = 0;
+
+  private lastCommitTime = 0;
+
+  // the last step over, step out or run to return stopped before the return was reached
+  private runToReturnIncomplete = false;
+
   constructor(controller: StepController, editorLines: Map<number, EditorLine>) {
     this.controller = controller;
 
@@ -51,49 +65,145 @@ export default class DebuggerController {
     this.breakForWatchpoint = value;
   }
 
+  // Without turbo playback the simulator is only updated at the end of a run
+  public setTurboPlayback(turboPlayback?: TurboPlayback) {
+    this.turboPlayback = turboPlayback;
+  }
+
+  private startRun() {
+    const animations = this.controller.turnOfAllAnimations();
+    if (this.turboPlayback) {
+      this.instructionsSinceCommit = 0;
+      this.lastCommitTime = performance.now();
+    }
+    return animations;
+  }
+
+  private endRun(animations: Array<CpuCycleStep>) {
+    this.controller.setSteps(animations);
+  }
+
+  private async commitRunProgress() {
+    if (this.turboPlayback) {
+      if (this.controller.getCurrentStep().numberInCycleSequence === Step.GET_INSTRUCTION) {
+        this.instructionsSinceCommit += 1;
+      }
+      const timeSinceCommit = performance.now() - this.lastCommitTime;
+      if (this.instructionsSinceCommit >= this.turboPlayback.instructionsPerCommit || timeSinceCommit >= this.turboPlayback.frameBudgetInMs) {
+        await this.turboPlayback.commit();
+        this.instructionsSinceCommit = 0;
+        this.lastCommitTime = performance.now();
+      }
+    }
+  }
+
+  private runNextStep = async () => {
+    const { watchpointsHold } = await this.nextStepWithWatchpointCheck();
+    this.setBreakForWatchpoint(watchpointsHold);
+    await this.commitRunProgress();
+  }
+
+  private runPreviousStep = async () => {
+    const watchpointsHold = await this.previousStepWithWatchpointCheck();
+    this.setBreakForWatchpoint(watchpointsHold);
+    await this.commitRunProgress();
+  }
+
   // Helper Method: Needed because of RIP increase in Step 2
   public async stepForwardToStartOfNextInstruction() {
     while (!this.breakForWatchpoint && this.controller.getCurrentStep().numberInCycleSequence !== 1) {
-      await this.nextStepWithWatchpointCheck().then(({ watchpointsHold }) => this.setBreakForWatchpoint(watchpointsHold));
+      await this.runNextStep();
     }
     this.setBreakForWatchpoint(false);
   }
 
   public async runToStartOfProgram() {
-    const animations = this.controller.turnOfAllAnimations();
+    const animations = this.startRun();
 
     while (!this.breakForWatchpoint && !this.controller.isInitialStep()) {
-      await this.previousStepWithWatchpointCheck().then((watchpointsHold: boolean) => this.setBreakForWatchpoint(watchpointsHold));
+      await this.runPreviousStep();
     }
 
     this.setBreakForWatchpoint(false);
-    this.controller.setSteps(animations);
+    this.endRun(animations);
   }
 
   public async runToEndOfProgram() {
-    const animations = this.controller.turnOfAllAnimations();
+    const animations = this.startRun();
 
     while (!this.breakForWatchpoint && !this.controller.isLastStep()) {
-      await this.nextStepWithWatchpointCheck().then(({ watchpointsHold }) => this.setBreakForWatchpoint(watchpointsHold));
+      await this.runNextStep();
     }
 
     this.setBreakForWatchpoint(false);
-    this.controller.setSteps(animations);
+    this.endRun(animations);
+  }
+
+  private async finishCurrentInstruction() {
+    while (this.controller.getCurrentStep().numberInCycleSequence !== Step.GET_INSTRUCTION) {
+      await this.controller.nextStep();
+    }
   }
 
+  // Calls are executed in one emulator run, breakpoints and watchpoints are only checked after the run
+  private async runCall(command: RunToReturnCommand) {
+    const animations = this.startRun();
+    let runCommand: RunToReturnCommand | undefined = command;
+    this.runToReturnIncomplete = false;
+
+    try {
+      if (this.controller.getCurrentStep().numberInCycleSequence !== Step.GET_INSTRUCTION) {
+        // the emulator already executed the current instruction, a call in progress is stepped over by leaving its callee
+        const callInProgress = this.controller.isCallInProgress();
+        await this.finishCurrentInstruction();
+        if (command === RunToReturnCommand.STEP_OVER) {
+          runCommand = callInProgress ? RunToReturnCommand.STEP_OUT : undefined;
+        }
+      }
+
+      if (runCommand !== undefined && !this.controller.isLastStep()) {
+        const result = await this.controller.runToReturn(runCommand);
+        this.runToReturnIncomplete = result === RunToReturnResult.INCOMPLETE;
+        // stepping over or out of any other instruction executes it, a return is left by executing it
+        if (result === RunToReturnResult.NOT_APPLICABLE && runCommand !== RunToReturnCommand.RUN_TO_RETURN) {
+          await this.controller.nextStep();
+          await this.finishCurrentInstruction();
+        }
+      }
+      // triggers the events of the watchpoints which hold after the run
+      this.checkWatchpoints();
+    } catch (e) {
+      /* eslint no-console: ["error", { allow: ["warn"] }] */
+      console.warn(e);
+    }
+
+    this.endRun(animations);
+    return !this.controller.isLastStep();
+  }
+
+  public isRunToReturnIncomplete(): boolean {
+    return this.runToReturnIncomplete;
+  }
+
+  public stepOver = async () => this.runCall(RunToReturnCommand.STEP_OVER);
+
+  public stepOut = async () => this.runCall(RunToReturnCommand.STEP_OUT);
+
+  public runToReturn = async () => this.runCall(RunToReturnCommand.RUN_TO_RETURN);
+
   // backward: false = forwards, backward: true = backwards
   public async runUntil(breakpoint: Breakpoint, backward = false) {
     if (this.editorLines.size >= breakpoint.line) {
-      const animations = this.controller.turnOfAllAnimations();
+      const animations = this.startRun();
 
       const requestedLine = this.editorLines.get(breakpoint.line);
 
       if (requestedLine !== undefined) {
         while ((!this.breakForWatchpoint) && this.controller.getState().instructionPointer.address.address !== requestedLine.memoryAddressFrom.address) {
           if (!backward) {
-            await this.nextStepWithWatchpointCheck().then(({ watchpointsHold }) => this.setBreakForWatchpoint(watchpointsHold));
+            await this.runNextStep();
           } else {
-            await this.previousStepWithWatchpointCheck().then((watchpointsHold: boolean) => this.setBreakForWatchpoint(watchpointsHold));
+            await this.runPreviousStep();
           }
         }
 
@@ -103,7 +213,7 @@ export default class DebuggerController {
 
         this.setBreakForWatchpoint(false);
       }
-      this.controller.setSteps(animations);
+      this.endRun(animations);
     }
     return !this.controller.isLastStep();
   }
@@ -154,7 +264,8 @@ export default class DebuggerController {
   private conditionDoesHold = (selectedObject: Breakpoint | Watchpoint) => {
     let result = true;
     if (selectedObject.condition) {
-      result = evaluateConditionalString(this.controller.getState(), selectedObject.condition.value);
+      const conditionValue = selectedObject.condition.value;
+      result = traceSpan('DebuggerController.conditionDoesHold', () => evaluateConditionalString(this.controller.getState(), conditionValue));
       if (result) {
         if (isBreakpoint(selectedObject)) {
           window.dispatchEvent(new CustomEvent<Breakpoint>('triggerBreakpoint', { detail: selectedObject }));
@@ -260,6 +371,10 @@ export default class DebuggerController {
     this.watchpoints = this.watchpoints.filter((wp) => wp.condition.value !== watchpoint.condition.value);
   }
 
+  public getEditorLines() {
+    return this.editorLines;
+  }
+
   public getWatchpoints() {
     return this.watchpoints;
   }
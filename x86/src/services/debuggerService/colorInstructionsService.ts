@@ -21,21 +21,21 @@
  */
 
 import State from '@/services/interfaces/State';
-import addHexAndIntToStringService from '@/services/debuggerService/addHexAndIntToStringService';
 import EditorLine from '@/services/interfaces/codeEditor/EditorLine';
+import { addByteToSet, createByteSet } from '@/services/dataServices/byteSetService';
 
 export default async function colorInstructionsService(state: State, editorLines: Map<number, EditorLine>) {
-  const evenInstructions: string[] = [];
-  const unevenInstructions: string[] = [];
+  const evenInstructions = createByteSet();
+  const unevenInstructions = createByteSet();
 
   let isEven = true; // 0 is even
   editorLines.forEach((line) => {
     for (let i = 0; i < line.instruction.length; i += 1) {
-      const byte = addHexAndIntToStringService(line.memoryAddressFrom.address, i);
+      const byte = parseInt(line.memoryAddressFrom.address, 16) + i;
       if (isEven) {
-        evenInstructions.push(byte);
+        addByteToSet(evenInstructions, byte);
       } else {
-        unevenInstructions.push(byte);
+        addByteToSet(unevenInstructions, byte);
       }
     }
     isEven = !isEven;
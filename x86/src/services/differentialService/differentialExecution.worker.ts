@@ -0,0 +1,44 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import runDifferentialExecution from '@/services/differentialService/differentialExecutionService';
+import { DifferentialRequest, DifferentialWorkerMessage } from '@/services/interfaces/DifferentialExecution';
+
+/*
+ * Entry of the worker which runs a differential execution, see differentialWorkerService.ts.
+ * Each request gets its own worker, the worker is terminated when the execution is cancelled.
+ */
+
+interface WorkerScope {
+  onmessage: ((event: MessageEvent<DifferentialRequest>) => void) | null;
+  postMessage: (message: DifferentialWorkerMessage) => void;
+}
+
+const scope = globalThis as unknown as WorkerScope;
+
+scope.onmessage = (event) => {
+  runDifferentialExecution(event.data, {
+    onProgress: (progress) => scope.postMessage({ type: 'progress', progress }),
+  })
+    .then((result) => scope.postMessage({ type: 'result', result }))
+    .catch((e) => scope.postMessage({ type: 'error', message: e instanceof Error ? e.message : `${e}` }));
+};
@@ -0,0 +1,229 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import LockstepEngine from '@/services/differentialService/lockstepEngine';
+import Byte from '@/services/interfaces/Byte';
+import DifferentialResult, {
+  DifferentialProgress, DifferentialRequest, Divergence, EngineState, LockstepMode,
+} from '@/services/interfaces/DifferentialExecution';
+
+/*
+ * Runs a reference and a candidate program in lockstep and stops at the first point where the chosen registers,
+ * flags or memory ranges differ. Single stepping the emulator costs far more than the instruction itself, so in
+ * instruction mode both programs run a chunk of instructions between two comparisons, while their code hooks record
+ * a digest of the compared state before every instruction. If the digests or the states at the end of the chunk
+ * differ, fresh engines replay the programs up to the last point with equal digests, the execution is deterministic,
+ * and only step instruction by instruction from there. This also finds a difference which vanishes again within the
+ * chunk.
+ */
+
+export const defaultDifferentialChunkSize = 4096;
+
+// executions on the main thread give the event loop a turn after this many milliseconds
+const yieldIntervalInMilliseconds = 50;
+
+export interface DifferentialExecutionOptions {
+  onProgress?: (progress: DifferentialProgress) => void;
+  signal?: AbortSignal;
+}
+
+interface Comparison {
+  reference: EngineState;
+  candidate: EngineState;
+  divergence?: Divergence;
+}
+
+type EnginePair = [LockstepEngine, LockstepEngine];
+
+function equalBytes(a: Array<Byte>, b: Array<Byte>): boolean {
+  return a.length === b.length && a.every((byte, index) => byte.content === b[index].content);
+}
+
+function compareEngines(engines: EnginePair, request: DifferentialRequest): Comparison {
+  const [referenceEngine, candidateEngine] = engines;
+  const reference = referenceEngine.captureState(request);
+  const candidate = candidateEngine.captureState(request);
+  const registers = reference.registers
+    .filter((register, index) => !equalBytes(register.content, candidate.registers[index].content))
+    .map((register) => register.name);
+  const flags = reference.flags
+    .filter((flag, index) => flag.content.content !== candidate.flags[index].content.content)
+    .map((flag) => flag.name);
+  const { ucInstance } = candidateEngine.program;
+  const memoryRanges = reference.memory.flatMap((page) => Array.from(ucInstance.memory_diff(page.address, page.content)));
+  const termination = reference.finished !== candidate.finished
+    || reference.error !== candidate.error
+    || (request.mode === LockstepMode.INSTRUCTION && reference.executedInstructions !== candidate.executedInstructions);
+
+  if (registers.length === 0 && flags.length === 0 && memoryRanges.length === 0 && !termination) {
+    return { reference, candidate };
+  }
+  return {
+    reference,
+    candidate,
+    divergence: {
+      registers, flags, memoryRanges, termination,
+    },
+  };
+}
+
+// the programs are started one after the other, startEmulator keeps the instance it creates in a module variable
+async function startEngines(request: DifferentialRequest): Promise<EnginePair> {
+  const reference = await LockstepEngine.start(request.reference);
+  const candidate = await LockstepEngine.start(request.candidate);
+  return [reference, candidate];
+}
+
+function closeEngines(engines: EnginePair) {
+  engines.forEach((engine) => engine.close());
+}
+
+function bothFinished(engines: EnginePair): boolean {
+  return engines.every((engine) => engine.finished);
+}
+
+function createPacer(options: DifferentialExecutionOptions) {
+  let lastYield = Date.now();
+  return async (progress: DifferentialProgress) => {
+    if (Date.now() - lastYield < yieldIntervalInMilliseconds) {
+      return;
+    }
+    options.onProgress?.(progress);
+    await new Promise((resolve) => setTimeout(resolve, 0));
+    if (options.signal?.aborted) {
+      throw new Error('The differential execution was cancelled.');
+    }
+    lastYield = Date.now();
+  };
+}
+
+// Index of the first state digest of the last run which differs, or undefined if all digests of both engines match
+function firstDifferingDigest(engines: EnginePair): number | undefined {
+  const [reference, candidate] = engines.map((engine) => engine.stateDigests);
+  const recordedDigests = Math.min(reference.length, candidate.length);
+  for (let index = 0; index < recordedDigests; index += 1) {
+    if (reference[index] !== candidate[index]) {
+      return index;
+    }
+  }
+  return undefined;
+}
+
+// Runs fresh engines to the last point with equal states (equalPoints) and steps them until the states differ
+function locateDivergence(engines: EnginePair, request: DifferentialRequest, equalPoints: number, chunkEnd: number) {
+  engines.forEach((engine) => engine.run(equalPoints, false));
+  let comparison = compareEngines(engines, request);
+  let locatedPoints = equalPoints;
+  while (comparison.divergence === undefined && locatedPoints < chunkEnd) {
+    engines.forEach((engine) => engine.run(1, false));
+    comparison = compareEngines(engines, request);
+    if (comparison.divergence === undefined) {
+      locatedPoints += 1;
+    }
+  }
+  return { comparison, comparedPoints: locatedPoints };
+}
+
+async function runInstructionLockstep(request: DifferentialRequest, options: DifferentialExecutionOptions): Promise<DifferentialResult> {
+  const chunkSize = Math.max(1, request.chunkSize ?? defaultDifferentialChunkSize);
+  const pace = createPacer(options);
+  let engines = await startEngines(request);
+  try {
+    let comparison = compareEngines(engines, request);
+    let comparedPoints = 0;
+    while (comparison.divergence === undefined && !bothFinished(engines) && comparedPoints < request.instructionLimit) {
+      const count = Math.min(chunkSize, request.instructionLimit - comparedPoints);
+      engines.forEach((engine) => engine.run(count, false, request));
+      comparison = compareEngines(engines, request);
+      const differingDigest = firstDifferingDigest(engines);
+      if (comparison.divergence === undefined && differingDigest === undefined) {
+        comparedPoints = engines[0].executedInstructions;
+      } else if (count > 1) {
+        // the states before the differing digest, or before the end of the shorter run, are equal
+        const equalDigests = differingDigest ?? Math.min(...engines.map((engine) => engine.stateDigests.length));
+        const equalPoints = comparedPoints + Math.max(0, equalDigests - 1);
+        const chunkEnd = comparedPoints + count;
+        closeEngines(engines);
+        // eslint-disable-next-line no-await-in-loop
+        engines = await startEngines(request);
+        ({ comparison, comparedPoints } = locateDivergence(engines, request, equalPoints, chunkEnd));
+      }
+      // eslint-disable-next-line no-await-in-loop
+      await pace({ executedInstructions: comparedPoints, comparedPoints });
+    }
+    return {
+      comparedPoints,
+      reference: comparison.reference,
+      candidate: comparison.candidate,
+      divergence: comparison.divergence,
+      instructionLimitReached: comparison.divergence === undefined && !bothFinished(engines),
+    };
+  } finally {
+    closeEngines(engines);
+  }
+}
+
+async function runObservationPointLockstep(request: DifferentialRequest, options: DifferentialExecutionOptions): Promise<DifferentialResult> {
+  const pace = createPacer(options);
+  const engines = await startEngines(request);
+  const reachedInstructionLimit = (engine: LockstepEngine) => !engine.finished && engine.executedInstructions >= request.instructionLimit;
+  try {
+    let comparison = compareEngines(engines, request);
+    let comparedPoints = 0;
+    let instructionLimitReached = false;
+    while (comparison.divergence === undefined && !bothFinished(engines)) {
+      engines.forEach((engine) => engine.run(request.instructionLimit - engine.executedInstructions, true));
+      // the programs did not stop at the same kind of point, their states are shown but not compared
+      instructionLimitReached = engines.some(reachedInstructionLimit);
+      if (instructionLimitReached) {
+        const [reference, candidate] = engines.map((engine) => engine.captureState(request));
+        comparison = { reference, candidate };
+        break;
+      }
+      comparison = compareEngines(engines, request);
+      if (comparison.divergence === undefined) {
+        comparedPoints += 1;
+      }
+      // eslint-disable-next-line no-await-in-loop
+      await pace({ executedInstructions: engines[0].executedInstructions, comparedPoints });
+    }
+    return {
+      comparedPoints,
+      reference: comparison.reference,
+      candidate: comparison.candidate,
+      divergence: comparison.divergence,
+      instructionLimitReached,
+    };
+  } finally {
+    closeEngines(engines);
+  }
+}
+
+/**
+ * Runs both programs of the request until their states differ, both programs ended or the instruction limit is reached.
+ */
+export default function runDifferentialExecution(request: DifferentialRequest, options: DifferentialExecutionOptions = {}): Promise<DifferentialResult> {
+  if (request.mode === LockstepMode.OBSERVATION_POINT) {
+    return runObservationPointLockstep(request, options);
+  }
+  return runInstructionLockstep(request, options);
+}
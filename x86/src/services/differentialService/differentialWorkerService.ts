@@ -0,0 +1,101 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import runDifferentialExecution from '@/services/differentialService/differentialExecutionService';
+import DifferentialResult, {
+  DifferentialProgress, DifferentialRequest, DifferentialWorkerMessage,
+} from '@/services/interfaces/DifferentialExecution';
+
+export interface DifferentialExecution {
+  result: Promise<DifferentialResult>;
+  cancel: () => void;
+}
+
+function createWorker(): Worker | undefined {
+  if (typeof Worker === 'undefined') {
+    return undefined;
+  }
+  try {
+    return new Worker(new URL('./differentialExecution.worker.ts', import.meta.url));
+  } catch (e) {
+    /* eslint no-console: ["error", { allow: ["warn"] }] */
+    console.warn(e);
+    return undefined;
+  }
+}
+
+function runInWorker(worker: Worker, request: DifferentialRequest, onProgress?: (progress: DifferentialProgress) => void): DifferentialExecution {
+  let rejectResult: (reason: Error) => void = () => undefined;
+  const result = new Promise<DifferentialResult>((resolve, reject) => {
+    rejectResult = reject;
+    // eslint-disable-next-line no-param-reassign
+    worker.onmessage = (event: MessageEvent<DifferentialWorkerMessage>) => {
+      const message = event.data;
+      if (message.type === 'progress') {
+        onProgress?.(message.progress);
+        return;
+      }
+      worker.terminate();
+      if (message.type === 'result') {
+        resolve(message.result);
+      } else {
+        reject(new Error(message.message));
+      }
+    };
+    // eslint-disable-next-line no-param-reassign
+    worker.onerror = (event) => {
+      worker.terminate();
+      reject(new Error(event.message));
+    };
+  });
+  worker.postMessage(request);
+  return {
+    result,
+    cancel: () => {
+      worker.terminate();
+      rejectResult(new Error('The differential execution was cancelled.'));
+    },
+  };
+}
+
+function runOnMainThread(request: DifferentialRequest, onProgress?: (progress: DifferentialProgress) => void): DifferentialExecution {
+  const controller = new AbortController();
+  return {
+    result: runDifferentialExecution(request, { onProgress, signal: controller.signal }),
+    cancel: () => controller.abort(),
+  };
+}
+
+/**
+ * Starts the differential execution in a worker, so the page stays responsive during long runs.
+ * Without worker support the execution runs on the main thread and pauses between chunks.
+ */
+export default function startDifferentialExecution(
+  request: DifferentialRequest,
+  onProgress?: (progress: DifferentialProgress) => void,
+): DifferentialExecution {
+  const worker = createWorker();
+  if (worker === undefined) {
+    return runOnMainThread(request, onProgress);
+  }
+  return runInWorker(worker, request, onProgress);
+}
@@ -0,0 +1,266 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import startEmulator from '@/services/startSimulatorService';
+import { eUC, RegisterID } from '@/services/emulator/emulatorEnums';
+import { getFlags, getRegisters } from '@/services/dataServices/registerService';
+import { FlagID } from '@/services/interfaces/Flag';
+import Program from '@/services/interfaces/Program';
+import { MemoryPage } from '@/services/interfaces/SimulatorSession';
+import EmulatorHook from '@/services/interfaces/EmulatorHook';
+import {
+  ComparedMemoryRange, DifferentialProgram, DifferentialRequest, EngineState,
+} from '@/services/interfaces/DifferentialExecution';
+
+/* eslint no-bitwise: 0 */
+
+type ComparedState = Pick<DifferentialRequest, 'registers' | 'flags' | 'memoryRanges'>;
+
+interface StateDigest {
+  // the compared registers followed by EFLAGS
+  registerIDs: Array<RegisterID>;
+  flags: Array<FlagID>;
+  memoryRanges: Array<ComparedMemoryRange>;
+  // copies of the compared memory ranges, kept up to date with the writes of the run
+  memory: Array<Uint8Array>;
+  // pairs of address and size of the writes since the last instruction
+  pendingWrites: Array<number>;
+  // order independent sum of the digests of all compared bytes, updated with every write
+  memoryDigest: number;
+}
+
+const fnvOffsetBasis = 0x811C9DC5;
+const fnvPrime = 0x01000193;
+
+function memoryByteDigest(address: number, value: number): number {
+  let digest = Math.imul(address ^ Math.imul(value + 1, 0x9E3779B1), 0x85EBCA6B);
+  digest ^= digest >>> 13;
+  return Math.imul(digest, 0xC2B2AE35) ^ (digest >>> 16);
+}
+
+/*
+ * One of the two programs of a differential execution. The program runs without the step controller,
+ * a single code hook counts the executed instructions and stops the emulator when the run has executed enough
+ * instructions, reached an observation point or left the code. On request the hook also records a digest of the
+ * compared registers, flags and memory ranges before every instruction, so two runs can be compared instruction by
+ * instruction without stepping the emulator.
+ */
+export default class LockstepEngine {
+  readonly program: Program;
+
+  executedInstructions = 0;
+
+  finished = false;
+
+  error?: string;
+
+  // stateDigests[i] is the digest of the state after i instructions of the last run, empty if it recorded none
+  readonly stateDigests: Array<number> = [];
+
+  private readonly observationAddresses: Set<number>;
+
+  private readonly codeEndAddress: number;
+
+  private readonly hooks: Array<EmulatorHook>;
+
+  private instructionsOfRun = 0;
+
+  private instructionLimitOfRun = 0;
+
+  private stopAtObservationPoint = false;
+
+  private stoppedByHook = false;
+
+  private digest?: StateDigest;
+
+  constructor(program: Program, observationAddresses: Array<number>) {
+    this.program = program;
+    this.observationAddresses = new Set(observationAddresses);
+    this.codeEndAddress = program.codeAddress + program.codeSizeInBytes;
+    // there is no operating system, interrupts only mark observation points and execution continues after them
+    this.hooks = [
+      program.ucInstance.hook_add(eUC.HOOK_CODE, this.countInstruction, {}, 1, 0, 0),
+      program.ucInstance.hook_add(eUC.HOOK_INTR, () => undefined, {}, 1, 0, 0),
+      program.ucInstance.hook_add(eUC.HOOK_MEM_WRITE, this.noteWrite, {}, 1, 0, 0),
+    ];
+  }
+
+  static async start(differentialProgram: DifferentialProgram): Promise<LockstepEngine> {
+    const program = await startEmulator(differentialProgram.code, differentialProgram.memoryMap);
+    const { disassemblerInstance } = program;
+    const interruptAddresses = disassemblerInstance
+      .findInstructionsOfGroup(Uint8Array.from(program.code), program.codeAddress, disassemblerInstance.cs.GRP_INT);
+    return new LockstepEngine(program, [...interruptAddresses, ...(differentialProgram.observationAddresses ?? [])]);
+  }
+
+  private isInCode(address: number): boolean {
+    return address >= this.program.codeAddress && address < this.codeEndAddress;
+  }
+
+  // called before every instruction, the instruction is not executed if the emulator is stopped here
+  private countInstruction = (_handle: number, address: number) => {
+    if (this.stoppedByHook) {
+      return;
+    }
+    const reachedObservationPoint = this.stopAtObservationPoint && this.instructionsOfRun > 0 && this.observationAddresses.has(address);
+    if (!this.isInCode(address)) {
+      this.finished = true;
+    }
+    if (this.finished || reachedObservationPoint || this.instructionsOfRun === this.instructionLimitOfRun) {
+      this.stoppedByHook = true;
+      this.program.ucInstance.emu_stop();
+      return;
+    }
+    if (this.digest !== undefined) {
+      this.stateDigests.push(this.digestState(this.digest));
+    }
+    this.instructionsOfRun += 1;
+  };
+
+  // called before every write, the written bytes are read with the next instruction
+  private noteWrite = (_handle: number, _type: number, addressLo: number, _addressHi: number, size: number) => {
+    const digest = this.digest;
+    const address = addressLo >>> 0;
+    if (digest !== undefined && digest.memoryRanges.some((range) => address < range.address + range.sizeInBytes && address + size > range.address)) {
+      digest.pendingWrites.push(address, size);
+    }
+  };
+
+  private startDigest(comparedState: ComparedState): StateDigest {
+    const { ucInstance } = this.program;
+    const memory = comparedState.memoryRanges.map((range) => ucInstance.memory_read(range.address, range.sizeInBytes));
+    let memoryDigest = 0;
+    memory.forEach((content, rangeIndex) => {
+      const { address } = comparedState.memoryRanges[rangeIndex];
+      content.forEach((value, offset) => {
+        memoryDigest = (memoryDigest + memoryByteDigest(address + offset, value)) | 0;
+      });
+    });
+    return {
+      registerIDs: [...comparedState.registers, RegisterID.EFLAGS],
+      flags: comparedState.flags,
+      memoryRanges: comparedState.memoryRanges,
+      memory,
+      pendingWrites: [],
+      memoryDigest,
+    };
+  }
+
+  private applyPendingWrites(digest: StateDigest) {
+    const { ucInstance } = this.program;
+    const { pendingWrites } = digest;
+    for (let write = 0; write < pendingWrites.length; write += 2) {
+      const writeStart = pendingWrites[write];
+      const writeEnd = writeStart + pendingWrites[write + 1];
+      digest.memoryRanges.forEach((range, rangeIndex) => {
+        const start = Math.max(writeStart, range.address);
+        const end = Math.min(writeEnd, range.address + range.sizeInBytes);
+        if (start >= end) {
+          return;
+        }
+        const copy = digest.memory[rangeIndex];
+        const written = ucInstance.memory_read(start, end - start);
+        written.forEach((value, index) => {
+          const offset = start - range.address + index;
+          const oldDigest = memoryByteDigest(start + index, copy[offset]);
+          digest.memoryDigest = (digest.memoryDigest - oldDigest + memoryByteDigest(start + index, value)) | 0;
+          copy[offset] = value;
+        });
+      });
+    }
+    pendingWrites.length = 0;
+  }
+
+  // FNV-1a over the memory digest, the register bytes and the compared flag bits
+  private digestState(digest: StateDigest): number {
+    this.applyPendingWrites(digest);
+    const values = this.program.ucInstance.register_read_batch(digest.registerIDs);
+    let hash = Math.imul(fnvOffsetBasis ^ digest.memoryDigest, fnvPrime);
+    const eflagsOffset = values.length - 8;
+    for (let i = 0; i < eflagsOffset; i += 1) {
+      hash = Math.imul(hash ^ values[i], fnvPrime);
+    }
+    const eflags = values[eflagsOffset] | (values[eflagsOffset + 1] << 8) | (values[eflagsOffset + 2] << 16) | (values[eflagsOffset + 3] << 24);
+    digest.flags.forEach((flagId) => {
+      hash = Math.imul(hash ^ ((eflags >>> flagId) & 1), fnvPrime);
+    });
+    return hash;
+  }
+
+  /**
+   * Executes at most instructionLimit instructions, in observation mode the run stops before the next observation point.
+   * The instruction at the current observation point is executed. Returns the number of executed instructions.
+   * With comparedState the digests of that state are recorded in stateDigests.
+   */
+  run(instructionLimit: number, untilObservationPoint: boolean, comparedState?: ComparedState): number {
+    this.stateDigests.length = 0;
+    if (this.finished || instructionLimit <= 0) {
+      return 0;
+    }
+    this.digest = comparedState && this.startDigest(comparedState);
+    this.instructionsOfRun = 0;
+    this.instructionLimitOfRun = instructionLimit;
+    this.stopAtObservationPoint = untilObservationPoint;
+    this.stoppedByHook = false;
+    const { ucInstance } = this.program;
+    try {
+      ucInstance.emu_start(this.getInstructionPointer(), this.codeEndAddress, 0, 0);
+      // the emulator stops by itself at the end of the code or at a hlt instruction
+      if (!this.stoppedByHook) {
+        this.finished = true;
+      }
+    } catch (e) {
+      this.finished = true;
+      this.error = e instanceof Error ? e.message : `${e}`;
+    }
+    this.digest = undefined;
+    this.executedInstructions += this.instructionsOfRun;
+    return this.instructionsOfRun;
+  }
+
+  getInstructionPointer(): number {
+    return this.program.ucInstance.register_read_number(RegisterID.RIP);
+  }
+
+  readMemory(memoryRanges: Array<ComparedMemoryRange>): Array<MemoryPage> {
+    const { ucInstance } = this.program;
+    return memoryRanges.map((range) => ({ address: range.address, content: ucInstance.memory_read(range.address, range.sizeInBytes) }));
+  }
+
+  captureState(request: ComparedState): EngineState {
+    const { ucInstance } = this.program;
+    return {
+      executedInstructions: this.executedInstructions,
+      instructionPointer: this.getInstructionPointer(),
+      registers: getRegisters(ucInstance, request.registers),
+      flags: getFlags(ucInstance, request.flags),
+      memory: this.readMemory(request.memoryRanges),
+      finished: this.finished,
+      error: this.error,
+    };
+  }
+
+  close() {
+    this.hooks.forEach((hook) => this.program.ucInstance.hook_del(hook));
+    this.program.ucInstance.close();
+  }
+}
@@ -62,8 +62,6 @@ POSSIBILITY OF SUCH DAMAGE.
 /* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2015 */
 
 /* eslint-disable */
-// @ts-ignore
-import Module from '../../../lib/libcapstone-x86.out';
 import Instruction from "@/services/interfaces/Instruction";
 import Byte from "@/services/interfaces/Byte";
 import uInt8ArrayToHexStringArray from "@/services/helper/uInt8ArrayHelper";
@@ -71,6 +69,12 @@ import {dataStringsToCurrentInstructionBytes} from "@/services/dataServices/byte
 import getInstructionInformationFromCapstone
   from '@/services/disassembler/instructionOperandsService';
 import fillAddress from "@/services/helper/htmlIdService";
+import ResolvedMemoryAccess from "@/services/interfaces/ResolvedMemoryAccess";
+import { ReadWriteAccessMode } from "@/services/interfaces/InstructionOperands";
+import { RegisterID } from "@/services/emulator/emulatorEnums";
+import { disassemblerRegisterID } from "@/services/disassembler/disassemblerEnum";
+import { traceCcall } from "@/services/helper/traceService";
+import { loadEngine } from "@/services/helper/engineModuleService";
 /* eslint-enable */
 
 /* eslint camelcase: 0 */
@@ -84,6 +88,8 @@ class Disassembler {
     // eslint-disable-next-line @typescript-eslint/no-explicit-any
     getValue: (arg0: any, arg1: string) => any;
 
+    setValue: (pointer: number, value: number, type: string) => void;
+
     // eslint-disable-next-line @typescript-eslint/no-explicit-any
     UTF8ToString: (arg0: any) => string;
 
@@ -97,13 +103,57 @@ class Disassembler {
     // eslint-disable-next-line @typescript-eslint/no-explicit-any
     ccall: (name: string, returnType: string | null, argumentTypes: string[], args: any[]) => any;
 
+    // only available in libraries built from cs.c with resolve_memory_operands
+    _resolve_memory_operands?: (handle: number, insn: number, registers: number, accesses: number, maxAccesses: number) => number;
   };
 
   // eslint-disable-next-line @typescript-eslint/no-explicit-any
   private handle_ptr: any;
 
+  // register snapshot (one 64-bit value per register id) and result buffer of resolve_memory_operands, allocated once
+  private registerSnapshot_ptr = 0;
+
+  private memoryAccesses_ptr = 0;
+
+  private static readonly maxMemoryAccesses = 8;
+
+  private static readonly memoryAccessSize = 16;
+
+  // cs_insn allocated once with cs_malloc, cs_disasm_iter decodes into it in place
+  private decodedInstruction_ptr = 0;
+
+  // bytes to decode and the in/out arguments of cs_disasm_iter (code pointer, remaining size, address)
+  private stagedBytes_ptr = 0;
+
+  private stagedBytesCapacity = 0;
+
+  private stagedCode_ptr_ptr = 0;
+
+  private stagedSize_ptr = 0;
+
+  private stagedAddress_ptr = 0;
+
+  // increased whenever bytes are staged, see iterateInstructions
+  private stagingGeneration = 0;
+
+  // output buffer of print_insn_detail, allocated once
+  private instructionDetail_ptr = 0;
+
+  private static readonly maxInstructionLength = 15;
+
+  private static readonly instructionDetailLength = 2000;
+
   async initialiseDisassembler() {
+    const Module = await loadEngine('capstone');
     this.MCapstone = await Module();
+    // buffers allocated in the heap of a previous module are gone
+    this.registerSnapshot_ptr = 0;
+    this.memoryAccesses_ptr = 0;
+    this.decodedInstruction_ptr = 0;
+    this.stagedBytes_ptr = 0;
+    this.stagedBytesCapacity = 0;
+    this.instructionDetail_ptr = 0;
+    this.MCapstone.ccall = traceCcall('capstone', this.MCapstone.ccall);
     this.handle_ptr = this.MCapstone._malloc(4);
 
     const ret = this.MCapstone.ccall(
@@ -131,7 +181,7 @@ class Disassembler {
     }
   }
 
-  private cs = {
+  readonly cs = {
     // Return codes
     ERR_OK: 0, // No error: everything was fine
     ERR_MEM: 1, // Out-Of-Memory error: cs_open(), cs_disasm(), cs_disasm_iter()
@@ -223,15 +273,31 @@ class Disassembler {
     const mnemonicInAscii = this.MCapstone.UTF8ToString(pointer + 34);
 
     const instructionOperandsInAscii = this.MCapstone.UTF8ToString(pointer + 66);
+    const operands = getInstructionInformationFromCapstone(this.readInstructionDetail(pointer));
+
+    return {
+      assemblyInterpretation: `${mnemonicInAscii} ${instructionOperandsInAscii}`,
+      length: sizeOfInstruction,
+      content: machineBytesOfInstruction,
+      address: fillAddress(addressOfInstruction),
+      operands,
+    };
+  }
+
+  // Returns the JSON printed by print_insn_detail. The "cpusim" build profile only prints the fields
+  // read by getInstructionInformationFromCapstone, the full build prints all details of the instruction.
+  protected readInstructionDetail(pointer: number): string {
     const handle = this.MCapstone.getValue(this.handle_ptr, 'i32');
 
     // The buffer should be long enough to carry all data provided by the function print_insn_detail.
-    const bufferLength = 2000;
+    if (this.instructionDetail_ptr === 0) {
+      this.instructionDetail_ptr = this.MCapstone._malloc(Disassembler.instructionDetailLength);
+    }
 
     // print_insn_detail is function extending the capabilities of the normal Capstone distribution.
     // It prints details of a given instruction.
     // The code is written within the cs.c file provided with CPUSim and is needed when compiling Capstone.
-    const instructionDetailString_ptr = this.MCapstone._malloc(bufferLength);
+    const instructionDetailString_ptr = this.instructionDetail_ptr;
     const ret = this.MCapstone.ccall(
       'print_insn_detail',
       'number',
@@ -240,21 +306,13 @@ class Disassembler {
     );
 
     let text: string = this.MCapstone.UTF8ToString(instructionDetailString_ptr);
+    // libraries built from older versions of cs.c start the flag lists with a comma
     text = text.split('[,').join('[');
-    const operands = getInstructionInformationFromCapstone(text);
 
-    this.MCapstone._free(instructionDetailString_ptr);
     if (ret !== 0) {
       throw new Error('print_insn_detail: Instruction detail "OPT_DETAIL" is not set in Capstone.');
     }
-
-    return {
-      assemblyInterpretation: `${mnemonicInAscii} ${instructionOperandsInAscii}`,
-      length: sizeOfInstruction,
-      content: machineBytesOfInstruction,
-      address: fillAddress(addressOfInstruction),
-      operands,
-    };
+    return text;
   }
 
   private buildInstructionBytes(sizeOfInstruction: number, pointer: number): Byte[] {
@@ -279,13 +337,231 @@ class Disassembler {
     return this.MCapstone.ccall('cs_errno', 'number', ['pointer'], [handle]);
   }
 
+  hasMemoryOperandResolution(): boolean {
+    return typeof this.MCapstone._resolve_memory_operands === 'function';
+  }
+
+  // Resolves the memory addresses the first instruction in buffer accesses when executed with the given register values.
+  // Returns undefined if the Capstone library was built without resolve_memory_operands.
+  resolveMemoryAccesses(buffer: Uint8Array, addr: number, registerValues: Map<RegisterID, Uint8Array>): ResolvedMemoryAccess[] | undefined {
+    if (!this.hasMemoryOperandResolution()) {
+      return undefined;
+    }
+    const handle = this.MCapstone.getValue(this.handle_ptr, 'i32');
+    this.stageBytes(buffer.subarray(0, Disassembler.maxInstructionLength), addr);
+    if (!this.decodeStagedInstruction()) {
+      throw new Error('Capstone.js: Function cs_disasm_iter failed while resolving memory accesses');
+    }
+    const insn_ptr = this.decodedInstruction_ptr;
+
+    this.writeRegisterSnapshot(registerValues);
+    const accessCount: number = this.MCapstone.ccall(
+      'resolve_memory_operands',
+      'number',
+      ['number', 'number', 'number', 'number', 'number'],
+      [handle, insn_ptr, this.registerSnapshot_ptr, this.memoryAccesses_ptr, Disassembler.maxMemoryAccesses],
+    );
+
+    if (accessCount < 0) {
+      throw new Error('resolve_memory_operands: Instruction detail "OPT_DETAIL" is not set in Capstone.');
+    }
+    const accesses: ResolvedMemoryAccess[] = [];
+    for (let i = 0; i < Math.min(accessCount, Disassembler.maxMemoryAccesses); i += 1) {
+      const access_ptr = this.memoryAccesses_ptr + i * Disassembler.memoryAccessSize;
+      const addressLow = this.MCapstone.getValue(access_ptr, 'i32') >>> 0;
+      const addressHigh = this.MCapstone.getValue(access_ptr + 4, 'i32') >>> 0;
+      const accessFlags = this.MCapstone.getValue(access_ptr + 12, 'i32');
+      accesses.push({
+        address: addressHigh * 2 ** 32 + addressLow,
+        size: this.MCapstone.getValue(access_ptr + 8, 'i32'),
+        access: Disassembler.getReadWriteAccessModeFromFlags(accessFlags),
+      });
+    }
+    return accesses;
+  }
+
+  private writeRegisterSnapshot(registerValues: Map<RegisterID, Uint8Array>) {
+    const snapshotSize = disassemblerRegisterID.REG_ENDING * 8;
+    if (this.registerSnapshot_ptr === 0) {
+      this.registerSnapshot_ptr = this.MCapstone._malloc(snapshotSize);
+      this.memoryAccesses_ptr = this.MCapstone._malloc(Disassembler.maxMemoryAccesses * Disassembler.memoryAccessSize);
+    }
+    this.MCapstone.HEAPU8.fill(0, this.registerSnapshot_ptr, this.registerSnapshot_ptr + snapshotSize);
+    // register ids of Capstone and Unicorn are equal up to REG_ENDING of Capstone
+    registerValues.forEach((value: Uint8Array, registerId: RegisterID) => {
+      if (registerId < disassemblerRegisterID.REG_ENDING) {
+        this.MCapstone.HEAPU8.set(value.subarray(0, 8), this.registerSnapshot_ptr + registerId * 8);
+      }
+    });
+  }
+
+  // CS_AC_READ = 1, CS_AC_WRITE = 2
+  private static getReadWriteAccessModeFromFlags(accessFlags: number): ReadWriteAccessMode {
+    if ((accessFlags & 3) === 3) {
+      return ReadWriteAccessMode.READ_WRITE;
+    }
+    return (accessFlags & 2) ? ReadWriteAccessMode.WRITE : ReadWriteAccessMode.READ;
+  }
+
   // Destructor
   delete() {
+    this.freeDecodeBuffers();
     const ret = this.MCapstone.ccall('cs_close', 'number', ['pointer'], [this.handle_ptr]);
     if (ret !== this.cs.ERR_OK) {
       throw new Error(`Capstone.js: Function cs_close failed with code ${ret}:\n${this.strerror(ret)}`);
     }
     this.MCapstone._free(this.handle_ptr);
+    if (this.registerSnapshot_ptr !== 0) {
+      this.MCapstone._free(this.registerSnapshot_ptr);
+      this.MCapstone._free(this.memoryAccesses_ptr);
+      this.registerSnapshot_ptr = 0;
+      this.memoryAccesses_ptr = 0;
+    }
+  }
+
+  private allocateDecodeBuffers(byteCount: number) {
+    if (this.decodedInstruction_ptr === 0) {
+      const handle = this.MCapstone.getValue(this.handle_ptr, 'i32');
+      this.decodedInstruction_ptr = this.MCapstone.ccall('cs_malloc', 'number', ['number'], [handle]);
+      this.stagedCode_ptr_ptr = this.MCapstone._malloc(4);
+      this.stagedSize_ptr = this.MCapstone._malloc(4);
+      this.stagedAddress_ptr = this.MCapstone._malloc(8);
+    }
+    if (byteCount > this.stagedBytesCapacity) {
+      if (this.stagedBytes_ptr !== 0) {
+        this.MCapstone._free(this.stagedBytes_ptr);
+      }
+      this.stagedBytesCapacity = Math.max(byteCount, 4 * Disassembler.maxInstructionLength);
+      this.stagedBytes_ptr = this.MCapstone._malloc(this.stagedBytesCapacity);
+    }
+  }
+
+  private freeDecodeBuffers() {
+    if (this.decodedInstruction_ptr !== 0) {
+      this.MCapstone.ccall('cs_free', 'void', ['pointer', 'number'], [this.decodedInstruction_ptr, 1]);
+      this.MCapstone._free(this.stagedCode_ptr_ptr);
+      this.MCapstone._free(this.stagedSize_ptr);
+      this.MCapstone._free(this.stagedAddress_ptr);
+      this.decodedInstruction_ptr = 0;
+    }
+    if (this.stagedBytes_ptr !== 0) {
+      this.MCapstone._free(this.stagedBytes_ptr);
+      this.stagedBytes_ptr = 0;
+      this.stagedBytesCapacity = 0;
+    }
+    if (this.instructionDetail_ptr !== 0) {
+      this.MCapstone._free(this.instructionDetail_ptr);
+      this.instructionDetail_ptr = 0;
+    }
+  }
+
+  // Copies the bytes into the staging buffer, which is only reallocated if it is too small
+  private stageBytes(bytes: Uint8Array, addr: number) {
+    this.allocateDecodeBuffers(bytes.length);
+    this.MCapstone.HEAPU8.set(bytes, this.stagedBytes_ptr);
+    this.MCapstone.setValue(this.stagedCode_ptr_ptr, this.stagedBytes_ptr, 'i32');
+    this.MCapstone.setValue(this.stagedSize_ptr, bytes.length, 'i32');
+    this.MCapstone.setValue(this.stagedAddress_ptr, addr, 'i64');
+    this.stagingGeneration += 1;
+  }
+
+  // cs_disasm_iter decodes the next staged instruction into the persistent cs_insn and advances the staged position
+  private decodeStagedInstruction(): boolean {
+    const handle = this.MCapstone.getValue(this.handle_ptr, 'i32');
+    return this.MCapstone.ccall(
+      'cs_disasm_iter',
+      'number',
+      ['number', 'pointer', 'pointer', 'pointer', 'pointer'],
+      [handle, this.stagedCode_ptr_ptr, this.stagedSize_ptr, this.stagedAddress_ptr, this.decodedInstruction_ptr],
+    ) !== 0;
+  }
+
+  // Moves the staged position one byte past an undecodable byte, returns false if no bytes are left
+  private skipStagedByte(): boolean {
+    const size = this.MCapstone.getValue(this.stagedSize_ptr, 'i32');
+    if (size <= 1) {
+      this.MCapstone.setValue(this.stagedSize_ptr, 0, 'i32');
+      return false;
+    }
+    this.MCapstone.setValue(this.stagedCode_ptr_ptr, this.MCapstone.getValue(this.stagedCode_ptr_ptr, 'i32') + 1, 'i32');
+    this.MCapstone.setValue(this.stagedSize_ptr, size - 1, 'i32');
+    this.MCapstone.setValue(this.stagedAddress_ptr, this.MCapstone.getValue(this.stagedAddress_ptr, 'i64') + 1, 'i64');
+    return true;
+  }
+
+  /**
+   * Decodes the first instruction of the bytes without allocating memory in the Capstone heap.
+   * Returns undefined if the bytes do not start with a valid instruction.
+   */
+  decodeInstruction(bytes: Uint8Array, addr: number): Instruction | undefined {
+    this.stageBytes(bytes.subarray(0, Disassembler.maxInstructionLength), addr);
+    if (!this.decodeStagedInstruction()) {
+      return undefined;
+    }
+    return this.buildInstruction(this.decodedInstruction_ptr);
+  }
+
+  /**
+   * Decodes the instructions of the bytes one after the other, until the end of the bytes or the first invalid instruction.
+   * Other decodes may run between two iterations.
+   */
+  * iterateInstructions(bytes: Uint8Array, addr: number): Generator<Instruction> {
+    let offset = 0;
+    let stagingGeneration = -1;
+    while (offset < bytes.length) {
+      // cs_disasm_iter advances the staged position, the bytes are staged again only if another decode replaced them
+      if (stagingGeneration !== this.stagingGeneration) {
+        this.stageBytes(bytes.subarray(offset), addr + offset);
+        stagingGeneration = this.stagingGeneration;
+      }
+      if (!this.decodeStagedInstruction()) {
+        return;
+      }
+      const instruction = this.buildInstruction(this.decodedInstruction_ptr);
+      offset += instruction.length;
+      yield instruction;
+    }
+  }
+
+  private decodedInstructionIsInGroup(group: number): boolean {
+    const handle = this.MCapstone.getValue(this.handle_ptr, 'i32');
+    return this.MCapstone.ccall('cs_insn_group', 'number', ['number', 'pointer', 'number'], [handle, this.decodedInstruction_ptr, group]) !== 0;
+  }
+
+  /**
+   * Returns the control flow group (GRP_CALL, GRP_RET, GRP_IRET, GRP_INT or GRP_JUMP) of the first instruction of the bytes.
+   * Returns GRP_INVALID for other or invalid instructions.
+   */
+  getControlFlowGroup(bytes: Uint8Array, addr: number): number {
+    this.stageBytes(bytes.subarray(0, Disassembler.maxInstructionLength), addr);
+    if (!this.decodeStagedInstruction()) {
+      return this.cs.GRP_INVALID;
+    }
+    const controlFlowGroups = [this.cs.GRP_CALL, this.cs.GRP_RET, this.cs.GRP_IRET, this.cs.GRP_INT, this.cs.GRP_JUMP];
+    const group = controlFlowGroups.find((controlFlowGroup) => this.decodedInstructionIsInGroup(controlFlowGroup));
+    return group ?? this.cs.GRP_INVALID;
+  }
+
+  // Returns the addresses of all instructions of the group, without building the instructions.
+  // Undecodable bytes, e.g. data between the functions, are skipped one at a time and the scan continues after them.
+  findInstructionsOfGroup(bytes: Uint8Array, addr: number, group: number): Array<number> {
+    const addresses: Array<number> = [];
+    if (bytes.length === 0) {
+      return addresses;
+    }
+    this.stageBytes(bytes, addr);
+    let bytesLeft = true;
+    while (bytesLeft) {
+      if (!this.decodeStagedInstruction()) {
+        bytesLeft = this.skipStagedByte();
+      } else {
+        if (this.decodedInstructionIsInGroup(group)) {
+          addresses.push(this.MCapstone.getValue(this.decodedInstruction_ptr + 8, 'i64'));
+        }
+        bytesLeft = this.MCapstone.getValue(this.stagedSize_ptr, 'i32') > 0;
+      }
+    }
+    return addresses;
   }
 
   // eslint-disable-next-line @typescript-eslint/no-explicit-any
@@ -310,7 +586,6 @@ class Disassembler {
     if (count === 0 && buffer.length !== 0) {
       this.MCapstone._free(insn_ptr_ptr);
       this.MCapstone._free(buffer_ptr);
-      this.MCapstone._free(buffer_heap.byteOffset);
 
       throw new Error('Capstone.js: Function cs_disasm failed. Maybe you forgot to delete a Disassembler instance');
     }
@@ -330,7 +605,6 @@ class Disassembler {
 
     this.MCapstone._free(insn_ptr_ptr);
     this.MCapstone._free(buffer_ptr);
-    this.MCapstone._free(buffer_heap.byteOffset);
     return instructions;
   }
 
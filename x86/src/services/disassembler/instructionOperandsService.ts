@@ -31,6 +31,8 @@ import InstructionOperands, {
 } from '@/services/interfaces/InstructionOperands';
 import { RegisterID } from '@/services/emulator/emulatorEnums';
 import { getFlagIdFromName, getRegisterIdFromName } from '@/services/dataServices/registerService';
+import { FlagID } from '@/services/interfaces/Flag';
+import { createRegisterMaskFromWords } from '@/services/dataServices/registerMaskService';
 
 export function getReadWriteAccessModFromName(memoryAccess: string): ReadWriteAccessMode {
   const name = memoryAccess.toUpperCase() as keyof typeof ReadWriteAccessMode;
@@ -42,6 +44,21 @@ export function getFlagAccessModFromName(flagAccess: string): FlagAccessMode {
   return FlagAccessMode[accessMode];
 }
 
+/**
+ * Returns the access modes of a flag from the EFLAGS_MASKS printed by print_insn_detail.
+ * The masks are indexed by FlagAccessMode, bit n of a mask stands for the flag at position n of the EFLAGS register.
+ */
+export function getFlagAccessModesFromMasks(flagAccessMasks: Array<number>, flagId: FlagID): Array<FlagAccessMode> {
+  const accessModes: Array<FlagAccessMode> = [];
+  flagAccessMasks.forEach((mask: number, accessMode: FlagAccessMode) => {
+    // eslint-disable-next-line no-bitwise
+    if (mask & (1 << flagId)) {
+      accessModes.push(accessMode);
+    }
+  });
+  return accessModes;
+}
+
 function createPointerArithmeticOperands(operand: OperandFromJSON): MemoryPointerArithmeticOperands {
   const regBase = operand.reg_base ? getRegisterIdFromName(operand.reg_base) : undefined;
   const regIndex = operand.reg_index ? getRegisterIdFromName(operand.reg_index) : undefined;
@@ -172,6 +189,18 @@ function addJSONFlagsToInstructionOperands(flagsJSON: Array<{access: string; nam
   });
 }
 
+function addFlagMasksToInstructionOperands(flagAccessMasks: Array<number>, instructionOperands: InstructionOperands): void {
+  Object.values(FlagID).filter((flagId): flagId is FlagID => typeof flagId === 'number').forEach((flagId: FlagID) => {
+    const flagAccessModes = getFlagAccessModesFromMasks(flagAccessMasks, flagId);
+    if (flagAccessModes.some(isFlagWriteAccess)) {
+      instructionOperands.flagsWrite.push(flagId);
+    }
+    if (flagAccessModes.includes(FlagAccessMode.TEST)) {
+      instructionOperands.flagsTest.push(flagId);
+    }
+  });
+}
+
 function addJSONRegistersToRegisterIds(registersJSON: Array<string>, registerIds: Array<RegisterID>): Array<RegisterID> {
   const registers = createRegisterIdsFromJSON(registersJSON);
   registers.forEach((registerJSON) => {
@@ -217,7 +246,16 @@ export default function getInstructionInformationFromCapstone(instructionData: s
     if (object.registers_modified) {
       instructionOperands.registersWrite = addJSONRegistersToRegisterIds(object.registers_modified, instructionOperands.registersWrite);
     }
-    if (object.EFLAGS) {
+    if (object.registers_read_mask && object.registers_modified_mask) {
+      instructionOperands.registersReadMask = createRegisterMaskFromWords(object.registers_read_mask);
+      instructionOperands.registersWriteMask = createRegisterMaskFromWords(object.registers_modified_mask);
+    }
+    // libraries built from older versions of cs.c only print the EFLAGS list
+    if (object.EFLAGS_MASKS) {
+      addFlagMasksToInstructionOperands(object.EFLAGS_MASKS, instructionOperands);
+      instructionOperands.flagsWrite.sort();
+      instructionOperands.flagsTest.sort();
+    } else if (object.EFLAGS) {
       addJSONFlagsToInstructionOperands(object.EFLAGS, instructionOperands);
       instructionOperands.flagsWrite.sort();
       instructionOperands.flagsTest.sort();
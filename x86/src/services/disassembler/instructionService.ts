@@ -25,12 +25,14 @@ import { byteArrayToUInt8Array } from '@/services/dataServices/byteService';
 import Program from '@/services/interfaces/Program';
 import { getFirstInstruction } from '@/services/nasm/ndisasm';
 import isJmpCallInstructionWORKAROUND from '@/services/disassembler/jumpInstructionService';
+import { getPrebuiltInstruction } from '@/services/editorService/prebuiltProgramService';
+import { countTrace, traceSpan } from '@/services/helper/traceService';
 
 async function injectNasmAssemblyIntoInstruction(instruction: Instruction): Promise<Instruction> {
   const injectedInstruction = instruction;
 
   try {
-    const ndisasmInstruction = await getFirstInstruction(byteArrayToUInt8Array(instruction.content));
+    const ndisasmInstruction = await traceSpan('ndisasm.getFirstInstruction', () => getFirstInstruction(byteArrayToUInt8Array(instruction.content)));
     injectedInstruction.assemblyInterpretation = ndisasmInstruction;
   } catch (e) {
     throw new Error(`Injecting of Instruction failed: ${e}`);
@@ -38,16 +40,29 @@ async function injectNasmAssemblyIntoInstruction(instruction: Instruction): Prom
   return injectedInstruction;
 }
 
-export default async function getCurrentInstruction(program: Program, nextBytesOfCode: Uint8Array, instructionAddressHex: string): Promise<Instruction> {
-  let instructionsOfCapstone: Array<Instruction> = [];
-  const instructionAddress: number = parseInt(instructionAddressHex, 16);
+export async function disassembleCurrentInstruction(program: Program, nextBytesOfCode: Uint8Array, instructionAddress: number): Promise<Instruction> {
+  let instructionOfCapstone: Instruction | undefined;
   try {
-    instructionsOfCapstone = program.disassemblerInstance.disassemble(nextBytesOfCode, instructionAddress, 1);
+    instructionOfCapstone = traceSpan('capstone.decodeInstruction', () => program.disassemblerInstance.decodeInstruction(nextBytesOfCode, instructionAddress));
   } catch (e) {
     throw new Error(`Disassemble of Current Instruction failed: ${e}`);
   }
-  if (isJmpCallInstructionWORKAROUND(instructionsOfCapstone[0].operands.opcode)) {
-    return instructionsOfCapstone[0];
+  if (instructionOfCapstone === undefined) {
+    throw new Error(`Disassemble of Current Instruction failed: no valid instruction at address ${instructionAddress.toString(16)}`);
+  }
+  if (isJmpCallInstructionWORKAROUND(instructionOfCapstone.operands.opcode)) {
+    return instructionOfCapstone;
+  }
+  return injectNasmAssemblyIntoInstruction(instructionOfCapstone);
+}
+
+// Instructions of the demo programs are decoded at build time, all others are decoded by Capstone and ndisasm
+export default async function getCurrentInstruction(program: Program, nextBytesOfCode: Uint8Array, instructionAddressHex: string): Promise<Instruction> {
+  const instructionAddress: number = parseInt(instructionAddressHex, 16);
+  const prebuiltInstruction = getPrebuiltInstruction(nextBytesOfCode, instructionAddress);
+  if (prebuiltInstruction !== undefined) {
+    countTrace('getCurrentInstruction.prebuilt');
+    return prebuiltInstruction;
   }
-  return injectNasmAssemblyIntoInstruction(instructionsOfCapstone[0]);
+  return disassembleCurrentInstruction(program, nextBytesOfCode, instructionAddress);
 }
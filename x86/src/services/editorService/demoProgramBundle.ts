@@ -0,0 +1,315 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// This file is generated by scripts/buildDemoBundle.mjs (npm run build:demos), do not edit it by hand.
+
+import PrebuiltProgram from '@/services/interfaces/codeEditor/PrebuiltProgram';
+
+const demoProgramBundle: Array<PrebuiltProgram> = [
+  {
+    label: 'Add',
+    source: 'BITS 64\nmov rax, [0x0]\nmov rbx, [0x30]\nadd rbx, rax\nmov [0x20], rbx\n; Add',
+    codeAddress: 0x0,
+    machineCode: '488B042500000000488B1C25300000004801C348891C2520000000',
+    instructions: [
+      {
+        address: 0x0,
+        bytes: '488B042500000000',
+        capstoneAssembly: 'mov rax, qword ptr [0]',
+        nasmAssembly: 'mov rax, [0x0]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8b 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x0", "disp_offset": "0x4", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "rax", "size": "8", "access": "WRITE" }, {"type": "MEM", "size": "8", "access": "READ" }], "registers_modified": [ "rax"] }',
+      },
+      {
+        address: 0x8,
+        bytes: '488B1C2530000000',
+        capstoneAssembly: 'mov rbx, qword ptr [0x30]',
+        nasmAssembly: 'mov rbx, [0x30]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8b 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0x1c", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x30", "disp_offset": "0x4", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "rbx", "size": "8", "access": "WRITE" }, {"type": "MEM", "disp": "0x30", "size": "8", "access": "READ" }], "registers_modified": [ "rbx"] }',
+      },
+      {
+        address: 0x10,
+        bytes: '4801C3',
+        capstoneAssembly: 'add rbx, rax',
+        nasmAssembly: 'add rbx, rax',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x01 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0xc3", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "op_count": "2", "operands": [{"type": "REG", "value": "rbx", "size": "8", "access": "READ_WRITE" }, {"type": "REG", "value": "rax", "size": "8", "access": "READ" }], "registers_read": [ "rbx", "rax"], "registers_modified": [ "rflags", "rbx"], "EFLAGS": [ { "name": "AF", "access": "MOD" }, { "name": "CF", "access": "MOD" }, { "name": "SF", "access": "MOD" }, { "name": "ZF", "access": "MOD" }, { "name": "PF", "access": "MOD" }, { "name": "OF", "access": "MOD" }]  }',
+      },
+      {
+        address: 0x13,
+        bytes: '48891C2520000000',
+        capstoneAssembly: 'mov qword ptr [0x20], rbx',
+        nasmAssembly: 'mov [0x20], rbx',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x89 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0x1c", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x20", "disp_offset": "0x4", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "MEM", "disp": "0x20", "size": "8", "access": "WRITE" }, {"type": "REG", "value": "rbx", "size": "8", "access": "READ" }], "registers_read": [ "rbx"] }',
+      },
+    ],
+  },
+  {
+    label: 'Swap',
+    source: 'BITS 64\nSECTION .data\n\tfirstVar:\n\t\tdq 0x1337\n\totherVar:\n\t\tdq 0xcafe\n\nSECTION .text\n\tmov rax , [ firstVar ]\n\tmov rbx , [ otherVar ]\n\tmov [ firstVar ], rbx\n\tmov [ otherVar ], rax\n; Swap',
+    codeAddress: 0x0,
+    machineCode: '488B042520000000488B1C252800000048891C252000000048890425280000003713000000000000FECA000000000000',
+    instructions: [
+      {
+        address: 0x0,
+        bytes: '488B042520000000',
+        capstoneAssembly: 'mov rax, qword ptr [0x20]',
+        nasmAssembly: 'mov rax, [0x20]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8b 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x20", "disp_offset": "0x4", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "rax", "size": "8", "access": "WRITE" }, {"type": "MEM", "disp": "0x20", "size": "8", "access": "READ" }], "registers_modified": [ "rax"] }',
+      },
+      {
+        address: 0x8,
+        bytes: '488B1C2528000000',
+        capstoneAssembly: 'mov rbx, qword ptr [0x28]',
+        nasmAssembly: 'mov rbx, [0x28]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8b 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0x1c", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x28", "disp_offset": "0x4", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "rbx", "size": "8", "access": "WRITE" }, {"type": "MEM", "disp": "0x28", "size": "8", "access": "READ" }], "registers_modified": [ "rbx"] }',
+      },
+      {
+        address: 0x10,
+        bytes: '48891C2520000000',
+        capstoneAssembly: 'mov qword ptr [0x20], rbx',
+        nasmAssembly: 'mov [0x20], rbx',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x89 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0x1c", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x20", "disp_offset": "0x4", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "MEM", "disp": "0x20", "size": "8", "access": "WRITE" }, {"type": "REG", "value": "rbx", "size": "8", "access": "READ" }], "registers_read": [ "rbx"] }',
+      },
+      {
+        address: 0x18,
+        bytes: '4889042528000000',
+        capstoneAssembly: 'mov qword ptr [0x28], rax',
+        nasmAssembly: 'mov [0x28], rax',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x89 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x28", "disp_offset": "0x4", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "MEM", "disp": "0x28", "size": "8", "access": "WRITE" }, {"type": "REG", "value": "rax", "size": "8", "access": "READ" }], "registers_read": [ "rax"] }',
+      },
+    ],
+  },
+  {
+    label: 'Multiply',
+    source: 'BITS 64\nSECTION .text\n\tmov rax, 0x4E\n\tmov rbx, 0x3\n\tloop:\n\t\tadd rcx, rax\n\t\tdec rbx\n\t\tcmp rbx, 0\n\t\tjne loop\n\tmov [0x50], rcx\n\txor rax, rax\n\txor rcx, rcx\n; Multiply',
+    codeAddress: 0x0,
+    machineCode: 'B84E000000BB030000004801C148FFCB4883FB0075F448890C25500000004831C04831C9',
+    instructions: [
+      {
+        address: 0x0,
+        bytes: 'B84E000000',
+        capstoneAssembly: 'mov eax, 0x4e',
+        nasmAssembly: 'mov eax, 0x4e',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0xb8 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x0" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "imm_count": "1", "imms": [{ "imm": "0x4e", "imm_offset": "0x1", "imm_size": "0x4" } ] , "op_count": "2", "operands": [{"type": "REG", "value": "eax", "size": "4", "access": "WRITE" }, {"type": "IMM", "value": "0x4e", "size": "4" }], "registers_modified": [ "eax"] }',
+      },
+      {
+        address: 0x5,
+        bytes: 'BB03000000',
+        capstoneAssembly: 'mov ebx, 3',
+        nasmAssembly: 'mov ebx, 0x3',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0xbb 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x0" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "imm_count": "1", "imms": [{ "imm": "0x3", "imm_offset": "0x1", "imm_size": "0x4" } ] , "op_count": "2", "operands": [{"type": "REG", "value": "ebx", "size": "4", "access": "WRITE" }, {"type": "IMM", "value": "0x3", "size": "4" }], "registers_modified": [ "ebx"] }',
+      },
+      {
+        address: 0xA,
+        bytes: '4801C1',
+        capstoneAssembly: 'add rcx, rax',
+        nasmAssembly: 'add rcx, rax',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x01 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0xc1", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "op_count": "2", "operands": [{"type": "REG", "value": "rcx", "size": "8", "access": "READ_WRITE" }, {"type": "REG", "value": "rax", "size": "8", "access": "READ" }], "registers_read": [ "rcx", "rax"], "registers_modified": [ "rflags", "rcx"], "EFLAGS": [ { "name": "AF", "access": "MOD" }, { "name": "CF", "access": "MOD" }, { "name": "SF", "access": "MOD" }, { "name": "ZF", "access": "MOD" }, { "name": "PF", "access": "MOD" }, { "name": "OF", "access": "MOD" }]  }',
+      },
+      {
+        address: 0xD,
+        bytes: '48FFCB',
+        capstoneAssembly: 'dec rbx',
+        nasmAssembly: 'dec rbx',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0xff 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0xcb", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "op_count": "1", "operands": [{"type": "REG", "value": "rbx", "size": "8", "access": "READ_WRITE" }], "registers_read": [ "rbx"], "registers_modified": [ "rflags", "rbx"], "EFLAGS": [ { "name": "AF", "access": "MOD" }, { "name": "SF", "access": "MOD" }, { "name": "ZF", "access": "MOD" }, { "name": "PF", "access": "MOD" }, { "name": "OF", "access": "MOD" }]  }',
+      },
+      {
+        address: 0x10,
+        bytes: '4883FB00',
+        capstoneAssembly: 'cmp rbx, 0',
+        nasmAssembly: 'cmp rbx, byte +0x0',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x83 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0xfb", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "imm_count": "1", "imms": [{ "imm": "0x0", "imm_offset": "0x3", "imm_size": "0x1" } ] , "op_count": "2", "operands": [{"type": "REG", "value": "rbx", "size": "8", "access": "READ" }, {"type": "IMM", "value": "0x0", "size": "8" }], "registers_read": [ "rbx"], "registers_modified": [ "rflags"], "EFLAGS": [ { "name": "AF", "access": "MOD" }, { "name": "CF", "access": "MOD" }, { "name": "SF", "access": "MOD" }, { "name": "ZF", "access": "MOD" }, { "name": "PF", "access": "MOD" }, { "name": "OF", "access": "MOD" }]  }',
+      },
+      {
+        address: 0x14,
+        bytes: '75F4',
+        capstoneAssembly: 'jne 0xa',
+        nasmAssembly: 'jnz 0xfffffffffffffff6',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x75 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x0" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "imm_count": "1", "imms": [{ "imm": "0xa", "imm_offset": "0x1", "imm_size": "0x1" } ] , "op_count": "1", "operands": [{"type": "IMM", "value": "0xa", "size": "8" }], "registers_read": [ "rflags"], "EFLAGS": [ { "name": "ZF", "access": "TEST" }]  }',
+      },
+      {
+        address: 0x16,
+        bytes: '48890C2550000000',
+        capstoneAssembly: 'mov qword ptr [0x50], rcx',
+        nasmAssembly: 'mov [0x50], rcx',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x89 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0xc", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x50", "disp_offset": "0x4", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "MEM", "disp": "0x50", "size": "8", "access": "WRITE" }, {"type": "REG", "value": "rcx", "size": "8", "access": "READ" }], "registers_read": [ "rcx"] }',
+      },
+      {
+        address: 0x1E,
+        bytes: '4831C0',
+        capstoneAssembly: 'xor rax, rax',
+        nasmAssembly: 'xor rax, rax',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x31 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0xc0", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "op_count": "2", "operands": [{"type": "REG", "value": "rax", "size": "8", "access": "READ_WRITE" }, {"type": "REG", "value": "rax", "size": "8", "access": "READ" }], "registers_read": [ "rax"], "registers_modified": [ "rflags", "rax"], "EFLAGS": [ { "name": "SF", "access": "MOD" }, { "name": "ZF", "access": "MOD" }, { "name": "PF", "access": "MOD" }, { "name": "OF", "access": "RESET" }, { "name": "CF", "access": "RESET" }, { "name": "AF", "access": "UNDEF" }]  }',
+      },
+      {
+        address: 0x21,
+        bytes: '4831C9',
+        capstoneAssembly: 'xor rcx, rcx',
+        nasmAssembly: 'xor rcx, rcx',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x31 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0xc9", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "op_count": "2", "operands": [{"type": "REG", "value": "rcx", "size": "8", "access": "READ_WRITE" }, {"type": "REG", "value": "rcx", "size": "8", "access": "READ" }], "registers_read": [ "rcx"], "registers_modified": [ "rflags", "rcx"], "EFLAGS": [ { "name": "SF", "access": "MOD" }, { "name": "ZF", "access": "MOD" }, { "name": "PF", "access": "MOD" }, { "name": "OF", "access": "RESET" }, { "name": "CF", "access": "RESET" }, { "name": "AF", "access": "UNDEF" }]  }',
+      },
+    ],
+  },
+  {
+    label: 'Stack',
+    source: 'BITS 64\nSECTION .text\n\tpush 0x6\n\tpush qword [0x6]\n\tmov rax, qword [0x0]\n\tpush rax\n\tpop rbx\n\tpop qword [0x40]\n; Stack',
+    codeAddress: 0x0,
+    machineCode: '6A06FF342506000000488B042500000000505B8F042540000000',
+    instructions: [
+      {
+        address: 0x0,
+        bytes: '6A06',
+        capstoneAssembly: 'push 6',
+        nasmAssembly: 'push byte +0x6',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x6a 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x0" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "imm_count": "1", "imms": [{ "imm": "0x6", "imm_offset": "0x1", "imm_size": "0x1" } ] , "op_count": "1", "operands": [{"type": "IMM", "value": "0x6", "size": "8" }], "registers_read": [ "rsp"], "registers_modified": [ "rsp"] }',
+      },
+      {
+        address: 0x2,
+        bytes: 'FF342506000000',
+        capstoneAssembly: 'push qword ptr [6]',
+        nasmAssembly: 'push qword [0x6]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0xff 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x34", "modrm_offset": "0x1" }, "disp": { "disp_value": "0x6", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "1", "operands": [{"type": "MEM", "disp": "0x6", "size": "8", "access": "READ" }], "registers_read": [ "rsp"], "registers_modified": [ "rsp"] }',
+      },
+      {
+        address: 0x9,
+        bytes: '488B042500000000',
+        capstoneAssembly: 'mov rax, qword ptr [0]',
+        nasmAssembly: 'mov rax, [0x0]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8b 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x0", "disp_offset": "0x4", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "rax", "size": "8", "access": "WRITE" }, {"type": "MEM", "size": "8", "access": "READ" }], "registers_modified": [ "rax"] }',
+      },
+      {
+        address: 0x11,
+        bytes: '50',
+        capstoneAssembly: 'push rax',
+        nasmAssembly: 'push rax',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x50 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x0" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "op_count": "1", "operands": [{"type": "REG", "value": "rax", "size": "8", "access": "READ" }], "registers_read": [ "rsp", "rax"], "registers_modified": [ "rsp"] }',
+      },
+      {
+        address: 0x12,
+        bytes: '5B',
+        capstoneAssembly: 'pop rbx',
+        nasmAssembly: 'pop rbx',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x5b 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x0" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "op_count": "1", "operands": [{"type": "REG", "value": "rbx", "size": "8", "access": "WRITE" }], "registers_read": [ "rsp"], "registers_modified": [ "rsp", "rbx"] }',
+      },
+      {
+        address: 0x13,
+        bytes: '8F042540000000',
+        capstoneAssembly: 'pop qword ptr [0x40]',
+        nasmAssembly: 'pop qword [0x40]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8f 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x1" }, "disp": { "disp_value": "0x40", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "1", "operands": [{"type": "MEM", "disp": "0x40", "size": "8", "access": "WRITE" }], "registers_read": [ "rsp"], "registers_modified": [ "rsp"] }',
+      },
+    ],
+  },
+  {
+    label: 'Jump',
+    source: 'BITS 64\nJumpDestination:\n\tinc rax\n\tcmp rax, 3\n\tjne JumpDestination\n; Jump',
+    codeAddress: 0x0,
+    machineCode: '48FFC04883F80375F7',
+    instructions: [
+      {
+        address: 0x0,
+        bytes: '48FFC0',
+        capstoneAssembly: 'inc rax',
+        nasmAssembly: 'inc rax',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0xff 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0xc0", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "op_count": "1", "operands": [{"type": "REG", "value": "rax", "size": "8", "access": "READ_WRITE" }], "registers_read": [ "rax"], "registers_modified": [ "rflags", "rax"], "EFLAGS": [ { "name": "AF", "access": "MOD" }, { "name": "SF", "access": "MOD" }, { "name": "ZF", "access": "MOD" }, { "name": "PF", "access": "MOD" }, { "name": "OF", "access": "MOD" }]  }',
+      },
+      {
+        address: 0x3,
+        bytes: '4883F803',
+        capstoneAssembly: 'cmp rax, 3',
+        nasmAssembly: 'cmp rax, byte +0x3',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x83 0x00 0x00 0x00 ", "rex": "0x48", "addr_size": "8", "modrm": { "modrm_value": "0xf8", "modrm_offset": "0x2" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "imm_count": "1", "imms": [{ "imm": "0x3", "imm_offset": "0x3", "imm_size": "0x1" } ] , "op_count": "2", "operands": [{"type": "REG", "value": "rax", "size": "8", "access": "READ" }, {"type": "IMM", "value": "0x3", "size": "8" }], "registers_read": [ "rax"], "registers_modified": [ "rflags"], "EFLAGS": [ { "name": "AF", "access": "MOD" }, { "name": "CF", "access": "MOD" }, { "name": "SF", "access": "MOD" }, { "name": "ZF", "access": "MOD" }, { "name": "PF", "access": "MOD" }, { "name": "OF", "access": "MOD" }]  }',
+      },
+      {
+        address: 0x7,
+        bytes: '75F7',
+        capstoneAssembly: 'jne 0',
+        nasmAssembly: 'jnz 0xfffffffffffffff9',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x75 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x0" }, "disp": { "disp_value": "0x0" }, "sib": { "sib_value": "0x0" }, "imm_count": "1", "imms": [{ "imm": "0x0", "imm_offset": "0x1", "imm_size": "0x1" } ] , "op_count": "1", "operands": [{"type": "IMM", "value": "0x0", "size": "8" }], "registers_read": [ "rflags"], "EFLAGS": [ { "name": "ZF", "access": "TEST" }]  }',
+      },
+    ],
+  },
+  {
+    label: 'Surprise',
+    source: 'BITS 64\nmov al, [0x74]\nmov al, [0x78]\nmov al, [0x96]\nmov al, [0xA4]\nmov al, [0xB5]\nmov al, [0xC6]\nmov al, [0xB7]\nmov al, [0xA8]\n; Surprise',
+    codeAddress: 0x0,
+    machineCode: '8A0425740000008A0425780000008A0425960000008A0425A40000008A0425B50000008A0425C60000008A0425B70000008A0425A8000000',
+    instructions: [
+      {
+        address: 0x0,
+        bytes: '8A042574000000',
+        capstoneAssembly: 'mov al, byte ptr [0x74]',
+        nasmAssembly: 'mov al, [0x74]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8a 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x1" }, "disp": { "disp_value": "0x74", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "al", "size": "1", "access": "WRITE" }, {"type": "MEM", "disp": "0x74", "size": "1", "access": "READ" }], "registers_modified": [ "al"] }',
+      },
+      {
+        address: 0x7,
+        bytes: '8A042578000000',
+        capstoneAssembly: 'mov al, byte ptr [0x78]',
+        nasmAssembly: 'mov al, [0x78]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8a 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x1" }, "disp": { "disp_value": "0x78", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "al", "size": "1", "access": "WRITE" }, {"type": "MEM", "disp": "0x78", "size": "1", "access": "READ" }], "registers_modified": [ "al"] }',
+      },
+      {
+        address: 0xE,
+        bytes: '8A042596000000',
+        capstoneAssembly: 'mov al, byte ptr [0x96]',
+        nasmAssembly: 'mov al, [0x96]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8a 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x1" }, "disp": { "disp_value": "0x96", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "al", "size": "1", "access": "WRITE" }, {"type": "MEM", "disp": "0x96", "size": "1", "access": "READ" }], "registers_modified": [ "al"] }',
+      },
+      {
+        address: 0x15,
+        bytes: '8A0425A4000000',
+        capstoneAssembly: 'mov al, byte ptr [0xa4]',
+        nasmAssembly: 'mov al, [0xa4]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8a 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x1" }, "disp": { "disp_value": "0xa4", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "al", "size": "1", "access": "WRITE" }, {"type": "MEM", "disp": "0xa4", "size": "1", "access": "READ" }], "registers_modified": [ "al"] }',
+      },
+      {
+        address: 0x1C,
+        bytes: '8A0425B5000000',
+        capstoneAssembly: 'mov al, byte ptr [0xb5]',
+        nasmAssembly: 'mov al, [0xb5]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8a 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x1" }, "disp": { "disp_value": "0xb5", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "al", "size": "1", "access": "WRITE" }, {"type": "MEM", "disp": "0xb5", "size": "1", "access": "READ" }], "registers_modified": [ "al"] }',
+      },
+      {
+        address: 0x23,
+        bytes: '8A0425C6000000',
+        capstoneAssembly: 'mov al, byte ptr [0xc6]',
+        nasmAssembly: 'mov al, [0xc6]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8a 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x1" }, "disp": { "disp_value": "0xc6", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "al", "size": "1", "access": "WRITE" }, {"type": "MEM", "disp": "0xc6", "size": "1", "access": "READ" }], "registers_modified": [ "al"] }',
+      },
+      {
+        address: 0x2A,
+        bytes: '8A0425B7000000',
+        capstoneAssembly: 'mov al, byte ptr [0xb7]',
+        nasmAssembly: 'mov al, [0xb7]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8a 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x1" }, "disp": { "disp_value": "0xb7", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "al", "size": "1", "access": "WRITE" }, {"type": "MEM", "disp": "0xb7", "size": "1", "access": "READ" }], "registers_modified": [ "al"] }',
+      },
+      {
+        address: 0x31,
+        bytes: '8A0425A8000000',
+        capstoneAssembly: 'mov al, byte ptr [0xa8]',
+        nasmAssembly: 'mov al, [0xa8]',
+        detail: '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0x8a 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x4", "modrm_offset": "0x1" }, "disp": { "disp_value": "0xa8", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "2", "operands": [{"type": "REG", "value": "al", "size": "1", "access": "WRITE" }, {"type": "MEM", "disp": "0xa8", "size": "1", "access": "READ" }], "registers_modified": [ "al"] }',
+      },
+    ],
+  },
+];
+export default demoProgramBundle;
@@ -0,0 +1,100 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import demoProgramBundle from '@/services/editorService/demoProgramBundle';
+import PrebuiltProgram, { PrebuiltInstruction } from '@/services/interfaces/codeEditor/PrebuiltProgram';
+import Instruction from '@/services/interfaces/Instruction';
+import fillAddress from '@/services/helper/htmlIdService';
+import { dataStringsToCurrentInstructionBytes } from '@/services/dataServices/byteService';
+import getInstructionInformationFromCapstone from '@/services/disassembler/instructionOperandsService';
+import isJmpCallInstructionWORKAROUND from '@/services/disassembler/jumpInstructionService';
+
+interface IndexedInstruction {
+  prebuiltInstruction: PrebuiltInstruction;
+  bytes: Uint8Array;
+}
+
+let programsBySource: Map<string, PrebuiltProgram> | undefined;
+
+let instructionsByAddress: Map<number, Array<IndexedInstruction>> | undefined;
+
+function hexStringToByteStrings(hex: string): Array<string> {
+  return hex.match(/.{2}/g) || [];
+}
+
+function hexStringToUInt8Array(hex: string): Uint8Array {
+  return Uint8Array.from(hexStringToByteStrings(hex), (byte) => parseInt(byte, 16));
+}
+
+function indexPrebuiltPrograms() {
+  programsBySource = new Map();
+  instructionsByAddress = new Map();
+  demoProgramBundle.forEach((program) => {
+    programsBySource?.set(program.source, program);
+    program.instructions.forEach((prebuiltInstruction) => {
+      const instructions = instructionsByAddress?.get(prebuiltInstruction.address) || [];
+      instructions.push({ prebuiltInstruction, bytes: hexStringToUInt8Array(prebuiltInstruction.bytes) });
+      instructionsByAddress?.set(prebuiltInstruction.address, instructions);
+    });
+  });
+}
+
+function startsWith(bytes: Uint8Array, prefix: Uint8Array): boolean {
+  if (bytes.length < prefix.length) {
+    return false;
+  }
+  return prefix.every((byte, index) => bytes[index] === byte);
+}
+
+/**
+ * Returns the machine code NASM would assemble from the source, if the source is one of the prebuilt demo programs.
+ */
+export function getPrebuiltMachineCode(source: string): Uint8Array | undefined {
+  if (programsBySource === undefined) {
+    indexPrebuiltPrograms();
+  }
+  const program = programsBySource?.get(source);
+  return program ? hexStringToUInt8Array(program.machineCode) : undefined;
+}
+
+/**
+ * Returns the instruction getCurrentInstruction would decode from the bytes at the address, if the same bytes
+ * at the same address are part of a prebuilt demo program. Self-modified code does not match and is decoded as usual.
+ */
+export function getPrebuiltInstruction(nextBytesOfCode: Uint8Array, instructionAddress: number): Instruction | undefined {
+  if (instructionsByAddress === undefined) {
+    indexPrebuiltPrograms();
+  }
+  const match = instructionsByAddress?.get(instructionAddress)?.find((instruction) => startsWith(nextBytesOfCode, instruction.bytes));
+  if (match === undefined) {
+    return undefined;
+  }
+  const { prebuiltInstruction } = match;
+  const operands = getInstructionInformationFromCapstone(prebuiltInstruction.detail);
+  return {
+    assemblyInterpretation: isJmpCallInstructionWORKAROUND(operands.opcode) ? prebuiltInstruction.capstoneAssembly : prebuiltInstruction.nasmAssembly,
+    length: match.bytes.length,
+    content: dataStringsToCurrentInstructionBytes(hexStringToByteStrings(prebuiltInstruction.bytes)),
+    address: fillAddress(prebuiltInstruction.address),
+    operands,
+  };
+}
@@ -0,0 +1,254 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* eslint no-bitwise: 0 */
+import Breakpoint from '@/services/interfaces/debugger/Breakpoint';
+import Watchpoint from '@/services/interfaces/debugger/Watchpoint';
+import { selectableMemoryMaps } from '@/services/dataServices/memoryMapService';
+
+export interface SharedProgram {
+  source: string;
+  machineCode: Array<number>;
+  breakpoints?: Array<Breakpoint>;
+  watchpoints?: Array<Watchpoint>;
+  // name of one of the selectableMemoryMaps, the default map if undefined
+  memoryMap?: string;
+}
+
+// Layout of a share code before it is encoded with base64url:
+//   version (1 byte), flags (1 byte),
+//   index of the memory map in selectableMemoryMaps (1 byte, only with shareFlagMemoryMap),
+//   length of the machine code (varint), machine code,
+//   source, breakpoints and watchpoints as JSON, deflated if the browser supports it
+// The machine code and the memory map are stored uncompressed, so the simulator can start without inflating the source.
+export const shareFormatVersion = 1;
+
+const shareFlagDeflated = 1;
+
+const shareFlagMemoryMap = 2;
+
+const compressionFormat = 'deflate-raw';
+
+interface TransformByteStream {
+  readable: ReadableStream<Uint8Array>;
+  writable: WritableStream<Uint8Array>;
+}
+
+interface TransformStreamConstructor {
+  new(format: string): TransformByteStream;
+}
+
+const streams = globalThis as unknown as {
+  CompressionStream?: TransformStreamConstructor;
+  DecompressionStream?: TransformStreamConstructor;
+};
+
+// Browsers without deflate-raw throw when the stream is constructed
+function createTransformStream(Transformer?: TransformStreamConstructor): TransformByteStream | undefined {
+  if (!Transformer) {
+    return undefined;
+  }
+  try {
+    return new Transformer(compressionFormat);
+  } catch {
+    return undefined;
+  }
+}
+
+async function readChunks(readable: ReadableStream<Uint8Array>): Promise<Array<Uint8Array>> {
+  const chunks: Array<Uint8Array> = [];
+  const reader = readable.getReader();
+  let result = await reader.read();
+  while (!result.done) {
+    chunks.push(result.value);
+    result = await reader.read();
+  }
+  return chunks;
+}
+
+async function transformBytes(bytes: Uint8Array, stream: TransformByteStream): Promise<Uint8Array> {
+  const writer = stream.writable.getWriter();
+  // the readable side is drained meanwhile, otherwise the backpressure of the stream blocks the write
+  const [, chunks] = await Promise.all([
+    writer.write(bytes).then(() => writer.close()),
+    readChunks(stream.readable),
+  ]);
+
+  const transformed = new Uint8Array(chunks.reduce((length, chunk) => length + chunk.length, 0));
+  chunks.reduce((offset, chunk) => {
+    transformed.set(chunk, offset);
+    return offset + chunk.length;
+  }, 0);
+  return transformed;
+}
+
+function writeVarint(bytes: Array<number>, value: number) {
+  let remaining = value;
+  while (remaining >= 0x80) {
+    bytes.push((remaining & 0x7F) | 0x80);
+    remaining = Math.floor(remaining / 0x80);
+  }
+  bytes.push(remaining);
+}
+
+function readVarint(bytes: Uint8Array, offset: number): { value: number; offset: number } {
+  let value = 0;
+  let factor = 1;
+  let position = offset;
+  for (;;) {
+    if (position >= bytes.length) {
+      throw new RangeError('The share code is truncated.');
+    }
+    const byte = bytes[position];
+    position += 1;
+    value += (byte & 0x7F) * factor;
+    if ((byte & 0x80) === 0) {
+      return { value, offset: position };
+    }
+    factor *= 0x80;
+  }
+}
+
+function toBase64Url(bytes: Uint8Array): string {
+  let binary = '';
+  bytes.forEach((byte) => {
+    binary += String.fromCharCode(byte);
+  });
+  return btoa(binary).replace(/\+/g, '-').replace(/\//g, '_').replace(/=+$/, '');
+}
+
+function fromBase64Url(shareCode: string): Uint8Array {
+  const base64 = shareCode.replace(/-/g, '+').replace(/_/g, '/');
+  const binary = atob(base64.padEnd(Math.ceil(base64.length / 4) * 4, '='));
+  return Uint8Array.from(binary, (character) => character.charCodeAt(0));
+}
+
+interface ShareCodeSections {
+  flags: number;
+  memoryMap?: string;
+  machineCode: Array<number>;
+  text: Uint8Array;
+}
+
+function readShareCode(shareCode: string): ShareCodeSections {
+  const bytes = fromBase64Url(shareCode);
+  if (bytes.length < 2 || bytes[0] !== shareFormatVersion) {
+    throw new Error(`Share code version ${bytes[0]} is not supported.`);
+  }
+  const flags = bytes[1];
+  let memoryMap: string | undefined;
+  let machineCodeOffset = 2;
+  if ((flags & shareFlagMemoryMap) !== 0) {
+    const selectable = selectableMemoryMaps[bytes[machineCodeOffset]];
+    if (selectable === undefined) {
+      throw new RangeError('The memory map of the share code is not supported.');
+    }
+    memoryMap = selectable.name;
+    machineCodeOffset += 1;
+  }
+  const { value: machineCodeLength, offset } = readVarint(bytes, machineCodeOffset);
+  if (machineCodeLength === 0 || offset + machineCodeLength > bytes.length) {
+    throw new RangeError('The machine code of the share code is invalid.');
+  }
+  return {
+    flags,
+    memoryMap,
+    machineCode: Array.from(bytes.subarray(offset, offset + machineCodeLength)),
+    text: bytes.subarray(offset + machineCodeLength),
+  };
+}
+
+export async function encodeSharedProgram(sharedProgram: SharedProgram): Promise<string> {
+  const { source, breakpoints, watchpoints } = sharedProgram;
+  let text = new TextEncoder().encode(JSON.stringify({ source, breakpoints, watchpoints }));
+  let flags = 0;
+  const compression = createTransformStream(streams.CompressionStream);
+  if (compression) {
+    text = await transformBytes(text, compression);
+    flags |= shareFlagDeflated;
+  }
+
+  const header: Array<number> = [shareFormatVersion, flags];
+  const memoryMapIndex = selectableMemoryMaps.findIndex((selectable) => selectable.name === sharedProgram.memoryMap);
+  if (memoryMapIndex > 0) {
+    header[1] |= shareFlagMemoryMap;
+    header.push(memoryMapIndex);
+  }
+  writeVarint(header, sharedProgram.machineCode.length);
+  const bytes = new Uint8Array(header.length + sharedProgram.machineCode.length + text.length);
+  bytes.set(header);
+  bytes.set(sharedProgram.machineCode, header.length);
+  bytes.set(text, header.length + sharedProgram.machineCode.length);
+  return toBase64Url(bytes);
+}
+
+// What the simulator needs to start the emulator, read without inflating the source
+export interface SharedEmulatorStart {
+  machineCode: Array<number>;
+  memoryMap?: string;
+}
+
+export function decodeSharedMachineCode(shareCode: string): Array<number> {
+  return readShareCode(shareCode).machineCode;
+}
+
+export function decodeSharedMemoryMap(shareCode: string): string | undefined {
+  return readShareCode(shareCode).memoryMap;
+}
+
+async function inflateSharedProgram(sections: ShareCodeSections): Promise<SharedProgram> {
+  const {
+    flags, memoryMap, machineCode, text,
+  } = sections;
+  let textBytes = text;
+  if ((flags & shareFlagDeflated) !== 0) {
+    const decompression = createTransformStream(streams.DecompressionStream);
+    if (!decompression) {
+      throw new Error('This browser cannot decompress the shared program.');
+    }
+    textBytes = await transformBytes(text, decompression);
+  }
+  const { source, breakpoints, watchpoints } = JSON.parse(new TextDecoder().decode(textBytes));
+  if (typeof source !== 'string') {
+    throw new TypeError('The share code does not contain a source.');
+  }
+  return {
+    source,
+    machineCode,
+    breakpoints: Array.isArray(breakpoints) ? breakpoints : undefined,
+    watchpoints: Array.isArray(watchpoints) ? watchpoints : undefined,
+    ...(memoryMap !== undefined ? { memoryMap } : {}),
+  };
+}
+
+export async function decodeSharedProgram(shareCode: string): Promise<SharedProgram> {
+  return inflateSharedProgram(readShareCode(shareCode));
+}
+
+// Reads the share code once: the emulator start is available at once, the program once its source is inflated
+export function decodeShareCode(shareCode: string): { emulatorStart: SharedEmulatorStart; program: Promise<SharedProgram> } {
+  const sections = readShareCode(shareCode);
+  return {
+    emulatorStart: { machineCode: sections.machineCode, memoryMap: sections.memoryMap },
+    program: inflateSharedProgram(sections),
+  };
+}
@@ -51,11 +51,13 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 /* eslint-disable */
 import Instruction from "@/services/interfaces/Instruction";
-// @ts-ignore
-import Module from '../../../lib/libunicorn-x86.out';
 /* eslint-enable */
 import { RegisterID, registerSize, eUC } from './emulatorEnums';
 import EmulatorHook from '../interfaces/EmulatorHook';
+import RunToReturn from '../interfaces/RunToReturn';
+import { traceCcall } from '../helper/traceService';
+import { loadEngine } from '../helper/engineModuleService';
+import { diffMemory, searchMemory } from '../helper/memoryScanHelper';
 
 /* eslint camelcase: 0 */
 /* eslint no-underscore-dangle: 0 */
@@ -93,6 +95,14 @@ class Unicorn {
 
     // eslint-disable-next-line @typescript-eslint/no-explicit-any
     addFunction: (callback: any, signature: string) => any;
+
+    HEAPU8: Uint8Array;
+
+    // only contained in engine builds with cpusim_memscan.c (libraryPatches/buildUnicornJS.txt)
+    _cpusim_mem_diff?: (live: number, snapshot: number, length: number, address: number, ranges: number, maxRanges: number) => number;
+
+    _cpusim_mem_search?: (memory: number, length: number, address: number, pattern: number, patternLength: number,
+      alignment: number, matches: number, maxMatches: number) => number;
   };
 
   uc = {
@@ -104,6 +114,18 @@ class Unicorn {
 
   private ucHandle_ptr!: number;
 
+  // buffer of instruction_pointer_read, allocated with the first call and freed with the emulator
+  private instructionPointer_ptr = 0;
+
+  // buffers of register_read_batch, kept while the same registers are read and freed with the emulator
+  private registerBatch?: {
+    registerIDs: Array<RegisterID>;
+    ids_ptr: number;
+    pointers_ptr: number;
+    values_ptr: number;
+    bytes: number;
+  };
+
   // DON'T FORGET FREE :)
   private malloc_pointerToData(bytes: number): number {
     return this.MUnicorn._malloc(bytes);
@@ -113,14 +135,14 @@ class Unicorn {
   private mallocToZero_pointerToData(sizeInBytes: number): number {
     const pointerToData = this.malloc_pointerToData(sizeInBytes);
     // initialize data to zero
-    for (let i = 0; i < sizeInBytes; i++) {
-      this.MUnicorn.setValue(pointerToData + i, 0, 'i8');
-    }
+    this.MUnicorn.HEAPU8.fill(0, pointerToData, pointerToData + sizeInBytes);
     return pointerToData;
   }
 
   async initialiseEmulator() {
+    const Module = await loadEngine('unicorn');
     this.MUnicorn = await Module();
+    this.MUnicorn.ccall = traceCcall('unicorn', this.MUnicorn.ccall);
 
     this.ucHandle_ptr = this.mallocToZero_pointerToData(4);
 
@@ -178,18 +200,22 @@ class Unicorn {
   }
 
   private getData(pointer: number, bytes: number): Uint8Array {
-    const data = new Uint8Array(bytes);
-    for (let i = 0; i < bytes; i++) {
-      data[i] = this.MUnicorn.getValue(pointer + i, 'i8');
-    }
-    return data;
+    return this.MUnicorn.HEAPU8.slice(pointer, pointer + bytes);
   }
 
   memory_read(address: number, bytes: number): Uint8Array {
     // Allocate space for the output value
     const buffer_ptr = this.mallocToZero_pointerToData(bytes);
 
-    // Read from memory
+    try {
+      this.memory_read_to_heap(address, buffer_ptr, bytes);
+      return this.getData(buffer_ptr, bytes);
+    } finally {
+      this.MUnicorn._free(buffer_ptr);
+    }
+  }
+
+  private memory_read_to_heap(address: number, buffer_ptr: number, bytes: number) {
     const handle = this.MUnicorn.getValue(this.ucHandle_ptr, '*');
     const ret = this.MUnicorn.ccall(
       'uc_mem_read',
@@ -197,15 +223,69 @@ class Unicorn {
       ['pointer', 'number', 'number', 'pointer', 'number'],
       [handle, address, 0, buffer_ptr, bytes],
     );
-
-    // Get register value, free memory and handle return code
-    const data = this.getData(buffer_ptr, bytes);
-
-    this.MUnicorn._free(buffer_ptr);
     if (ret !== this.uc.ERR_OK) {
       throw new Error(`Unicorn.js: Function uc_mem_read failed with code ${ret}:\n${this.strerror(ret)}`);
     }
-    return data;
+  }
+
+  // Scans run on a copy of the guest memory in the heap, the results are collected in a second heap buffer.
+  // With engine builds without cpusim_memscan.c the same scan runs in JS on the copy.
+  private memory_scan(address: number, bytes: number, inputBytes: Uint8Array,
+    nativeScan: ((memory_ptr: number, input_ptr: number, results_ptr: number, maxResults: number) => number) | undefined,
+    scan: (memory: Uint8Array) => Uint32Array, valuesPerResult: number, maxResults: number): Uint32Array {
+    const memory_ptr = this.malloc_pointerToData(bytes + inputBytes.length);
+    const input_ptr = memory_ptr + bytes;
+    try {
+      this.memory_read_to_heap(address, memory_ptr, bytes);
+      if (nativeScan === undefined) {
+        return scan(this.MUnicorn.HEAPU8.subarray(memory_ptr, memory_ptr + bytes));
+      }
+      this.MUnicorn.HEAPU8.set(inputBytes, input_ptr);
+      let capacity = maxResults;
+      for (;;) {
+        const results_ptr = this.malloc_pointerToData(capacity * valuesPerResult * 4);
+        try {
+          const count = nativeScan(memory_ptr, input_ptr, results_ptr, capacity);
+          // the count is exact, so a second scan is enough if the results did not fit
+          if (count <= capacity) {
+            return new Uint32Array(this.MUnicorn.HEAPU8.slice(results_ptr, results_ptr + count * valuesPerResult * 4).buffer);
+          }
+          capacity = count;
+        } finally {
+          this.MUnicorn._free(results_ptr);
+        }
+      }
+    } finally {
+      this.MUnicorn._free(memory_ptr);
+    }
+  }
+
+  // Pairs of start and end address (exclusive) of the bytes which changed since the snapshot was read at address
+  memory_diff(address: number, snapshot: Uint8Array, maxRanges = 1024): Uint32Array {
+    const diff = this.MUnicorn._cpusim_mem_diff;
+    return this.memory_scan(
+      address,
+      snapshot.length,
+      snapshot,
+      diff && ((memory_ptr, snapshot_ptr, ranges_ptr, capacity) => diff(memory_ptr, snapshot_ptr, snapshot.length, address, ranges_ptr, capacity)),
+      (memory) => diffMemory(memory, snapshot, address),
+      2,
+      maxRanges,
+    );
+  }
+
+  // Addresses of the pattern within bytes from address, only at multiples of alignment
+  memory_search(address: number, bytes: number, pattern: Uint8Array, alignment = 1, maxMatches = 1024): Uint32Array {
+    const search = this.MUnicorn._cpusim_mem_search;
+    return this.memory_scan(
+      address,
+      bytes,
+      pattern,
+      search && ((memory_ptr, pattern_ptr, matches_ptr, capacity) => search(memory_ptr, bytes, address, pattern_ptr, pattern.length, alignment, matches_ptr, capacity)),
+      (memory) => searchMemory(memory, address, pattern, alignment),
+      1,
+      maxMatches,
+    );
   }
 
   close() {
@@ -215,6 +295,20 @@ class Unicorn {
       throw new Error(`Unicorn.js: Function uc_close failed with code ${ret}:\n${this.strerror(ret)}`);
     }
     this.MUnicorn._free(this.ucHandle_ptr);
+    if (this.instructionPointer_ptr !== 0) {
+      this.MUnicorn._free(this.instructionPointer_ptr);
+      this.instructionPointer_ptr = 0;
+    }
+    this.freeRegisterBatch();
+  }
+
+  private freeRegisterBatch() {
+    if (this.registerBatch !== undefined) {
+      this.MUnicorn._free(this.registerBatch.ids_ptr);
+      this.MUnicorn._free(this.registerBatch.pointers_ptr);
+      this.MUnicorn._free(this.registerBatch.values_ptr);
+      this.registerBatch = undefined;
+    }
   }
 
   static getInstructionAddressEnd(instruction: Instruction): string {
@@ -225,8 +319,36 @@ class Unicorn {
     return `0x${address}`;
   }
 
-  executeInstruction(instruction: Instruction) {
+  // Returns false if a run to return of the instruction ended before a return was reached
+  executeInstruction(instruction: Instruction): boolean {
+    if (instruction.runToReturn) {
+      return this.runToReturn(parseInt(instruction.address.address, 16), instruction.runToReturn);
+    }
     this.emu_start(`0x${instruction.address.address}`, Unicorn.getInstructionAddressEnd(instruction), 0, 1);
+    return true;
+  }
+
+  // Runs from begin until the return condition holds. The code hooks only cover the return addresses,
+  // so the emulator is interrupted there and not for the other instructions of the run.
+  // Returns false if the run ended before a return was reached.
+  runToReturn(begin: number, condition: RunToReturn): boolean {
+    let returned = false;
+    const stopAtReturn = () => {
+      if (this.register_read_number(RegisterID.RSP) >= condition.stackPointer) {
+        returned = true;
+        this.emu_stop();
+      }
+    };
+    const hooks = condition.returnAddresses.map((address) => this.hook_add(eUC.HOOK_CODE, stopAtReturn, {}, address, address, 0));
+    try {
+      this.emu_start(begin, condition.endAddress, 0, condition.instructionLimit);
+    } finally {
+      hooks.forEach((hook) => this.hook_del(hook));
+    }
+    if (returned && condition.executeReturn) {
+      this.emu_start(this.register_read_number(RegisterID.RIP), condition.endAddress, 0, 1);
+    }
+    return returned;
   }
 
   // eslint-disable-next-line @typescript-eslint/no-explicit-any
@@ -243,11 +365,85 @@ class Unicorn {
     }
   }
 
+  emu_stop() {
+    const handle = this.MUnicorn.getValue(this.ucHandle_ptr, '*');
+    const ret = this.MUnicorn.ccall('uc_emu_stop', 'number', ['pointer'], [handle]);
+    if (ret !== this.uc.ERR_OK) {
+      throw new Error(`Unicorn.js: Function uc_emu_stop failed with code ${ret}:\n${this.strerror(ret)}`);
+    }
+  }
+
   // eslint-disable-next-line @typescript-eslint/no-explicit-any
   register_read(registerID: RegisterID) {
     return this.register_read_length(registerID, registerSize(registerID));
   }
 
+  // Reads the register as little endian number, the simulated addresses fit into 48 bits
+  register_read_number(registerID: RegisterID): number {
+    const registerData = this.register_read(registerID);
+    let value = 0;
+    for (let i = Math.min(registerData.length, 6) - 1; i >= 0; i--) {
+      value = value * 0x100 + registerData[i];
+    }
+    return value;
+  }
+
+  // Lower 32 bits of RIP, read without allocating, so memory hooks can call it with every access
+  instruction_pointer_read(): number {
+    if (this.instructionPointer_ptr === 0) {
+      this.instructionPointer_ptr = this.mallocToZero_pointerToData(8);
+    }
+    const handle = this.MUnicorn.getValue(this.ucHandle_ptr, '*');
+    const ret = this.MUnicorn.ccall('uc_reg_read', 'number', ['pointer', 'number', 'pointer'], [handle, RegisterID.RIP, this.instructionPointer_ptr]);
+    if (ret !== this.uc.ERR_OK) {
+      throw new Error(`Unicorn.js: Function uc_reg_read failed with code ${ret}:\n${this.strerror(ret)}`);
+    }
+    return this.MUnicorn.getValue(this.instructionPointer_ptr, 'i32') >>> 0;
+  }
+
+  private prepareRegisterBatch(registerIDs: Array<RegisterID>) {
+    const batch = this.registerBatch;
+    if (batch !== undefined && batch.registerIDs.length === registerIDs.length
+      && batch.registerIDs.every((registerID, index) => registerID === registerIDs[index])) {
+      return batch;
+    }
+    this.freeRegisterBatch();
+    // every value gets a zeroed slot of 8 byte multiples, the bytes above the register size stay zero
+    const slots = registerIDs.map((registerID) => Math.ceil(registerSize(registerID) / 8) * 8);
+    const bytes = slots.reduce((sum, slot) => sum + slot, 0);
+    const ids_ptr = this.malloc_pointerToData(registerIDs.length * 4);
+    const pointers_ptr = this.malloc_pointerToData(registerIDs.length * 4);
+    const values_ptr = this.mallocToZero_pointerToData(bytes);
+    let offset = 0;
+    registerIDs.forEach((registerID, index) => {
+      this.MUnicorn.setValue(ids_ptr + index * 4, registerID, 'i32');
+      this.MUnicorn.setValue(pointers_ptr + index * 4, values_ptr + offset, '*');
+      offset += slots[index];
+    });
+    this.registerBatch = {
+      registerIDs: [...registerIDs], ids_ptr, pointers_ptr, values_ptr, bytes,
+    };
+    return this.registerBatch;
+  }
+
+  // Reads the registers with a single uc_reg_read_batch call and without allocating, so code hooks can call it with
+  // every instruction. The registers follow each other in slots of 8 byte multiples (little endian), the returned view
+  // is overwritten by the next call.
+  register_read_batch(registerIDs: Array<RegisterID>): Uint8Array {
+    const batch = this.prepareRegisterBatch(registerIDs);
+    const handle = this.MUnicorn.getValue(this.ucHandle_ptr, '*');
+    const ret = this.MUnicorn.ccall(
+      'uc_reg_read_batch',
+      'number',
+      ['pointer', 'pointer', 'pointer', 'number'],
+      [handle, batch.ids_ptr, batch.pointers_ptr, registerIDs.length],
+    );
+    if (ret !== this.uc.ERR_OK) {
+      throw new Error(`Unicorn.js: Function uc_reg_read_batch failed with code ${ret}:\n${this.strerror(ret)}`);
+    }
+    return this.MUnicorn.HEAPU8.subarray(batch.values_ptr, batch.values_ptr + batch.bytes);
+  }
+
   // eslint-disable-next-line @typescript-eslint/no-explicit-any
   register_read_length(registerID: RegisterID, bytes: number) {
     // Allocate space for the output value
@@ -302,6 +498,53 @@ class Unicorn {
     }
   }
 
+  // The context (uc_context) starts with its size, followed by the CPU state saved by uc_context_save.
+  // It can only be restored by an emulator of the same library build.
+  context_save(): Uint8Array {
+    const handle = this.MUnicorn.getValue(this.ucHandle_ptr, '*');
+    const context_ptr = this.allocateContext(handle);
+    try {
+      const ret = this.MUnicorn.ccall('uc_context_save', 'number', ['pointer', 'pointer'], [handle, context_ptr]);
+      if (ret !== this.uc.ERR_OK) {
+        throw new Error(`Unicorn.js: Function uc_context_save failed with code ${ret}:\n${this.strerror(ret)}`);
+      }
+      const contextSize = this.MUnicorn.getValue(context_ptr, 'i32');
+      return this.MUnicorn.HEAPU8.slice(context_ptr, context_ptr + 4 + contextSize);
+    } finally {
+      this.MUnicorn.ccall('uc_free', 'number', ['pointer'], [context_ptr]);
+    }
+  }
+
+  context_restore(context: Uint8Array) {
+    const handle = this.MUnicorn.getValue(this.ucHandle_ptr, '*');
+    const context_ptr = this.allocateContext(handle);
+    try {
+      const contextSize = this.MUnicorn.getValue(context_ptr, 'i32');
+      if (context.length !== 4 + contextSize) {
+        throw new Error(`Unicorn.js: The context has ${context.length} bytes, the emulator expects ${4 + contextSize} bytes.`);
+      }
+      this.MUnicorn.HEAPU8.set(context, context_ptr);
+      const ret = this.MUnicorn.ccall('uc_context_restore', 'number', ['pointer', 'pointer'], [handle, context_ptr]);
+      if (ret !== this.uc.ERR_OK) {
+        throw new Error(`Unicorn.js: Function uc_context_restore failed with code ${ret}:\n${this.strerror(ret)}`);
+      }
+    } finally {
+      this.MUnicorn.ccall('uc_free', 'number', ['pointer'], [context_ptr]);
+    }
+  }
+
+  // DON'T FORGET FREE (uc_free) :)
+  private allocateContext(handle: number): number {
+    const contextPointer_ptr = this.malloc_pointerToData(4);
+    const ret = this.MUnicorn.ccall('uc_context_alloc', 'number', ['pointer', 'pointer'], [handle, contextPointer_ptr]);
+    const context_ptr = this.MUnicorn.getValue(contextPointer_ptr, '*');
+    this.MUnicorn._free(contextPointer_ptr);
+    if (ret !== this.uc.ERR_OK) {
+      throw new Error(`Unicorn.js: Function uc_context_alloc failed with code ${ret}:\n${this.strerror(ret)}`);
+    }
+    return context_ptr;
+  }
+
   // eslint-disable-next-line @typescript-eslint/no-explicit-any
   hook_add(type: any, user_callback: any, user_data_A: any, begin_A: any, end_A: any, extra: any): EmulatorHook {
     const handle = this.MUnicorn.getValue(this.ucHandle_ptr, '*');
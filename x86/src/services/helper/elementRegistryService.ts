@@ -0,0 +1,76 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Elements which take part in animations register themselves here when they are mounted,
+// so the animations can resolve them without building id strings or querying the document.
+// Memory bytes are keyed by their address, copies of memory bytes in the execution box by
+// getAnimationKeyMemory and all other elements by their html id.
+export type ElementKey = number | string;
+
+const elementsByNumber: Map<number, HTMLElement> = new Map();
+
+const elementsByName: Map<string, HTMLElement> = new Map();
+
+export function isMemoryByteLocationId(locationId: string): boolean {
+  return /^[0-9A-F]+$/.test(locationId);
+}
+
+export function getElementKeyOfLocationId(locationId: string): ElementKey {
+  return isMemoryByteLocationId(locationId) ? parseInt(locationId, 16) : locationId;
+}
+
+export function registerElement(key: ElementKey, element: HTMLElement) {
+  if (typeof key === 'number') {
+    elementsByNumber.set(key, element);
+  } else {
+    elementsByName.set(key, element);
+  }
+}
+
+// Only removes the key if it still belongs to the element, because a newly mounted
+// element may already have taken over the key of an element which is unmounted later.
+export function unregisterElement(key: ElementKey, element: HTMLElement) {
+  if (typeof key === 'number') {
+    if (elementsByNumber.get(key) === element) {
+      elementsByNumber.delete(key);
+    }
+  } else if (elementsByName.get(key) === element) {
+    elementsByName.delete(key);
+  }
+}
+
+export function hasRegisteredElement(key: ElementKey): boolean {
+  return typeof key === 'number' ? elementsByNumber.has(key) : elementsByName.has(key);
+}
+
+// Named elements which were not registered fall back to the document,
+// numeric keys only exist for registered elements.
+export function getRegisteredElement(key: ElementKey): HTMLElement | null {
+  if (typeof key === 'number') {
+    return elementsByNumber.get(key) ?? null;
+  }
+  return elementsByName.get(key) ?? document.getElementById(key);
+}
+
+export function getElementByLocationId(locationId: string): HTMLElement | null {
+  return getRegisteredElement(getElementKeyOfLocationId(locationId));
+}
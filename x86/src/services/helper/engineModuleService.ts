@@ -0,0 +1,119 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Unicorn, Capstone, NASM and ndisasm are compiled to asm.js with Emscripten and are several MB each.
+ * They are loaded with the first call that needs them instead of with the page, so the editor does not parse them
+ * at startup. Production builds embed every engine as a gzip compressed string (scripts/compressedEngineLoader.js),
+ * it is decompressed and evaluated on first use. Other builds import the library as it is.
+ * Evaluating the decompressed source uses new Function, a Content-Security-Policy must allow 'unsafe-eval'.
+ */
+
+export type EngineName = 'unicorn' | 'capstone' | 'nasm' | 'ndisasm';
+
+// Emscripten module factory, resolves with the instantiated module
+// eslint-disable-next-line @typescript-eslint/no-explicit-any
+export type EngineModuleFactory = (options?: Record<string, unknown>) => Promise<any>;
+
+interface CompressedEngine {
+  compressedSource: string;
+}
+
+type EngineImport = { default: EngineModuleFactory | CompressedEngine };
+
+interface TransformStreamConstructor {
+  new(format: string): { readable: ReadableStream<Uint8Array>; writable: WritableStream<Uint8Array> };
+}
+
+const { DecompressionStream } = globalThis as unknown as { DecompressionStream?: TransformStreamConstructor };
+
+/* eslint-disable */
+const engineImports: Record<EngineName, () => Promise<EngineImport>> = {
+  // @ts-ignore
+  unicorn: () => import('../../../lib/libunicorn-x86.out'),
+  // @ts-ignore
+  capstone: () => import('../../../lib/libcapstone-x86.out'),
+  // @ts-ignore
+  nasm: () => import('../../../lib/nasm'),
+  // @ts-ignore
+  ndisasm: () => import('../../../lib/ndisasm'),
+};
+/* eslint-enable */
+
+const engineFactories = new Map<EngineName, Promise<EngineModuleFactory>>();
+
+function isCompressedEngine(engine: EngineModuleFactory | CompressedEngine): engine is CompressedEngine {
+  return typeof engine !== 'function' && typeof engine.compressedSource === 'string';
+}
+
+async function decompress(base64: string): Promise<string> {
+  if (DecompressionStream === undefined) {
+    throw new Error('This browser cannot decompress the simulator engines (DecompressionStream is missing).');
+  }
+  const binary = atob(base64);
+  const bytes = new Uint8Array(binary.length);
+  for (let i = 0; i < binary.length; i += 1) {
+    bytes[i] = binary.charCodeAt(i);
+  }
+  // piping settles the write side together with the read side, a rejected write can not go unhandled
+  return new Response(new Blob([bytes]).stream().pipeThrough(new DecompressionStream('gzip'))).text();
+}
+
+export async function instantiateCompressedEngine(engine: CompressedEngine): Promise<EngineModuleFactory> {
+  const source = await decompress(engine.compressedSource);
+  // The loader removed the module export, the library declares the factory as Module.
+  // __filename is the fallback of the library for the script directory outside of webpack.
+  // eslint-disable-next-line @typescript-eslint/no-implied-eval
+  return new Function('__filename', `${source}\nreturn Module;`)('') as EngineModuleFactory;
+}
+
+async function importEngine(name: EngineName): Promise<EngineModuleFactory> {
+  const engine = (await engineImports[name]()).default;
+  if (isCompressedEngine(engine)) {
+    return instantiateCompressedEngine(engine);
+  }
+  return engine;
+}
+
+/**
+ * Returns the module factory of the engine, the engine is loaded with the first call.
+ */
+export function loadEngine(name: EngineName): Promise<EngineModuleFactory> {
+  let factory = engineFactories.get(name);
+  if (factory === undefined) {
+    factory = importEngine(name);
+    // a failed load is retried with the next call
+    factory.catch(() => engineFactories.delete(name));
+    engineFactories.set(name, factory);
+  }
+  return factory;
+}
+
+// Starts loading the engines in the background, e.g. when the simulator is entered
+export function preloadEngines(names: Array<EngineName>) {
+  names.forEach((name) => {
+    loadEngine(name).catch((e) => {
+      /* eslint no-console: ["error", { allow: ["warn"] }] */
+      console.warn(e);
+    });
+  });
+}
@@ -23,6 +23,7 @@
 import Address from '@/services/interfaces/Address';
 import Byte from '@/services/interfaces/Byte';
 import htmlId from '@/services/helper/htmlIds';
+import { highestMemoryAddress } from '@/services/dataServices/memoryMapService';
 
 export function getLocationIdsFromBytes(memoryLineContent: Array<Byte>): Array<string> {
   const locationIds: Array<string> = Array(memoryLineContent.length);
@@ -53,6 +54,13 @@ export function getAnimationIdMemory(locationId: string, write: boolean, index:
   return getAnimationId(locationId, write, index);
 }
 
+// Numeric counterpart of getAnimationIdMemory for the element registry:
+// the address stays in the lower 32 bits, the access and index are stacked above it.
+export function getAnimationKeyMemory(address: number, write: boolean, index: number): number {
+  const accessSlot = 1 + index * 2 + (write ? 1 : 0);
+  return address + accessSlot * (highestMemoryAddress + 1);
+}
+
 export function getAnimationIdFlag(locationId: string, write: boolean): string {
   return getAnimationId(locationId, write);
 }
@@ -102,7 +110,6 @@ export default function fillAddress(addressNumber: number): Address {
 
 function createLocationIdForMemoryByte(address: number): string {
   let addressHexString = '';
-  const highestMemoryAddress = 0xffff;
   if (address >= 0 && address <= highestMemoryAddress) {
     addressHexString = fillAddress(address).address;
   } else {
@@ -26,6 +26,7 @@ const htmlId = {
   instructionPointerBlock: 'instructionPointerBlock',
   ipBlock: 'ipBlock',
   magicBox: 'magicBox',
+  byteOffsetCalculator: 'byteOffsetCalculator',
   locationIdPrefixCurrentInstruction: 'CurrInstr',
   locationIdPrefixImmediate: 'immediate',
   addressPrefix: 'Address',
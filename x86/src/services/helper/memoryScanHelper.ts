@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* eslint no-bitwise: 0 */
+
+// Same results as cpusim_mem_diff and cpusim_mem_search (libraryPatches/unicorn.js/patchedFiles/cpusim_memscan.c),
+// used with engine builds which do not contain them. Aligned buffers are compared four bytes at once.
+
+function getWords(bytes: Uint8Array): Uint32Array | undefined {
+  return bytes.byteOffset % 4 === 0 ? new Uint32Array(bytes.buffer, bytes.byteOffset, bytes.length >>> 2) : undefined;
+}
+
+function equalPrefix(live: Uint8Array, snapshot: Uint8Array, liveWords: Uint32Array | undefined,
+  snapshotWords: Uint32Array | undefined, from: number): number {
+  let offset = from;
+  if (liveWords && snapshotWords) {
+    let word = (offset + 3) >>> 2;
+    while (offset < word * 4 && offset < live.length && live[offset] === snapshot[offset]) {
+      offset += 1;
+    }
+    if (offset === word * 4) {
+      while (word < liveWords.length && liveWords[word] === snapshotWords[word]) {
+        word += 1;
+      }
+      offset = word * 4;
+    }
+  }
+  while (offset < live.length && live[offset] === snapshot[offset]) {
+    offset += 1;
+  }
+  return offset;
+}
+
+// pairs of start and end address (exclusive) of the changed ranges
+export function diffMemory(live: Uint8Array, snapshot: Uint8Array, address: number): Uint32Array {
+  if (live.length !== snapshot.length) {
+    throw new RangeError(`The snapshot has ${snapshot.length} bytes, the memory ${live.length} bytes.`);
+  }
+  const liveWords = getWords(live);
+  const snapshotWords = getWords(snapshot);
+  const ranges: Array<number> = [];
+  let offset = equalPrefix(live, snapshot, liveWords, snapshotWords, 0);
+  while (offset < live.length) {
+    const start = offset;
+    while (offset < live.length && live[offset] !== snapshot[offset]) {
+      offset += 1;
+    }
+    ranges.push(address + start, address + offset);
+    offset = equalPrefix(live, snapshot, liveWords, snapshotWords, offset);
+  }
+  return Uint32Array.from(ranges);
+}
+
+// addresses of the matches at multiples of alignment, matches may overlap
+export function searchMemory(memory: Uint8Array, address: number, pattern: Uint8Array, alignment = 1): Uint32Array {
+  const matches: Array<number> = [];
+  const lastOffset = memory.length - pattern.length;
+  let offset = pattern.length > 0 ? memory.indexOf(pattern[0]) : -1;
+  while (offset >= 0 && offset <= lastOffset) {
+    if ((address + offset) % alignment === 0) {
+      let index = 1;
+      while (index < pattern.length && memory[offset + index] === pattern[index]) {
+        index += 1;
+      }
+      if (index === pattern.length) {
+        matches.push(address + offset);
+      }
+    }
+    offset = memory.indexOf(pattern[0], offset + 1);
+  }
+  return Uint32Array.from(matches);
+}
+
+// little endian, as the value is stored in the guest memory
+export function valueToBytes(value: bigint, sizeInBytes: number): Uint8Array {
+  const bytes = new Uint8Array(sizeInBytes);
+  let remainder = BigInt.asUintN(sizeInBytes * 8, value);
+  for (let i = 0; i < sizeInBytes; i += 1) {
+    bytes[i] = Number(remainder & BigInt(0xFF));
+    remainder >>= BigInt(8);
+  }
+  return bytes;
+}
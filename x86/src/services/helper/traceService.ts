@@ -0,0 +1,210 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Lightweight tracing of the simulator phases. Tracing is off unless the URL carries the query flag "trace",
+ * e.g. https://host/CPUSim/?trace#/ or https://host/CPUSim/#/run/...?trace, and costs one boolean check per span then.
+ * Spans show up as User Timing measures in the performance tools of the browser, are kept for rolling statistics
+ * and can be exported in the Chrome trace event format.
+ */
+
+export interface TraceSpanStatistics {
+  name: string;
+  count: number;
+  totalInMs: number;
+  p50InMs: number;
+  p95InMs: number;
+}
+
+interface TraceEvent {
+  name: string;
+  cat: string;
+  ph: 'X' | 'C';
+  ts: number;
+  dur?: number;
+  pid: number;
+  tid: number;
+  args?: Record<string, number>;
+}
+
+interface SpanRecord {
+  count: number;
+  totalInMs: number;
+  // rolling window of the most recent durations
+  durationsInMs: Array<number>;
+}
+
+const traceQueryFlag = 'trace';
+const rollingWindowSize = 500;
+const maxTraceEvents = 50000;
+
+let tracingEnabled = false;
+const spanRecords = new Map<string, SpanRecord>();
+const counters = new Map<string, number>();
+let traceEvents: Array<TraceEvent> = [];
+
+export function isTracingEnabled(): boolean {
+  return tracingEnabled;
+}
+
+export function enableTracing(enabled = true) {
+  tracingEnabled = enabled;
+}
+
+export function hasTraceQueryFlag(location: { search: string; hash: string }): boolean {
+  const hashQueryStart = location.hash.indexOf('?');
+  const hashQuery = hashQueryStart >= 0 ? location.hash.substring(hashQueryStart) : '';
+  return new URLSearchParams(location.search).has(traceQueryFlag) || new URLSearchParams(hashQuery).has(traceQueryFlag);
+}
+
+export function enableTracingFromLocation(location: { search: string; hash: string } = window.location): boolean {
+  enableTracing(hasTraceQueryFlag(location));
+  return tracingEnabled;
+}
+
+function addTraceEvent(event: TraceEvent) {
+  if (traceEvents.length >= maxTraceEvents) {
+    traceEvents = traceEvents.slice(maxTraceEvents / 2);
+  }
+  traceEvents.push(event);
+}
+
+function recordSpan(name: string, startTime: number) {
+  const endTime = performance.now();
+  const durationInMs = endTime - startTime;
+
+  const record = spanRecords.get(name) || { count: 0, totalInMs: 0, durationsInMs: [] };
+  record.count += 1;
+  record.totalInMs += durationInMs;
+  record.durationsInMs.push(durationInMs);
+  if (record.durationsInMs.length > rollingWindowSize) {
+    record.durationsInMs.shift();
+  }
+  spanRecords.set(name, record);
+
+  addTraceEvent({
+    name,
+    cat: 'cpusim',
+    ph: 'X',
+    ts: startTime * 1000,
+    dur: durationInMs * 1000,
+    pid: 1,
+    tid: 1,
+  });
+  if (typeof performance.measure === 'function') {
+    // the performance tools record the measure, it is cleared so the timeline buffer does not grow with every step
+    performance.measure(name, { start: startTime, end: endTime });
+    performance.clearMeasures(name);
+  }
+}
+
+/**
+ * Runs the action within a span of the given name. Spans of actions returning a promise end when the promise settles.
+ */
+export function traceSpan<T>(name: string, action: () => T): T {
+  if (!tracingEnabled) {
+    return action();
+  }
+  const startTime = performance.now();
+  let result: T;
+  try {
+    result = action();
+  } catch (e) {
+    recordSpan(name, startTime);
+    throw e;
+  }
+  if (result instanceof Promise) {
+    return result.finally(() => recordSpan(name, startTime)) as unknown as T;
+  }
+  recordSpan(name, startTime);
+  return result;
+}
+
+/**
+ * Wraps the ccall function of an emscripten module, so every call into the library is traced as prefix.functionName.
+ */
+// eslint-disable-next-line @typescript-eslint/no-explicit-any
+export function traceCcall<F extends (name: string, ...args: any[]) => any>(prefix: string, ccall: F): F {
+  if (!tracingEnabled) {
+    return ccall;
+  }
+  // eslint-disable-next-line @typescript-eslint/no-explicit-any
+  return ((name: string, ...args: any[]) => traceSpan(`${prefix}.${name}`, () => ccall(name, ...args))) as F;
+}
+
+export function countTrace(name: string, increment = 1) {
+  if (!tracingEnabled) {
+    return;
+  }
+  const value = (counters.get(name) || 0) + increment;
+  counters.set(name, value);
+  addTraceEvent({
+    name,
+    cat: 'cpusim',
+    ph: 'C',
+    ts: performance.now() * 1000,
+    pid: 1,
+    tid: 1,
+    args: { value },
+  });
+}
+
+function percentile(sortedDurations: Array<number>, p: number): number {
+  if (sortedDurations.length === 0) {
+    return 0;
+  }
+  return sortedDurations[Math.min(sortedDurations.length - 1, Math.floor((sortedDurations.length * p) / 100))];
+}
+
+export function getTraceSpanStatistics(): Array<TraceSpanStatistics> {
+  return Array.from(spanRecords.entries())
+    .map(([name, record]) => {
+      const sortedDurations = [...record.durationsInMs].sort((a, b) => a - b);
+      return {
+        name,
+        count: record.count,
+        totalInMs: record.totalInMs,
+        p50InMs: percentile(sortedDurations, 50),
+        p95InMs: percentile(sortedDurations, 95),
+      };
+    })
+    .sort((a, b) => b.totalInMs - a.totalInMs);
+}
+
+export function getTraceCounters(): Map<string, number> {
+  return new Map(counters);
+}
+
+// JSON in the Chrome trace event format, it can be loaded in chrome://tracing or the Performance panel of the DevTools
+export function exportChromeTrace(): string {
+  return JSON.stringify({
+    traceEvents,
+    displayTimeUnit: 'ms',
+    otherData: { application: 'CPUSim' },
+  });
+}
+
+export function clearTraces() {
+  spanRecords.clear();
+  counters.clear();
+  traceEvents = [];
+}
@@ -20,6 +20,8 @@
  * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+import ByteSet from '@/services/interfaces/ByteSet';
+
 export interface PointerInformation {
     pointerAddress: number;
     pointerBytes: Array<number>;
@@ -34,9 +36,9 @@ interface ByteInformation {
     instructionPointerInformation: PointerInformation;
     stackPointerInformation: PointerInformation;
     basePointerInformation: PointerInformation;
-    usedBytes: Array<number>;
-    evenInstructionBytes?: Array<string>;
-    unevenInstructionBytes?: Array<string>;
+    usedBytes: ByteSet;
+    evenInstructionBytes?: ByteSet;
+    unevenInstructionBytes?: ByteSet;
     code: CodeInformation;
 }
 export default ByteInformation;
@@ -0,0 +1,51 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Changed memory line, register or flag. The name and the content of every byte are indices of the interned strings.
+export interface ChangedContainer {
+  name: number;
+  content: Array<number>;
+}
+
+export interface ChangeRecord {
+  instructionIndex: number;
+  // index of the interned assembly interpretation
+  instruction: number;
+  memory: Array<ChangedContainer>;
+  registers: Array<ChangedContainer>;
+  flags: Array<ChangedContainer>;
+}
+
+// The change log of the executed instructions. Snapshots share its storage and keep their own counts,
+// the storage is only appended to below the counts, a shared storage is replaced when it is truncated or spilled.
+interface ChangeHistoryLog {
+  // interned assembly interpretations, they are never removed
+  instructions: Array<string>;
+  // interned names and byte contents of the records, the strings of spilled records are pruned
+  strings: Array<string>;
+  // interned instruction of each instruction which left the retention window, their changes are dropped
+  spilledInstructions: Uint32Array;
+  spilledCount: number;
+  records: Array<ChangeRecord>;
+  recordCount: number;
+}
+export default ChangeHistoryLog;
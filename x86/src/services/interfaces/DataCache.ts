@@ -0,0 +1,51 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+export enum ReplacementPolicy {
+  LRU = 'LRU',
+  FIFO = 'FIFO',
+  RANDOM = 'Random',
+}
+
+export interface DataCacheConfiguration {
+  sizeInBytes: number;
+  lineSizeInBytes: number;
+  // ways per set, a fully associative cache has sizeInBytes / lineSizeInBytes ways
+  associativity: number;
+  replacementPolicy: ReplacementPolicy;
+}
+
+export interface CacheAccessCounts {
+  hits: number;
+  misses: number;
+}
+
+// an access which spans two cache lines is counted once for each line
+interface DataCacheStatistics {
+  hits: number;
+  misses: number;
+  // keyed by the address of the accessing instruction
+  perInstruction: Map<number, CacheAccessCounts>;
+  // keyed by the address of the 16 byte line of the memory view
+  perMemoryLine: Map<number, CacheAccessCounts>;
+}
+export default DataCacheStatistics;
@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { RegisterID } from '@/services/emulator/emulatorEnums';
+import Flag, { FlagID } from '@/services/interfaces/Flag';
+import Register from '@/services/interfaces/Register';
+import MemoryMap from '@/services/interfaces/MemoryMap';
+import { MemoryPage } from '@/services/interfaces/SimulatorSession';
+
+export enum LockstepMode {
+  // the states are compared after every instruction
+  INSTRUCTION = 'instruction',
+  // the states are compared before every interrupt or system call and at the observation addresses
+  OBSERVATION_POINT = 'observationPoint',
+}
+
+export interface DifferentialProgram {
+  code: Array<number>;
+  memoryMap?: MemoryMap;
+  // further observation points besides the interrupt and system call instructions
+  observationAddresses?: Array<number>;
+}
+
+export interface ComparedMemoryRange {
+  address: number;
+  sizeInBytes: number;
+}
+
+export interface DifferentialRequest {
+  reference: DifferentialProgram;
+  candidate: DifferentialProgram;
+  mode: LockstepMode;
+  registers: Array<RegisterID>;
+  flags: Array<FlagID>;
+  memoryRanges: Array<ComparedMemoryRange>;
+  // maximal number of instructions executed by each program
+  instructionLimit: number;
+  // instructions executed between two comparisons in instruction mode, a mismatch is located by replaying the chunk
+  // from the first differing state digest
+  chunkSize?: number;
+}
+
+export interface EngineState {
+  executedInstructions: number;
+  instructionPointer: number;
+  registers: Array<Register>;
+  flags: Array<Flag>;
+  memory: Array<MemoryPage>;
+  // the instruction pointer left the code or the emulator stopped with an error
+  finished: boolean;
+  error?: string;
+}
+
+export interface Divergence {
+  registers: Array<string>;
+  flags: Array<string>;
+  // pairs of start and end address (exclusive) of the bytes which differ
+  memoryRanges: Array<number>;
+  // one of the programs ended, or failed, and the other did not
+  termination: boolean;
+}
+
+export interface DifferentialProgress {
+  executedInstructions: number;
+  comparedPoints: number;
+}
+
+interface DifferentialResult {
+  // points (instructions or observation points) at which both states were equal
+  comparedPoints: number;
+  reference: EngineState;
+  candidate: EngineState;
+  // missing if the programs did not diverge
+  divergence?: Divergence;
+  instructionLimitReached: boolean;
+}
+export default DifferentialResult;
+
+// messages posted by the worker of a differential execution
+export type DifferentialWorkerMessage =
+  { type: 'progress', progress: DifferentialProgress }
+  | { type: 'result', result: DifferentialResult }
+  | { type: 'error', message: string };
@@ -23,6 +23,7 @@
 import Byte from '@/services/interfaces/Byte';
 import Address from '@/services/interfaces/Address';
 import InstructionOperands from '@/services/interfaces/InstructionOperands';
+import RunToReturn from '@/services/interfaces/RunToReturn';
 
 interface Instruction {
   assemblyInterpretation: string;
@@ -30,5 +31,7 @@ interface Instruction {
   content: Array<Byte>;
   address: Address;
   operands: InstructionOperands;
+  // set if the instruction was executed together with the following instructions up to a return
+  runToReturn?: RunToReturn;
 }
 export default Instruction;
@@ -82,6 +82,9 @@ interface InstructionOperands {
   immediate: Array<ImmediateOperand>;
   flagsWrite: Array<FlagID>;
   flagsTest: Array<FlagID>;
+  // accessed registers normalized to the 64-bit registers, only set by libraries built from cs.c with register masks
+  registersReadMask?: Uint32Array;
+  registersWriteMask?: Uint32Array;
 }
 
 export default InstructionOperands;
@@ -0,0 +1,38 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// A named region of guest memory, mapped with uc_mem_map.
+// Address and size have to be aligned to the page size of the emulator (4 KB).
+export interface MemoryRegion {
+  name: string;
+  address: number;
+  sizeInBytes: number;
+  // protection flags of the emulator (eUC.PROT_READ, eUC.PROT_WRITE, eUC.PROT_EXEC)
+  permissions: number;
+}
+
+interface MemoryMap {
+  regions: Array<MemoryRegion>;
+  codeAddress: number;
+  stackPointerAddress: number;
+}
+export default MemoryMap;
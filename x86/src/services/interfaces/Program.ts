@@ -24,6 +24,7 @@ import Unicorn from '@/services/emulator/emulatorService';
 import { RegisterID } from '@/services/emulator/emulatorEnums';
 import Disassembler from '@/services/disassembler/disassemblerService';
 import { FlagID } from '@/services/interfaces/Flag';
+import MemoryMap from '@/services/interfaces/MemoryMap';
 
 interface Program {
   ucInstance: Unicorn;
@@ -32,6 +33,12 @@ interface Program {
   flagsToShow: Array<FlagID>;
   memoryAddress: number;
   memorySizeInBytes: number;
+  // named memory regions, memoryAddress and memorySizeInBytes span all of them
+  memoryMap?: MemoryMap;
+  // sorted start addresses of the pages read and shown, pages are added on access
+  residentPages?: Array<number>;
+  // addresses of the 16 byte memory lines written since the memory data was last updated
+  dirtyMemoryLines?: Set<number>;
   codeAddress: number;
   codeSizeInBytes: number;
   code: number[];
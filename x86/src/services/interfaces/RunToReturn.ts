@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+export const enum RunToReturnCommand {
+  STEP_OVER,
+  STEP_OUT,
+  RUN_TO_RETURN,
+}
+
+// Outcome of a run to return, an incomplete run stopped at the instruction limit or the end of the code before a return
+export const enum RunToReturnResult {
+  NOT_APPLICABLE,
+  RETURNED,
+  INCOMPLETE,
+}
+
+// Condition of a run which executes a whole call at emulator speed. The run stops before one of the return
+// addresses is executed with a stack pointer of at least stackPointer, so returns of nested calls do not stop it.
+interface RunToReturn {
+  returnAddresses: Array<number>;
+  stackPointer: number;
+  // the run also stops when the end of the code is reached
+  endAddress: number;
+  instructionLimit: number;
+  // the return instruction the run stopped at is executed as well
+  executeReturn: boolean;
+}
+export default RunToReturn;
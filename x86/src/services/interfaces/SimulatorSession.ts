@@ -0,0 +1,63 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import State from '@/services/interfaces/State';
+import CpuCycleStep, { Step } from '@/services/interfaces/CpuCycleStep';
+import Version from '@/services/interfaces/reverseDebugger/Version';
+import TransactionStore from '@/services/interfaces/reverseDebugger/TransactionStore';
+import ProgramTransactions from '@/services/interfaces/reverseDebugger/ProgramTransactions';
+import EditorLine from '@/services/interfaces/codeEditor/EditorLine';
+import Breakpoint from '@/services/interfaces/debugger/Breakpoint';
+import Watchpoint from '@/services/interfaces/debugger/Watchpoint';
+
+export interface ReverseDebuggerSession {
+  versioning: Version;
+  transactionStore: TransactionStore;
+}
+
+export interface StepControllerSession {
+  state: State;
+  step: Step;
+  steps: Array<CpuCycleStep>;
+  reverseDebugger: ReverseDebuggerSession;
+}
+
+export interface MemoryPage {
+  address: number;
+  content: Uint8Array;
+}
+
+// Everything needed to continue a simulation without executing the program again
+interface SimulatorSession {
+  version: number;
+  source: string;
+  program: ProgramTransactions;
+  // CPU state saved with uc_context_save
+  emulatorContext: Uint8Array;
+  // content of the resident pages, the other pages were never accessed by the program
+  memoryPages: Array<MemoryPage>;
+  stepController: StepControllerSession;
+  editorLines: Array<EditorLine>;
+  breakpoints: Array<Breakpoint>;
+  watchpoints: Array<Watchpoint>;
+}
+export default SimulatorSession;
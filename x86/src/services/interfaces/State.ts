@@ -27,7 +27,9 @@ import Register from '@/services/interfaces/Register';
 import Flag from '@/services/interfaces/Flag';
 import AccessedElements from '@/services/interfaces/AccessedElements';
 import ByteInformation from '@/services/interfaces/ByteInformation';
+import ChangeHistoryLog from '@/services/interfaces/ChangeHistoryLog';
 
+// entry of the change log as it is shown
 export interface ChangeHistory {
   instruction: string;
   changedElements: Array<string>;
@@ -41,7 +43,7 @@ interface State {
   flags: Array<Flag>;
   currentAccessedElements: AccessedElements;
   byteInformation: ByteInformation;
-  changeHistory: Array<ChangeHistory>;
+  changeHistory: ChangeHistoryLog;
 }
 
 export type ValueOfState = State[keyof State]
@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * An instruction decoded at build time. The fields carry what getCurrentInstruction would read from Capstone and ndisasm.
+ */
+export interface PrebuiltInstruction {
+  address: number;
+  // machine code of the instruction as uppercase hex string
+  bytes: string;
+  capstoneAssembly: string;
+  nasmAssembly: string;
+  // instruction detail as printed by print_insn_detail
+  detail: string;
+}
+
+/**
+ * A demo program assembled and decoded at build time, see scripts/buildDemoBundle.mjs.
+ */
+interface PrebuiltProgram {
+  label: string;
+  source: string;
+  codeAddress: number;
+  // machine code of the program as uppercase hex string
+  machineCode: string;
+  instructions: Array<PrebuiltInstruction>;
+}
+export default PrebuiltProgram;
@@ -21,12 +21,15 @@
 
 import { RegisterID } from '@/services/emulator/emulatorEnums';
 import { FlagID } from '@/services/interfaces/Flag';
+import MemoryMap from '@/services/interfaces/MemoryMap';
 
 interface ProgramTransactions {
   registersToShow: Array<RegisterID>;
   flagsToShow: Array<FlagID>;
   memoryAddress: number;
   memorySizeInBytes: number;
+  memoryMap?: MemoryMap;
+  residentPages?: Array<number>;
   codeAddress: number;
   codeSizeInBytes: number;
   code: number[];
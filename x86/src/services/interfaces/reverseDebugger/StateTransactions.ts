@@ -26,7 +26,6 @@ import InstructionPointer from '@/services/interfaces/InstructionPointer';
 import Flag from '@/services/interfaces/Flag';
 import AccessedElements from '@/services/interfaces/AccessedElements';
 import ByteInformation from '@/services/interfaces/ByteInformation';
-import { ChangeHistory } from '@/services/interfaces/State';
 import Version from '@/services/interfaces/reverseDebugger/Version';
 
 interface StateTransactions {
@@ -37,7 +36,6 @@ interface StateTransactions {
   flags: [{version: Version; value: Array<Flag>}];
   currentAccessedElements: [{version: Version; value: AccessedElements}];
   byteInformation: [{version: Version; value: ByteInformation}];
-  changeHistory: [{version: Version; value: Array<ChangeHistory>}];
 }
 
 export default StateTransactions;
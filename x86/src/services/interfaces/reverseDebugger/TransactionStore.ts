@@ -22,9 +22,11 @@
 import StateTransactions from '@/services/interfaces/reverseDebugger/StateTransactions';
 import Version from '@/services/interfaces/reverseDebugger/Version';
 import ProgramTransactions from '@/services/interfaces/reverseDebugger/ProgramTransactions';
+import MemoryDataChange from '@/services/interfaces/reverseDebugger/MemoryDataChange';
 
 interface TransactionStore {
   stateTransactions: StateTransactions;
   programStates: [{version: Version; value: ProgramTransactions}];
+  memoryDataChanges: Array<{version: Version; value: MemoryDataChange}>;
 }
 export default TransactionStore;
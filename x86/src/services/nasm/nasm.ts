@@ -51,10 +51,7 @@ simplified BSD license.
       EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-/* eslint-disable */
-// @ts-ignore
-import Module from '../../../lib/nasm';
-/* eslint-enable */
+import { loadEngine } from '@/services/helper/engineModuleService';
 
 interface MNasm {
   // eslint-disable-next-line @typescript-eslint/no-explicit-any
@@ -73,6 +70,7 @@ interface MNasm {
 
 export async function nasm(assembly: string): Promise<Uint8Array> {
   let error = '';
+  const Module = await loadEngine('nasm');
   const nasmInstance: MNasm = await Module({
     print(text: string) {
       error = text;
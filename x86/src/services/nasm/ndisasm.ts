@@ -51,10 +51,7 @@ simplified BSD license.
       EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-/* eslint-disable */
-// @ts-ignore
-import Module from '../../../lib/ndisasm';
-/* eslint-enable */
+import { loadEngine } from '@/services/helper/engineModuleService';
 
 interface MNdisasm {
   // eslint-disable-next-line @typescript-eslint/no-explicit-any
@@ -102,6 +99,7 @@ export async function ndisasm(machineCode: Uint8Array): Promise<string> {
   let output = '';
   let error = '';
 
+  const Module = await loadEngine('ndisasm');
   const ndisasmInstance: MNdisasm = await Module({
     noInitialRun: true,
 
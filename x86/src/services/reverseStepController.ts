@@ -22,7 +22,7 @@
 import rfdc from 'rfdc';
 import Version from '@/services/interfaces/reverseDebugger/Version';
 import TransactionStore from '@/services/interfaces/reverseDebugger/TransactionStore';
-import State, { ChangeHistory, ValueOfState } from '@/services/interfaces/State';
+import State, { ValueOfState } from '@/services/interfaces/State';
 import Program, { ValueOfProgram } from '@/services/interfaces/Program';
 import getStateWithEmptyInstruction from '@/services/dataServices/fillDataService';
 import ProgramTransactions from '@/services/interfaces/reverseDebugger/ProgramTransactions';
@@ -36,6 +36,12 @@ import Register from '@/services/interfaces/Register';
 import InstructionPointer from '@/services/interfaces/InstructionPointer';
 import Flag from '@/services/interfaces/Flag';
 import AccessedElements from '@/services/interfaces/AccessedElements';
+import MemoryDataChange from '@/services/interfaces/reverseDebugger/MemoryDataChange';
+import { revertMemoryDataChange } from '@/services/dataServices/dirtyMemoryService';
+import { byteSetsEqual } from '@/services/dataServices/byteSetService';
+import { truncateChangeHistory } from '@/services/dataServices/changeHistoryService';
+import { countTrace, traceSpan } from '@/services/helper/traceService';
+import { ReverseDebuggerSession } from '@/services/interfaces/SimulatorSession';
 import ByteInformation, { PointerInformation } from './interfaces/ByteInformation';
 
 export default class ReverseDebugger {
@@ -72,6 +78,19 @@ export default class ReverseDebugger {
     return this.programProxy;
   }
 
+  public getSession(): ReverseDebuggerSession {
+    return {
+      versioning: this.clone(this.versioning),
+      transactionStore: this.clone(this.transactionStore),
+    };
+  }
+
+  // Continues with the recorded history of a saved session, the state proxy has to wrap the state of the session
+  public restoreSession(session: ReverseDebuggerSession) {
+    Object.assign(this.versioning, this.clone(session.versioning));
+    Object.assign(this.transactionStore, this.clone(session.transactionStore));
+  }
+
   public isInitialStep() {
     return this.versioning.step === 0 && this.versioning.nrOfInstructions === 1;
   }
@@ -111,7 +130,6 @@ export default class ReverseDebugger {
     return newStep;
   }
 
-  // eslint-disable-next-line class-methods-use-this
   private populateTransactionStore = (state: State, program: Program) => {
     const versioning: Version = {
       step: 0,
@@ -119,7 +137,9 @@ export default class ReverseDebugger {
     };
 
     const initialTransactions: Partial<StateTransactions> = {};
+    // the change history is not recorded, it is truncated to the number of executed instructions
     Object.entries(state)
+      .filter(([item]) => item !== 'changeHistory')
       .forEach(([item]) => {
         Object.assign(initialTransactions, {
           [item]: Array({
@@ -131,12 +151,13 @@ export default class ReverseDebugger {
 
     const initialProgram = {
       version: versioning,
-      value: program,
+      value: this.captureProgram(program),
     };
 
     const finalStateTransactions: TransactionStore = {
       stateTransactions: initialTransactions as StateTransactions,
       programStates: [initialProgram],
+      memoryDataChanges: [],
     };
 
     return finalStateTransactions;
@@ -144,7 +165,7 @@ export default class ReverseDebugger {
 
   private async buildProgram(modifiedProgram: Program) {
     const machineCode = modifiedProgram.code;
-    const program = await startEmulator(machineCode);
+    const program = await startEmulator(machineCode, modifiedProgram.memoryMap);
     program.registersToShow = changeRegistersToLongSizeRegisters(program.registersToShow);
 
     const states = this.transactionStore.stateTransactions.currentInstruction;
@@ -161,6 +182,8 @@ export default class ReverseDebugger {
       flagsToShow,
       memoryAddress,
       memorySizeInBytes,
+      memoryMap,
+      residentPages,
       codeAddress,
       codeSizeInBytes,
       code,
@@ -173,6 +196,9 @@ export default class ReverseDebugger {
       flagsToShow,
       memoryAddress,
       memorySizeInBytes,
+      memoryMap,
+      residentPages,
+      dirtyMemoryLines: new Set(),
       codeAddress,
       codeSizeInBytes,
       code,
@@ -224,6 +250,7 @@ export default class ReverseDebugger {
         }
       });
 
+    truncateChangeHistory(state.changeHistory, this.versioning.nrOfInstructions - 1);
     const modifiedState = state;
 
     return {
@@ -255,15 +282,13 @@ export default class ReverseDebugger {
   }
 
   private static updateByteInformation(byteInformation: ByteInformation, state: State) {
-    const compareViaArray = (arr1: Array<number>, arr2: Array<number>) => arr1.length === arr2.length;
-
     const updatePointerInformation = (oldPointer: PointerInformation, newPointer: PointerInformation) => {
       const updatedPointer = oldPointer;
       updatedPointer.pointerAddress = newPointer.pointerAddress;
       updatedPointer.pointerBytes = newPointer.pointerBytes;
     };
 
-    if (!compareViaArray(state.byteInformation.usedBytes, byteInformation.usedBytes)) {
+    if (!byteSetsEqual(state.byteInformation.usedBytes, byteInformation.usedBytes)) {
       state.byteInformation.usedBytes = byteInformation.usedBytes;
     }
 
@@ -273,17 +298,38 @@ export default class ReverseDebugger {
     updatePointerInformation(state.byteInformation.basePointerInformation, byteInformation.basePointerInformation);
   }
 
+  // Memory lines are patched in place and not recorded by the state proxy
+  public recordMemoryDataChange(memoryDataChange: MemoryDataChange) {
+    if (memoryDataChange.replacedLines.length > 0 || memoryDataChange.insertedPages.length > 0) {
+      this.transactionStore.memoryDataChanges.push({
+        version: this.clone(this.versioning),
+        value: memoryDataChange,
+      });
+    }
+  }
+
+  private revertMemoryDataChanges(state: State, program: Program) {
+    const { memoryDataChanges } = this.transactionStore;
+    while (memoryDataChanges.length > 0
+      && ReverseDebugger.compareVersions(ReverseDebugger.getLastEntry(memoryDataChanges).version, this.versioning)) {
+      const { value } = ReverseDebugger.getLastEntry(memoryDataChanges);
+      memoryDataChanges.pop();
+      revertMemoryDataChange(state.memoryData, value, program);
+    }
+  }
+
   async previousStep(state: State, program: Program) {
     let modifiedProgram = program;
     const modifiedStep = this.calculatePreviousStep();
     const {
       rebuildProgram, byteInformation,
       modifiedState,
-    } = this.loadTransactionStore(state);
+    } = traceSpan('ReverseDebugger.loadTransactionStore', () => this.loadTransactionStore(state));
+    this.revertMemoryDataChanges(modifiedState, program);
 
     const cleaned = this.cleanProgramStates();
     if (rebuildProgram && cleaned) {
-      modifiedProgram = await this.buildProgram(modifiedProgram);
+      modifiedProgram = await traceSpan('ReverseDebugger.buildProgram', () => this.buildProgram(modifiedProgram));
     }
 
     ReverseDebugger.updateByteInformation(byteInformation as ByteInformation, modifiedState);
@@ -295,7 +341,8 @@ export default class ReverseDebugger {
     };
   }
 
-  private setProgramStates = (program: Program) => {
+  // Only the fields are recorded, the emulator, the disassembler and the component stay with the live program
+  private captureProgram(program: Program): ProgramTransactions {
     const {
       // eslint-disable-next-line @typescript-eslint/no-unused-vars
       disassemblerInstance, vm, ucInstance, ...fields
@@ -308,26 +355,32 @@ export default class ReverseDebugger {
       flagsToShow,
       memoryAddress,
       memorySizeInBytes,
+      memoryMap,
+      residentPages,
       codeAddress,
       codeSizeInBytes,
       code,
     } = clonedFields;
 
-    const updatedProgram: ProgramTransactions = {
+    return {
       registersToShow,
       flagsToShow,
       memoryAddress,
       memorySizeInBytes,
+      memoryMap,
+      residentPages,
       codeAddress,
       codeSizeInBytes,
       code,
     };
+  }
 
+  private setProgramStates = (program: Program) => {
     const versionCopy = this.clone(this.versioning);
 
     const newEntry = {
       version: versionCopy,
-      value: updatedProgram,
+      value: this.captureProgram(program),
     };
 
     this.transactionStore.programStates.push(newEntry);
@@ -359,11 +412,8 @@ export default class ReverseDebugger {
       case 'registers':
         stateTransactions.registers.push(entry as {version: Version; value: Array<Register>});
         break;
-      case 'memoryData':
-        stateTransactions.memoryData.push(entry as {version: Version; value: MemoryData});
-        break;
       default:
-        stateTransactions.changeHistory.push(entry as {version: Version; value: Array<ChangeHistory>});
+        stateTransactions.memoryData.push(entry as {version: Version; value: MemoryData});
     }
   }
 
@@ -376,7 +426,7 @@ export default class ReverseDebugger {
 
   private attachProgram(target: Program) {
     const setProgramStates = (obj: Program) => {
-      this.setProgramStates(obj);
+      traceSpan('ReverseDebugger.recordProgram', () => this.setProgramStates(obj));
     };
 
     const handler = {
@@ -392,12 +442,15 @@ export default class ReverseDebugger {
 
   private attachState(target: State) {
     const setTransactionStore = (prop: string, value: ValueOfState) => {
-      this.setTransactionStore(prop, value);
+      traceSpan('ReverseDebugger.recordState', () => this.setTransactionStore(prop, value));
+      countTrace(`ReverseDebugger.recordedStates.${prop}`);
     };
 
     const handler = {
       set(obj: State, prop: string, value: ValueOfState) {
-        setTransactionStore(prop, value);
+        if (prop !== 'changeHistory') {
+          setTransactionStore(prop, value);
+        }
         return Reflect.set(obj, prop, value);
       },
     };
@@ -0,0 +1,225 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import Program from '@/services/interfaces/Program';
+import SimulatorSession, { MemoryPage } from '@/services/interfaces/SimulatorSession';
+import EditorLine from '@/services/interfaces/codeEditor/EditorLine';
+import StepController from '@/services/stepController';
+import DebuggerController from '@/services/debuggerController';
+import startEmulator from '@/services/startSimulatorService';
+import { getResidentPages, memoryPageSizeInBytes } from '@/services/dataServices/memoryMapService';
+
+/*
+ * A session holds the emulator context, the resident memory pages, the simulator state with its reverse debugging
+ * history, the editor line map, breakpoints and watchpoints. It is restored into a freshly started emulator without
+ * executing a single instruction, so a saved session or a session handed out as file opens instantly.
+ * Sessions are stored as gzip compressed JSON, in IndexedDB or as downloadable file.
+ */
+
+// Sessions of other versions are rejected, the emulator context is only valid for the library it was saved with
+export const sessionFormatVersion = 3;
+
+export const sessionFileExtension = '.cpusim';
+
+const sessionDatabaseName = 'cpusim';
+
+const sessionStoreName = 'sessions';
+
+const compressionFormat = 'gzip';
+
+interface TransformStreamConstructor {
+  new(format: string): { readable: ReadableStream<Uint8Array>; writable: WritableStream<Uint8Array> };
+}
+
+const streams = globalThis as unknown as {
+  CompressionStream?: TransformStreamConstructor;
+  DecompressionStream?: TransformStreamConstructor;
+};
+
+export interface RestoredSession {
+  program: Program;
+  stepController: StepController;
+  debuggerController: DebuggerController;
+  editorLines: Map<number, EditorLine>;
+}
+
+function readMemoryPages(program: Program): Array<MemoryPage> {
+  return getResidentPages(program).map((address) => ({
+    address,
+    content: program.ucInstance.memory_read(address, memoryPageSizeInBytes),
+  }));
+}
+
+export function captureSession(source: string, stepController: StepController, debuggerController: DebuggerController): SimulatorSession {
+  const stepControllerSession = stepController.getSession();
+  const program = stepController.getProgram();
+  return {
+    version: sessionFormatVersion,
+    source,
+    program: {
+      registersToShow: [...program.registersToShow],
+      flagsToShow: [...program.flagsToShow],
+      memoryAddress: program.memoryAddress,
+      memorySizeInBytes: program.memorySizeInBytes,
+      memoryMap: program.memoryMap,
+      residentPages: program.residentPages ? [...program.residentPages] : undefined,
+      codeAddress: program.codeAddress,
+      codeSizeInBytes: program.codeSizeInBytes,
+      code: [...program.code],
+    },
+    emulatorContext: program.ucInstance.context_save(),
+    memoryPages: readMemoryPages(program),
+    stepController: stepControllerSession,
+    editorLines: Array.from(debuggerController.getEditorLines().values()),
+    breakpoints: [...debuggerController.getBreakpoints()],
+    watchpoints: [...debuggerController.getWatchpoints()],
+  };
+}
+
+export async function restoreSession(session: SimulatorSession): Promise<RestoredSession> {
+  const program = await startEmulator(session.program.code, session.program.memoryMap);
+  session.memoryPages.forEach((page) => program.ucInstance.memory_write(page.address, Array.from(page.content)));
+  program.ucInstance.context_restore(session.emulatorContext);
+  program.registersToShow = session.program.registersToShow;
+  program.flagsToShow = session.program.flagsToShow;
+  program.residentPages = session.program.residentPages;
+
+  const stepController = new StepController(program, session.stepController);
+  const editorLines = new Map(session.editorLines.map((editorLine): [number, EditorLine] => [editorLine.line, editorLine]));
+  const debuggerController = new DebuggerController(stepController, editorLines);
+  session.breakpoints.forEach((breakpoint) => debuggerController.setBreakpoint(breakpoint));
+  session.watchpoints.forEach((watchpoint) => debuggerController.setWatchpoint(watchpoint));
+  return {
+    program: stepController.getProgram(),
+    stepController,
+    debuggerController,
+    editorLines,
+  };
+}
+
+function bytesToBase64(bytes: Uint8Array): string {
+  let binary = '';
+  for (let i = 0; i < bytes.length; i += 1) {
+    binary += String.fromCharCode(bytes[i]);
+  }
+  return btoa(binary);
+}
+
+function base64ToBytes(base64: string): Uint8Array {
+  return Uint8Array.from(atob(base64), (character) => character.charCodeAt(0));
+}
+
+// Typed arrays are part of the state (byte sets, opcodes, register masks) and are kept as base64
+function replaceTypedArrays(key: string, value: unknown) {
+  if (value instanceof Uint8Array) {
+    return { typedArray: 'Uint8Array', base64: bytesToBase64(value) };
+  }
+  if (value instanceof Uint32Array) {
+    return { typedArray: 'Uint32Array', base64: bytesToBase64(new Uint8Array(value.buffer, value.byteOffset, value.byteLength)) };
+  }
+  return value;
+}
+
+function reviveTypedArrays(key: string, value: { typedArray?: string; base64?: string }) {
+  if (value !== null && typeof value === 'object' && typeof value.typedArray === 'string' && typeof value.base64 === 'string') {
+    const bytes = base64ToBytes(value.base64);
+    return value.typedArray === 'Uint32Array' ? new Uint32Array(bytes.buffer) : bytes;
+  }
+  return value;
+}
+
+async function transformBytes(bytes: Uint8Array, Transformer?: TransformStreamConstructor): Promise<Uint8Array> {
+  if (Transformer === undefined) {
+    throw new Error('This browser cannot compress or decompress simulator sessions.');
+  }
+  const stream = new Transformer(compressionFormat);
+  const writer = stream.writable.getWriter();
+  // the readable side is drained meanwhile, otherwise the backpressure of the stream blocks the write
+  const [, transformed] = await Promise.all([
+    writer.write(bytes).then(() => writer.close()),
+    new Response(stream.readable).arrayBuffer(),
+  ]);
+  return new Uint8Array(transformed);
+}
+
+export async function encodeSession(session: SimulatorSession): Promise<Uint8Array> {
+  const json = JSON.stringify(session, replaceTypedArrays);
+  return transformBytes(new TextEncoder().encode(json), streams.CompressionStream);
+}
+
+export async function decodeSession(bytes: Uint8Array): Promise<SimulatorSession> {
+  const json = new TextDecoder().decode(await transformBytes(bytes, streams.DecompressionStream));
+  const session = JSON.parse(json, reviveTypedArrays);
+  if (session === null || typeof session !== 'object' || session.version !== sessionFormatVersion) {
+    throw new Error(`Session version ${session?.version} is not supported.`);
+  }
+  return session as SimulatorSession;
+}
+
+function openSessionDatabase(): Promise<IDBDatabase> {
+  return new Promise((resolve, reject) => {
+    const request = indexedDB.open(sessionDatabaseName, 1);
+    request.onupgradeneeded = () => {
+      request.result.createObjectStore(sessionStoreName);
+    };
+    request.onsuccess = () => resolve(request.result);
+    request.onerror = () => reject(request.error);
+  });
+}
+
+async function runSessionTransaction<T>(mode: IDBTransactionMode, operation: (store: IDBObjectStore) => IDBRequest<T>): Promise<T> {
+  const database = await openSessionDatabase();
+  try {
+    return await new Promise<T>((resolve, reject) => {
+      const request = operation(database.transaction(sessionStoreName, mode).objectStore(sessionStoreName));
+      request.onsuccess = () => resolve(request.result);
+      request.onerror = () => reject(request.error);
+    });
+  } finally {
+    database.close();
+  }
+}
+
+// The encoded session is stored, so a session in the browser and in a file are the same bytes
+export async function saveSessionInBrowser(session: SimulatorSession, name = 'last'): Promise<void> {
+  const bytes = await encodeSession(session);
+  await runSessionTransaction('readwrite', (store) => store.put(bytes, name));
+}
+
+export async function loadSessionFromBrowser(name = 'last'): Promise<SimulatorSession | undefined> {
+  const bytes = await runSessionTransaction<Uint8Array | undefined>('readonly', (store) => store.get(name));
+  return bytes === undefined ? undefined : decodeSession(bytes);
+}
+
+export async function downloadSession(session: SimulatorSession, fileName = `session${sessionFileExtension}`) {
+  const bytes = await encodeSession(session);
+  const url = URL.createObjectURL(new Blob([bytes], { type: 'application/gzip' }));
+  const link = document.createElement('a');
+  link.href = url;
+  link.download = fileName;
+  link.click();
+  URL.revokeObjectURL(url);
+}
+
+export async function readSessionFile(file: Blob): Promise<SimulatorSession> {
+  return decodeSession(new Uint8Array(await file.arrayBuffer()));
+}
@@ -25,10 +25,14 @@ import Unicorn from '@/services/emulator/emulatorService';
 import Disassembler from '@/services/disassembler/disassemblerService';
 import { FlagID } from '@/services/interfaces/Flag';
 import Program from '@/services/interfaces/Program';
+import MemoryMap from '@/services/interfaces/MemoryMap';
+import {
+  defaultMemoryMap,
+  getInitialResidentPages,
+  mapMemoryRegions,
+  validateMemoryMap,
+} from '@/services/dataServices/memoryMapService';
 
-const memoryStartAddress = 0x0000;
-const stackPointerPosition = [0x00, 0x03];
-const memorySizeInBytes = 4 * 1024;
 const registers: Array<RegisterID> = [RegisterID.RAX, RegisterID.RBX, RegisterID.RBP, RegisterID.RSP];
 const flags: Array<FlagID> = [FlagID.CF, FlagID.OF, FlagID.ZF, FlagID.SF];
 
@@ -40,18 +44,29 @@ function codeAsNumberArray(code: string): Array<number> {
   return stringArray.map((value) => parseInt(value, 16));
 }
 
-function setStackAndBasePointer() {
+function addressAsLittleEndianBytes(address: number): Array<number> {
+  const bytes: Array<number> = [];
+  let remainder = address;
+  for (let i = 0; i < 4; i += 1) {
+    bytes.push(remainder % 0x100);
+    remainder = Math.floor(remainder / 0x100);
+  }
+  return bytes;
+}
+
+function setStackAndBasePointer(stackPointerAddress: number) {
+  const stackPointerPosition = addressAsLittleEndianBytes(stackPointerAddress);
   ucInstance.register_write(RegisterID.RSP, stackPointerPosition);
   ucInstance.register_write(RegisterID.RBP, stackPointerPosition);
 }
 
-async function initEmulator(code: Array<number>): Promise<void> {
+async function initEmulator(code: Array<number>, memoryMap: MemoryMap): Promise<void> {
   ucInstance = new Unicorn();
   try {
     await ucInstance.initialiseEmulator();
-    ucInstance.memory_map(memoryStartAddress, memorySizeInBytes, ucInstance.uc.PROT_ALL);
-    ucInstance.memory_write(memoryStartAddress, code);
-    setStackAndBasePointer();
+    mapMemoryRegions(ucInstance, memoryMap);
+    ucInstance.memory_write(memoryMap.codeAddress, code);
+    setStackAndBasePointer(memoryMap.stackPointerAddress);
     await disassemblerInstance.initialiseDisassembler();
   } catch (e) {
     /* eslint no-console: ["error", { allow: ["warn"] }] */
@@ -59,7 +74,17 @@ async function initEmulator(code: Array<number>): Promise<void> {
   }
 }
 
-export default async function startEmulator(codeInput: string | number[]): Promise<Program> {
+function getLowestAddress(memoryMap: MemoryMap): number {
+  return Math.min(...memoryMap.regions.map((region) => region.address));
+}
+
+function getSpannedSizeInBytes(memoryMap: MemoryMap): number {
+  const endAddress = Math.max(...memoryMap.regions.map((region) => region.address + region.sizeInBytes));
+  return endAddress - getLowestAddress(memoryMap);
+}
+
+export default async function startEmulator(codeInput: string | number[], memoryMap: MemoryMap = defaultMemoryMap): Promise<Program> {
+  validateMemoryMap(memoryMap);
   let code: number[];
   if (typeof codeInput === 'string') {
     code = codeAsNumberArray(codeInput);
@@ -67,16 +92,18 @@ export default async function startEmulator(codeInput: string | number[]): Promi
     code = codeInput;
   }
 
-  return initEmulator(code)
+  return initEmulator(code, memoryMap)
     .then(() => {
       const program: Program = {
         ucInstance,
         disassemblerInstance,
-        memoryAddress: memoryStartAddress,
-        memorySizeInBytes,
+        memoryAddress: getLowestAddress(memoryMap),
+        memorySizeInBytes: getSpannedSizeInBytes(memoryMap),
+        memoryMap,
+        residentPages: getInitialResidentPages(memoryMap, code.length),
         registersToShow: registers,
         flagsToShow: flags,
-        codeAddress: memoryStartAddress,
+        codeAddress: memoryMap.codeAddress,
         codeSizeInBytes: code.length,
         code,
       };
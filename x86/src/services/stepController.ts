@@ -28,12 +28,13 @@ import Program from '@/services/interfaces/Program';
 import {
   changeRegistersToLongSizeRegisters,
 } from '@/services/dataServices/registerAssignmentService';
-import getChangeHistory, {
+import {
   addMemoryAccessHook,
   getEmptyAccessedElements,
   getNewRegistersToShow,
   getReadAccessElements,
   getWriteAccessElements,
+  setMemoryAccessesRecorded,
 } from '@/services/dataServices/accessedElementsService';
 import {
   animateGetInstruction,
@@ -41,11 +42,20 @@ import {
   animateInstructionGeneric,
   changeAnimationSpeed,
 } from '@/services/animationService/animationController';
-import { readNextInstructionBytesFromMemory } from '@/services/dataServices/memoryService';
-import { getRegisters } from '@/services/dataServices/registerService';
+import { readMemoryLine, readNextInstructionBytesFromMemory } from '@/services/dataServices/memoryService';
+import { highestMemoryAddress, validateMemoryMap } from '@/services/dataServices/memoryMapService';
+import { getFlags, getRegisters } from '@/services/dataServices/registerService';
 import { calculateNextInstructionPointer } from '@/services/dataServices/instructionPointerService';
 import rfdc from 'rfdc';
 import ReverseDebugger from '@/services/reverseStepController';
+import { traceSpan } from '@/services/helper/traceService';
+import Instruction from '@/services/interfaces/Instruction';
+import Register from '@/services/interfaces/Register';
+import RunToReturn, { RunToReturnCommand, RunToReturnResult } from '@/services/interfaces/RunToReturn';
+import { RegisterID } from '@/services/emulator/emulatorEnums';
+import { StepControllerSession } from '@/services/interfaces/SimulatorSession';
+import AccessedElements from '@/services/interfaces/AccessedElements';
+import { appendChangeRecord } from '@/services/dataServices/changeHistoryService';
 
 export default class StepController {
   private reverseDebugger: ReverseDebugger;
@@ -70,18 +80,35 @@ export default class StepController {
 
   private currentStep: CpuCycleStep;
 
-  constructor(program: Program) {
+  // a run over a call is stopped if it did not return within this number of instructions
+  private static runToReturnInstructionLimit = 1000000;
+
+  // number of change history entries which keep their changes, older entries keep their instruction only
+  static changeHistoryRetention = 10000;
+
+  // addresses of the return instructions of the code, decoded on the first run to a return
+  private returnAddresses?: Array<number>;
+
+  // A saved session continues where it was saved, its emulator has to be restored already
+  constructor(program: Program, session?: StepControllerSession) {
+    if (session !== undefined) {
+      this.steps = session.steps;
+    }
     if (this.steps.length > 0) {
-      this.currentStep = this.steps[Step.GET_INSTRUCTION];
+      this.currentStep = this.steps[session?.step ?? Step.GET_INSTRUCTION];
     } else {
       throw new Error('Steps Array is empty.');
     }
     try {
       StepController.validateProgram(program);
       this.program = program;
+      this.program.dirtyMemoryLines = new Set();
       this.program.registersToShow = changeRegistersToLongSizeRegisters(this.program.registersToShow);
-      const emptyState = getStateWithEmptyInstruction(program);
-      this.reverseDebugger = new ReverseDebugger(emptyState, program, this.steps);
+      const initialState = session?.state ?? getStateWithEmptyInstruction(program);
+      this.reverseDebugger = new ReverseDebugger(initialState, program, this.steps);
+      if (session !== undefined) {
+        this.reverseDebugger.restoreSession(session.reverseDebugger);
+      }
       this.program = this.reverseDebugger.getProgramProxy();
       this.state = this.reverseDebugger.getStateProxy();
     } catch (err: unknown) {
@@ -95,7 +122,6 @@ export default class StepController {
   }
 
   private static validateProgram(program: Program) {
-    const highestMemoryAddress = 0xFFFF;
     if (program.memoryAddress < 0 || program.memoryAddress > highestMemoryAddress) {
       throw new Error(`Memory Address ${program.memoryAddress.toString(16)} is not valid.`);
     }
@@ -108,6 +134,9 @@ export default class StepController {
     if (program.codeSizeInBytes <= 0) {
       throw new Error(`Code Size ${program.codeSizeInBytes} is not valid.`);
     }
+    if (program.memoryMap !== undefined) {
+      validateMemoryMap(program.memoryMap);
+    }
     return true;
   }
 
@@ -116,11 +145,11 @@ export default class StepController {
       const animateThisStep = this.steps[Step.GET_INSTRUCTION].animate;
       const instructionAddress = this.state.instructionPointer.address.address;
       const nextInstructionBytes: Uint8Array = readNextInstructionBytesFromMemory(instructionAddress, this.program);
-      const currentInstruction = await getCurrentInstruction(this.program, nextInstructionBytes, this.state.instructionPointer.address.address);
-      await animateGetInstruction(currentInstruction, this.state, animateThisStep);
-      this.getAccessedElementsBeforeExecution();
-      this.program.ucInstance.executeInstruction(this.state.currentInstruction);
-      this.getAccessedElementsAfterExecution();
+      const currentInstruction = await traceSpan('getCurrentInstruction', () => getCurrentInstruction(this.program, nextInstructionBytes, this.state.instructionPointer.address.address));
+      await traceSpan('animation.getInstruction', () => animateGetInstruction(currentInstruction, this.state, animateThisStep));
+      traceSpan('state.accessedElementsBeforeExecution', () => this.getAccessedElementsBeforeExecution());
+      traceSpan('emulator.executeInstruction', () => this.program.ucInstance.executeInstruction(this.state.currentInstruction));
+      traceSpan('state.accessedElementsAfterExecution', () => this.getAccessedElementsAfterExecution());
       // required to enable reverse debugger
       const byteInformationWrite = this.state.byteInformation;
       this.state.byteInformation = byteInformationWrite;
@@ -131,36 +160,40 @@ export default class StepController {
   }
 
   private getAccessedElementsBeforeExecution() {
-    this.state.currentAccessedElements = getReadAccessElements(this.state, this.program.ucInstance);
+    this.state.currentAccessedElements = getReadAccessElements(this.state, this.program);
     this.program.registersToShow = getNewRegistersToShow(this.state.currentInstruction.operands, this.program.registersToShow);
     this.state.registers = getRegisters(this.program.ucInstance, this.program.registersToShow);
   }
 
   private getAccessedElementsAfterExecution() {
-    this.state.currentAccessedElements = getWriteAccessElements(this.state, this.program.ucInstance);
+    this.state.currentAccessedElements = getWriteAccessElements(this.state, this.program);
   }
 
   private async executeInstruction() {
     const animateThisStep = this.steps[Step.EXECUTE_INSTRUCTION].animate;
-    await animateInstructionGeneric(this.state, this.program, animateThisStep)
-      .then(() => {
-        this.state.changeHistory.push(getChangeHistory(this.state.currentInstruction, this.state.currentAccessedElements));
+    await traceSpan('animation.executeInstruction', () => animateInstructionGeneric(this.state, this.program, animateThisStep))
+      .then((memoryDataChange) => {
+        this.reverseDebugger.recordMemoryDataChange(memoryDataChange);
+        traceSpan('state.changeHistory', () => this.appendChangeHistory(this.state.currentInstruction.assemblyInterpretation, this.state.currentAccessedElements));
         this.state.currentAccessedElements = getEmptyAccessedElements();
 
         // required to enable reverse debugger
-        const changeHistoryWrite = this.state.changeHistory;
         const byteInformationWrite = this.state.byteInformation;
         this.state.byteInformation = byteInformationWrite;
-        this.state.changeHistory = changeHistoryWrite;
 
         this.currentStep = this.reverseDebugger.updateStep(this.steps[Step.GET_INSTRUCTION]);
       });
   }
 
+  // The change history is appended in place, the reverse debugger truncates it instead of recording it
+  private appendChangeHistory(instruction: string, accessedElements: AccessedElements) {
+    appendChangeRecord(this.state.changeHistory, instruction, accessedElements, StepController.changeHistoryRetention);
+  }
+
   private async increaseIp() {
     const nextInstructionPointer = calculateNextInstructionPointer(this.state.currentInstruction, this.state.instructionPointer);
     const animateThisStep = this.steps[Step.INCREASE_IP].animate;
-    await animateIncreaseInstructionPointer(nextInstructionPointer, this.state, animateThisStep);
+    await traceSpan('animation.increaseIp', () => animateIncreaseInstructionPointer(nextInstructionPointer, this.state, animateThisStep));
     // required to enable reverse debugger
     const byteInformationWrite = this.state.byteInformation;
     this.state.byteInformation = byteInformationWrite;
@@ -185,18 +218,22 @@ export default class StepController {
   async previousStep() {
     const {
       modifiedState, modifiedProgram, modifiedStep,
-    } = await this.reverseDebugger.previousStep(this.state, this.program);
+    } = await traceSpan('ReverseDebugger.previousStep', () => this.reverseDebugger.previousStep(this.state, this.program));
+    const emulatorRebuilt = modifiedProgram.ucInstance !== this.program.ucInstance;
 
     this.currentStep = modifiedStep;
     this.state = modifiedState;
     this.program = modifiedProgram;
+    if (emulatorRebuilt) {
+      addMemoryAccessHook(this.state, this.program);
+    }
   }
 
   async nextStep(): Promise<boolean> {
     switch (this.currentStep.numberInCycleSequence) {
       case Step.GET_INSTRUCTION: {
         try {
-          await this.getInstruction();
+          await traceSpan('StepController.getInstruction', () => this.getInstruction());
         } catch (e) {
           /* eslint no-console: ["error", { allow: ["warn"] }] */
           console.warn(e);
@@ -205,11 +242,11 @@ export default class StepController {
         break;
       }
       case Step.INCREASE_IP: {
-        await this.increaseIp();
+        await traceSpan('StepController.increaseIp', () => this.increaseIp());
         break;
       }
       case Step.EXECUTE_INSTRUCTION: {
-        await this.executeInstruction();
+        await traceSpan('StepController.executeInstruction', () => this.executeInstruction());
         this.reverseDebugger.increaseNrOfInstructions();
         if (this.isLastStep()) {
           return false;
@@ -222,6 +259,143 @@ export default class StepController {
     return true;
   }
 
+  private getControlFlowGroup(instructionAddress: string): number {
+    const instructionBytes = readNextInstructionBytesFromMemory(instructionAddress, this.program);
+    return this.program.disassemblerInstance.getControlFlowGroup(instructionBytes, parseInt(instructionAddress, 16));
+  }
+
+  private getReturnAddresses(): Array<number> {
+    if (this.returnAddresses === undefined) {
+      const { disassemblerInstance, code, codeAddress } = this.program;
+      this.returnAddresses = disassemblerInstance.findInstructionsOfGroup(Uint8Array.from(code), codeAddress, disassemblerInstance.cs.GRP_RET);
+    }
+    return this.returnAddresses;
+  }
+
+  private getRunToReturn(command: RunToReturnCommand, instruction: Instruction): RunToReturn | undefined {
+    const { cs } = this.program.disassemblerInstance;
+    const group = this.getControlFlowGroup(instruction.address.address);
+    const runToReturn = {
+      stackPointer: this.program.ucInstance.register_read_number(RegisterID.RSP),
+      endAddress: this.state.byteInformation.code.to,
+      instructionLimit: StepController.runToReturnInstructionLimit,
+    };
+    if (command === RunToReturnCommand.STEP_OVER) {
+      // the call returns to the following instruction with the stack pointer it had before the call
+      return group !== cs.GRP_CALL ? undefined : {
+        ...runToReturn,
+        returnAddresses: [parseInt(instruction.address.address, 16) + instruction.length],
+        executeReturn: false,
+      };
+    }
+    // nested calls return with a lower stack pointer, the return of the current call with at least the current one
+    return group === cs.GRP_RET ? undefined : {
+      ...runToReturn,
+      returnAddresses: this.getReturnAddresses(),
+      executeReturn: command === RunToReturnCommand.STEP_OUT,
+    };
+  }
+
+  private static getRunToReturnLabel(command: RunToReturnCommand): string {
+    switch (command) {
+      case RunToReturnCommand.STEP_OVER:
+        return 'step over';
+      case RunToReturnCommand.STEP_OUT:
+        return 'step out';
+      default:
+        return 'run to return';
+    }
+  }
+
+  // A run which did not return is marked in the change history together with the reason it stopped
+  private getIncompleteRunLabel(runToReturn: RunToReturn): string {
+    if (this.program.ucInstance.register_read_number(RegisterID.RIP) >= runToReturn.endAddress) {
+      return 'no return before the end of the code';
+    }
+    return `no return within ${runToReturn.instructionLimit} instructions`;
+  }
+
+  // The emulator executes an instruction in the first step of its cycle, a call is in progress until the cycle is completed
+  isCallInProgress(): boolean {
+    if (this.currentStep.numberInCycleSequence === Step.GET_INSTRUCTION) {
+      return false;
+    }
+    return this.getControlFlowGroup(this.state.currentInstruction.address.address) === this.program.disassemblerInstance.cs.GRP_CALL;
+  }
+
+  /**
+   * Executes the next instruction together with the rest of its call in one emulator run.
+   * The run is recorded as one instruction with one change history entry, stepping back replays it as a whole.
+   * Returns NOT_APPLICABLE if the command does not apply to the next instruction, e.g. step over to an instruction which is no call,
+   * and INCOMPLETE if the run stopped at the instruction limit or the end of the code before the return.
+   */
+  async runToReturn(command: RunToReturnCommand): Promise<RunToReturnResult> {
+    if (this.currentStep.numberInCycleSequence !== Step.GET_INSTRUCTION || this.isLastStep()) {
+      return RunToReturnResult.NOT_APPLICABLE;
+    }
+    const instructionAddress = this.state.instructionPointer.address.address;
+    const instructionBytes = readNextInstructionBytesFromMemory(instructionAddress, this.program);
+    const instruction = await getCurrentInstruction(this.program, instructionBytes, instructionAddress);
+    const runToReturn = this.getRunToReturn(command, instruction);
+    if (runToReturn === undefined) {
+      return RunToReturnResult.NOT_APPLICABLE;
+    }
+
+    const registersBeforeRun = getRegisters(this.program.ucInstance, this.program.registersToShow);
+    const flagsBeforeRun = getFlags(this.program.ucInstance, this.program.flagsToShow);
+    await animateGetInstruction({ ...instruction, runToReturn }, this.state, false);
+    // required to enable reverse debugger, the emulator is rebuilt when stepping back over the run
+    this.program.registersToShow = getNewRegistersToShow(instruction.operands, this.program.registersToShow);
+    setMemoryAccessesRecorded(false);
+    let returned: boolean;
+    try {
+      returned = traceSpan('emulator.runToReturn', () => this.program.ucInstance.executeInstruction(this.state.currentInstruction));
+    } finally {
+      setMemoryAccessesRecorded(true);
+    }
+    const runLabel = returned ? StepController.getRunToReturnLabel(command)
+      : `${StepController.getRunToReturnLabel(command)}, ${this.getIncompleteRunLabel(runToReturn)}`;
+    // required to enable reverse debugger
+    let byteInformationWrite = this.state.byteInformation;
+    this.state.byteInformation = byteInformationWrite;
+    this.currentStep = this.reverseDebugger.updateStep(this.steps[Step.INCREASE_IP]);
+
+    await animateIncreaseInstructionPointer(calculateNextInstructionPointer(this.state.currentInstruction, this.state.instructionPointer), this.state, false);
+    byteInformationWrite = this.state.byteInformation;
+    this.state.byteInformation = byteInformationWrite;
+    this.currentStep = this.reverseDebugger.updateStep(this.steps[Step.EXECUTE_INSTRUCTION]);
+
+    // the whole run is summarized by the memory lines, registers and flags it changed
+    const changedElements = getEmptyAccessedElements();
+    changedElements.memoryWriteAccess = Array.from(this.program.dirtyMemoryLines ?? [])
+      .sort((a, b) => a - b)
+      .map((line) => readMemoryLine(this.program, line));
+    const memoryDataChange = await animateInstructionGeneric(this.state, this.program, false);
+    this.reverseDebugger.recordMemoryDataChange(memoryDataChange);
+    const registerContent = (register: Register) => register.content.map((byte) => byte.content).join();
+    const isUnchanged = (register: Register) => registersBeforeRun.some((registerBeforeRun) => registerBeforeRun.name === register.name
+      && registerContent(registerBeforeRun) === registerContent(register));
+    changedElements.registerWriteAccess = this.state.registers.filter((register) => !isUnchanged(register));
+    changedElements.flagWriteAccess = this.state.flags.filter((flag) => !flagsBeforeRun.some((flagBeforeRun) => flagBeforeRun.name === flag.name
+      && flagBeforeRun.content.content === flag.content.content));
+    this.appendChangeHistory(`${instruction.assemblyInterpretation} (${runLabel})`, changedElements);
+    byteInformationWrite = this.state.byteInformation;
+    this.state.byteInformation = byteInformationWrite;
+    this.currentStep = this.reverseDebugger.updateStep(this.steps[Step.GET_INSTRUCTION]);
+    this.reverseDebugger.increaseNrOfInstructions();
+    return returned ? RunToReturnResult.RETURNED : RunToReturnResult.INCOMPLETE;
+  }
+
+  getSession(): StepControllerSession {
+    const clone = rfdc();
+    return {
+      state: clone(this.state),
+      step: this.currentStep.numberInCycleSequence,
+      steps: clone(this.steps),
+      reverseDebugger: this.reverseDebugger.getSession(),
+    };
+  }
+
   getState(): State {
     return this.state;
   }
@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/// <reference types="node" />
+import { writeFileSync } from 'fs';
+
+// The node polyfill of the webpack config replaces the free variable process, the real one is read from globalThis
+const nodeProcess = globalThis.process;
+
+export interface LatencyStatistics {
+  samples: number;
+  meanInMs: number;
+  p50InMs: number;
+  p95InMs: number;
+  maxInMs: number;
+}
+
+export function calculateLatencyStatistics(durationsInMs: Array<number>): LatencyStatistics {
+  const sorted = [...durationsInMs].sort((a, b) => a - b);
+  const percentile = (p: number) => sorted[Math.min(sorted.length - 1, Math.floor((sorted.length * p) / 100))] || 0;
+  const sum = sorted.reduce((total, duration) => total + duration, 0);
+  return {
+    samples: sorted.length,
+    meanInMs: sorted.length > 0 ? sum / sorted.length : 0,
+    p50InMs: percentile(50),
+    p95InMs: percentile(95),
+    maxInMs: sorted.length > 0 ? sorted[sorted.length - 1] : 0,
+  };
+}
+
+export async function measure<T>(action: () => Promise<T> | T): Promise<{ result: T; durationInMs: number }> {
+  const startTime = performance.now();
+  const result = await action();
+  return { result, durationInMs: performance.now() - startTime };
+}
+
+export function isGarbageCollectionExposed(): boolean {
+  return typeof (globalThis as unknown as { gc?: () => void }).gc === 'function';
+}
+
+// Collects garbage if node runs with --expose-gc (npm run bench does), so heap measurements do not include garbage
+export function collectGarbage() {
+  const { gc } = globalThis as unknown as { gc?: () => void };
+  if (gc) {
+    gc();
+  }
+}
+
+export function getUsedHeapInBytes(): number {
+  return nodeProcess.memoryUsage().heapUsed;
+}
+
+const report: Record<string, unknown> = {};
+
+export function addToReport(name: string, result: unknown) {
+  report[name] = result;
+  console.log(`${name}: ${JSON.stringify(result)}`);
+}
+
+// The output file defaults to bench-results.json and can be changed with the environment variable BENCH_OUTPUT
+export function writeReport() {
+  const outputFile = nodeProcess.env.BENCH_OUTPUT || 'bench-results.json';
+  writeFileSync(outputFile, JSON.stringify({
+    formatVersion: 1,
+    createdAt: new Date().toISOString(),
+    nodeVersion: nodeProcess.version,
+    garbageCollectionExposed: isGarbageCollectionExposed(),
+    results: report,
+  }, null, 2));
+  console.log(`Benchmark results written to ${outputFile}`);
+}
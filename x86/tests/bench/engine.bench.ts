@@ -0,0 +1,193 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import StepController from '@/services/stepController';
+import DebuggerController from '@/services/debuggerController';
+import mapLinesToMemory from '@/services/debuggerService/mapLinesToMemoryService';
+import startEmulator from '@/services/startSimulatorService';
+import getCurrentInstruction, { disassembleCurrentInstruction } from '@/services/disassembler/instructionService';
+import { readNextInstructionBytesFromMemory } from '@/services/dataServices/memoryService';
+import { getPrebuiltMachineCode } from '@/services/editorService/prebuiltProgramService';
+import demoPrograms from '@/services/editorService/demoPrograms';
+import { nasm } from '@/services/nasm/nasm';
+import Program from '@/services/interfaces/Program';
+import { Step } from '@/services/interfaces/CpuCycleStep';
+import { getChangeHistoryLength } from '@/services/dataServices/changeHistoryService';
+import {
+  addToReport,
+  calculateLatencyStatistics,
+  collectGarbage,
+  getUsedHeapInBytes,
+  measure,
+  writeReport,
+} from './benchmarkReport';
+import { startAddExampleProgram, startStackExampleProgram } from '../unit/services/testEmulator';
+
+const decodeRepetitions = 20;
+const traceLengthsInInstructions = [10, 100, 1000];
+const reverseStepsPerTraceLength = 15;
+const loopIterations = 1000;
+
+function getDemoMachineCode(program: string): Array<number> {
+  return Array.from(getPrebuiltMachineCode(program) || []);
+}
+
+async function getLoopMachineCode(iterations: number): Promise<Array<number>> {
+  return Array.from(await nasm(`BITS 64\nmov rcx, ${iterations}\nloop:\n\tinc rax\n\tdec rcx\n\tjnz loop\n`));
+}
+
+function createStepControllerWithoutAnimations(program: Program): StepController {
+  const stepController = new StepController(program);
+  stepController.turnOfAllAnimations();
+  return stepController;
+}
+
+function countExecutedInstructions(stepController: StepController): number {
+  return getChangeHistoryLength(stepController.getState().changeHistory);
+}
+
+async function stepInstructions(stepController: StepController, instructions: number) {
+  const target = countExecutedInstructions(stepController) + instructions;
+  while (countExecutedInstructions(stepController) < target && await stepController.nextStep()) {
+    // step until the trace has the requested length
+  }
+}
+
+describe('Engine benchmark', () => {
+  after(() => {
+    writeReport();
+  });
+
+  it('measures the cold start of the demo programs', async () => {
+    const coldStarts = [];
+    for (let i = 0; i < demoPrograms.length; i += 1) {
+      const code = getDemoMachineCode(demoPrograms[i].program);
+      const emulatorStart = await measure(() => startEmulator(code));
+      const stepControllerCreation = await measure(() => createStepControllerWithoutAnimations(emulatorStart.result));
+      const lineMapping = await measure(() => mapLinesToMemory(stepControllerCreation.result.getProgram()));
+      coldStarts.push({
+        program: demoPrograms[i].label,
+        startEmulatorInMs: emulatorStart.durationInMs,
+        createStepControllerInMs: stepControllerCreation.durationInMs,
+        mapLinesToMemoryInMs: lineMapping.durationInMs,
+        totalInMs: emulatorStart.durationInMs + stepControllerCreation.durationInMs + lineMapping.durationInMs,
+      });
+      stepControllerCreation.result.getProgram().ucInstance.close();
+    }
+    addToReport('coldStart', coldStarts);
+    expect(coldStarts.length).to.equal(demoPrograms.length);
+  });
+
+  it('measures the decode latency of getCurrentInstruction', async () => {
+    const prebuiltDurations: Array<number> = [];
+    const disassemblerDurations: Array<number> = [];
+    for (let i = 0; i < demoPrograms.length; i += 1) {
+      const program = await startEmulator(getDemoMachineCode(demoPrograms[i].program));
+      const editorLines = Array.from((await mapLinesToMemory(program)).values());
+      for (let repetition = 0; repetition < decodeRepetitions; repetition += 1) {
+        for (let j = 0; j < editorLines.length; j += 1) {
+          const { instruction } = editorLines[j];
+          const bytes = readNextInstructionBytesFromMemory(instruction.address.address, program);
+          const address = parseInt(instruction.address.address, 16);
+          prebuiltDurations.push((await measure(() => getCurrentInstruction(program, bytes, instruction.address.address))).durationInMs);
+          disassemblerDurations.push((await measure(() => disassembleCurrentInstruction(program, bytes, address))).durationInMs);
+        }
+      }
+      program.ucInstance.close();
+    }
+    addToReport('decodeLatency', {
+      getCurrentInstruction: calculateLatencyStatistics(prebuiltDurations),
+      capstoneAndNdisasm: calculateLatencyStatistics(disassemblerDurations),
+    });
+    expect(prebuiltDurations.length).to.be.greaterThan(0);
+  });
+
+  it('measures the latency of nextStep with animations turned off', async () => {
+    const programs = [await startStackExampleProgram(), await startAddExampleProgram()];
+    for (let i = 0; i < demoPrograms.length; i += 1) {
+      programs.push(await startEmulator(getDemoMachineCode(demoPrograms[i].program)));
+    }
+    const durationsByStep = new Map<string, Array<number>>();
+    for (let i = 0; i < programs.length; i += 1) {
+      const stepController = createStepControllerWithoutAnimations(programs[i]);
+      let isNotLastStep = true;
+      while (isNotLastStep) {
+        const step = Step[stepController.getCurrentStep().numberInCycleSequence];
+        const { result, durationInMs } = await measure(() => stepController.nextStep());
+        isNotLastStep = result;
+        durationsByStep.set(step, [...(durationsByStep.get(step) || []), durationInMs]);
+      }
+      stepController.getProgram().ucInstance.close();
+    }
+    const latencies: Record<string, unknown> = {};
+    durationsByStep.forEach((durations, step) => {
+      latencies[step] = calculateLatencyStatistics(durations);
+    });
+    addToReport('nextStepLatency', latencies);
+    expect(durationsByStep.size).to.equal(3);
+  });
+
+  it('measures the latency of previousStep depending on the trace length', async () => {
+    const reverseStepLatencies = [];
+    for (let i = 0; i < traceLengthsInInstructions.length; i += 1) {
+      const traceLength = traceLengthsInInstructions[i];
+      const program = await startEmulator(await getLoopMachineCode(traceLength));
+      const stepController = createStepControllerWithoutAnimations(program);
+      await stepInstructions(stepController, traceLength);
+      const durations: Array<number> = [];
+      for (let step = 0; step < reverseStepsPerTraceLength && !stepController.isInitialStep(); step += 1) {
+        durations.push((await measure(() => stepController.previousStep())).durationInMs);
+      }
+      reverseStepLatencies.push({ traceLength: countExecutedInstructions(stepController), ...calculateLatencyStatistics(durations) });
+      stepController.getProgram().ucInstance.close();
+    }
+    addToReport('previousStepLatency', reverseStepLatencies);
+    expect(reverseStepLatencies.length).to.equal(traceLengthsInInstructions.length);
+  });
+
+  it('measures instructions per second and heap growth of a run to the end of the program', async () => {
+    const program = await startEmulator(await getLoopMachineCode(loopIterations));
+    const stepController = createStepControllerWithoutAnimations(program);
+    const debuggerController = new DebuggerController(stepController, await mapLinesToMemory(program));
+
+    collectGarbage();
+    const heapBeforeRun = getUsedHeapInBytes();
+    const { durationInMs } = await measure(() => debuggerController.runToEndOfProgram());
+    collectGarbage();
+    const heapGrowth = getUsedHeapInBytes() - heapBeforeRun;
+    const instructions = countExecutedInstructions(stepController);
+
+    addToReport('runToEnd', {
+      instructions,
+      durationInMs,
+      instructionsPerSecond: (instructions * 1000) / durationInMs,
+    });
+    addToReport('heapGrowth', {
+      instructions,
+      heapGrowthInBytes: heapGrowth,
+      bytesPerInstruction: heapGrowth / instructions,
+    });
+    stepController.getProgram().ucInstance.close();
+    expect(instructions).to.equal(1 + 3 * loopIterations);
+  });
+});
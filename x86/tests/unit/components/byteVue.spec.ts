@@ -28,6 +28,7 @@ import ByteInformation, {
   PointerInformation,
 } from '@/services/interfaces/ByteInformation';
 import Byte from '@/services/interfaces/Byte';
+import { createByteSet } from '@/services/dataServices/byteSetService';
 
 const localIdOfTestByte = 0x0002;
 
@@ -55,7 +56,7 @@ const byteInformationAllSet: ByteInformation = {
   basePointerInformation: pointerInformationSet,
   stackPointerInformation: pointerInformationSet,
   instructionPointerInformation: pointerInformationSet,
-  usedBytes: [0x0000, localIdOfTestByte],
+  usedBytes: createByteSet([0x0000, localIdOfTestByte]),
   code,
 };
 
@@ -66,7 +67,7 @@ const byteInformationInstructionPointerSet: ByteInformation = {
     pointerAddress: localIdOfTestByte,
     pointerBytes: [0x0000, 0x0003],
   },
-  usedBytes: [0x0000, localIdOfTestByte],
+  usedBytes: createByteSet([0x0000, localIdOfTestByte]),
   code,
 };
 
@@ -77,7 +78,7 @@ const byteInformationStackPointerSet: ByteInformation = {
     pointerBytes: [0x0000, 0x0003],
   },
   instructionPointerInformation: pointerInformationNotSet,
-  usedBytes: [0x0000, localIdOfTestByte],
+  usedBytes: createByteSet([0x0000, localIdOfTestByte]),
   code,
 };
 
@@ -88,7 +89,7 @@ const byteInformationBasePointerSet: ByteInformation = {
   },
   stackPointerInformation: pointerInformationNotSet,
   instructionPointerInformation: pointerInformationNotSet,
-  usedBytes: [0x0000, localIdOfTestByte],
+  usedBytes: createByteSet([0x0000, localIdOfTestByte]),
   code,
 };
 
@@ -99,7 +100,7 @@ const byteInformationInstructionBytesSet: ByteInformation = {
     pointerAddress: 0x0003,
     pointerBytes: [0x0000, localIdOfTestByte],
   },
-  usedBytes: [0x0000, localIdOfTestByte],
+  usedBytes: createByteSet([0x0000, localIdOfTestByte]),
   code,
 };
 
@@ -110,7 +111,7 @@ const byteInformationStackBytesSet: ByteInformation = {
     pointerBytes: [0x0000, localIdOfTestByte],
   },
   instructionPointerInformation: pointerInformationNotSet,
-  usedBytes: [0x0000, localIdOfTestByte],
+  usedBytes: createByteSet([0x0000, localIdOfTestByte]),
   code,
 };
 
@@ -121,7 +122,7 @@ const byteInformationBaseBytesSet: ByteInformation = {
   },
   stackPointerInformation: pointerInformationNotSet,
   instructionPointerInformation: pointerInformationNotSet,
-  usedBytes: [0x0000, localIdOfTestByte],
+  usedBytes: createByteSet([0x0000, localIdOfTestByte]),
   code,
 };
 
@@ -129,7 +130,7 @@ const byteInformationOnlyStackBytesSet: ByteInformation = {
   basePointerInformation: pointerInformationSet,
   stackPointerInformation: pointerInformationSet,
   instructionPointerInformation: pointerInformationNotSet,
-  usedBytes: [0x0000, localIdOfTestByte],
+  usedBytes: createByteSet([0x0000, localIdOfTestByte]),
   code,
 };
 
@@ -137,7 +138,7 @@ const byteInformationStackBytesNotSetIfUnused: ByteInformation = {
   basePointerInformation: pointerInformationSet,
   stackPointerInformation: pointerInformationSet,
   instructionPointerInformation: pointerInformationNotSet,
-  usedBytes: [0x0000],
+  usedBytes: createByteSet([0x0000]),
   code,
 };
 
@@ -145,7 +146,7 @@ const byteInformationUnusedByteSet: ByteInformation = {
   basePointerInformation: pointerInformationNotSet,
   stackPointerInformation: pointerInformationNotSet,
   instructionPointerInformation: pointerInformationNotSet,
-  usedBytes: [0x0000, 0x0003],
+  usedBytes: createByteSet([0x0000, 0x0003]),
   code,
 };
 
@@ -153,7 +154,7 @@ const byteInformationNothingSet: ByteInformation = {
   basePointerInformation: emptyPointerInformation,
   stackPointerInformation: emptyPointerInformation,
   instructionPointerInformation: emptyPointerInformation,
-  usedBytes: [localIdOfTestByte],
+  usedBytes: createByteSet([localIdOfTestByte]),
   code,
 };
 
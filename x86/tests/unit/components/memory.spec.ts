@@ -27,6 +27,7 @@ import MemoryAreaData from '@/components/memory/MemoryAreaData.vue';
 import MemoryAreaHeader from '@/components/memory/MemoryAreaHeader.vue';
 import MemoryData from '@/services/interfaces/MemoryData';
 import MemoryLine from '@/components/memory/MemoryLine.vue';
+import { revealMemoryBytes } from '@/services/animationService/scrollHelper';
 import {
   testDataMemory,
   testDataState,
@@ -51,11 +52,23 @@ describe('Memory.vue Component', () => {
 });
 
 describe('MemoryAreaData.vue Component', () => {
-  it('renders all memory lines when passed', () => {
+  it('renders only the memory lines of the scroll window when passed', () => {
     const wrapper = shallowMount(MemoryAreaData, {
       props: { memoryData: expectedMemory },
     });
-    expect(wrapper.findAllComponents(MemoryLine).length).to.be.equal(256);
+    const memoryLines = wrapper.findAllComponents(MemoryLine);
+    expect(memoryLines.length).to.be.equal(40);
+    expect(memoryLines[0].props('memoryLine')).to.eql(expectedMemory.memoryDataLines[0]);
+    wrapper.unmount();
+  });
+  it('renders memory line of animation target when revealed', async () => {
+    const wrapper = shallowMount(MemoryAreaData, {
+      props: { memoryData: expectedMemory },
+    });
+    await revealMemoryBytes(['8FF3']);
+    const memoryLines = wrapper.findAllComponents(MemoryLine);
+    expect(memoryLines[memoryLines.length - 1].props('memoryLine')).to.eql(expectedMemory.memoryDataLines[255]);
+    wrapper.unmount();
   });
 });
 
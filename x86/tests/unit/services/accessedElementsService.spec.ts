@@ -26,6 +26,7 @@ import getChangeHistory, {
   getNewRegistersToShow,
 } from '@/services/dataServices/accessedElementsService';
 import { RegisterID } from '@/services/emulator/emulatorEnums';
+import { createRegisterMask } from '@/services/dataServices/registerMaskService';
 import { ChangeHistory } from '@/services/interfaces/State';
 import MemoryDataLine from '@/services/interfaces/MemoryDataLine';
 import AccessedElements from '@/services/interfaces/AccessedElements';
@@ -48,6 +49,23 @@ describe('getNewRegistersToShow', () => {
   it('succeeds if both registers added to registersToShow', () => {
     expect(getNewRegistersToShow(testDataInstructionOperands, [])).to.eql([RegisterID.RBX, RegisterID.RAX]);
   });
+  it('succeeds if registersToShow not changed with register masks', () => {
+    const operandsWithMasks = {
+      ...testDataInstructionOperands,
+      registersReadMask: createRegisterMask([RegisterID.RBX, RegisterID.RAX]),
+      registersWriteMask: createRegisterMask([RegisterID.RBX]),
+    };
+    const registersToShow = [RegisterID.RBX, RegisterID.RAX, RegisterID.RSP];
+    expect(getNewRegistersToShow(operandsWithMasks, registersToShow)).to.equal(registersToShow);
+  });
+  it('succeeds if Rax added to registersToShow with register masks', () => {
+    const operandsWithMasks = {
+      ...testDataInstructionOperands,
+      registersReadMask: createRegisterMask([RegisterID.RBX, RegisterID.RAX]),
+      registersWriteMask: createRegisterMask([RegisterID.RBX]),
+    };
+    expect(getNewRegistersToShow(operandsWithMasks, [RegisterID.RBX])).to.eql([RegisterID.RBX, RegisterID.RAX]);
+  });
 });
 
 describe('getNewRegistersToShow', () => {
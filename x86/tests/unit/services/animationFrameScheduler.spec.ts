@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import {
+  clearPhaseFrameTimings,
+  getPhaseFrameTimings,
+  measurePhaseFrames,
+} from '@/services/animationService/animationFrameScheduler';
+
+function waitFor(milliseconds: number): Promise<void> {
+  return new Promise((resolve) => { setTimeout(resolve, milliseconds); });
+}
+
+describe('animation frame scheduler', () => {
+  beforeEach(() => {
+    clearPhaseFrameTimings();
+  });
+
+  it('records the frames of an animated phase when it ends', async () => {
+    const phaseEnd = waitFor(100);
+    measurePhaseFrames('memoryLine', 8, phaseEnd);
+    expect(getPhaseFrameTimings()).to.have.length(0);
+    await phaseEnd;
+    await waitFor(0);
+
+    const timings = getPhaseFrameTimings();
+    expect(timings).to.have.length(1);
+    expect(timings[0].phase).to.equal('memoryLine');
+    expect(timings[0].byteMoves).to.equal(8);
+    expect(timings[0].frames).to.be.greaterThan(0);
+    expect(timings[0].durationInMs).to.be.at.least(50);
+  });
+
+  it('measures overlapping phases in the same frame loop', async () => {
+    const firstPhaseEnd = waitFor(50);
+    const secondPhaseEnd = waitFor(100);
+    measurePhaseFrames('register', 8, firstPhaseEnd);
+    measurePhaseFrames('flag', 1, secondPhaseEnd);
+    await secondPhaseEnd;
+    await waitFor(0);
+
+    expect(getPhaseFrameTimings().map((timing) => timing.phase)).to.eql(['register', 'flag']);
+  });
+});
@@ -26,17 +26,18 @@ import {
   byteInformationUsedBytesContainsAddressNumber,
   updateUsedBytesInByteInformation,
 } from '@/services/dataServices/byteInformationService';
+import { createByteSet, getAddressesOfByteSet } from '@/services/dataServices/byteSetService';
 import { testDataMemory } from './testDataCurrentState';
 
 describe('updateUsedBytesInByteInformation', () => {
   it('succeeds if locationIds created', () => {
-    const usedBytes = [8];
+    const usedBytes = createByteSet([8]);
     const memLines = [testDataMemory.memoryDataLines[0], testDataMemory.memoryDataLines[3]];
     updateUsedBytesInByteInformation(memLines, usedBytes);
-    expect(usedBytes).to.eql([8, 0x8000, 0x8001, 0x8002, 0x8003, 0x8004, 0x8005, 0x8006, 0x8007, 0x8008, 0x8009, 0x800A, 0x800B, 0x800C, 0x800D, 0x800E, 0x800F, 0x8030, 0x8031, 0x8032, 0x8033, 0x8034, 0x8035, 0x8036, 0x8037, 0x8038, 0x8039, 0x803A, 0x803B, 0x803C, 0x803D, 0x803E, 0x803F]);
+    expect(getAddressesOfByteSet(usedBytes)).to.eql([8, 0x8000, 0x8001, 0x8002, 0x8003, 0x8004, 0x8005, 0x8006, 0x8007, 0x8008, 0x8009, 0x800A, 0x800B, 0x800C, 0x800D, 0x800E, 0x800F, 0x8030, 0x8031, 0x8032, 0x8033, 0x8034, 0x8035, 0x8036, 0x8037, 0x8038, 0x8039, 0x803A, 0x803B, 0x803C, 0x803D, 0x803E, 0x803F]);
   });
   it('succeeds if empty MemoryLine creates no locationIds', () => {
-    const usedBytes = [8];
+    const usedBytes = createByteSet([8]);
     const emptyMemLine: MemoryDataLine = {
       address: {
         address: '',
@@ -44,12 +45,12 @@ describe('updateUsedBytesInByteInformation', () => {
       dataBytes: [],
     };
     updateUsedBytesInByteInformation([emptyMemLine], usedBytes);
-    expect(usedBytes).to.eql([8]);
+    expect(getAddressesOfByteSet(usedBytes)).to.eql([8]);
   });
 });
 
 describe('byteInformationUsedBytesContainsLocalId', () => {
-  const usedBytes = [0x1000, 0xABCD, 0x1234];
+  const usedBytes = createByteSet([0x1000, 0xABCD, 0x1234]);
   it('succeeds if locationId found', () => {
     expect(byteInformationUsedBytesContainsAddressNumber(0x1234, usedBytes)).to.eql(true);
   });
@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import {
+  addBytesToSet,
+  byteSetContains,
+  byteSetsEqual,
+  cloneByteSet,
+  createByteSet,
+  getAddressesOfByteSet,
+} from '@/services/dataServices/byteSetService';
+
+describe('byteSetService', () => {
+  it('succeeds if bytes of different pages contained', () => {
+    const byteSet = createByteSet([0x0003, 0x101F, 0x00FFFFFF]);
+    expect(byteSetContains(byteSet, 0x0003)).to.eql(true);
+    expect(byteSetContains(byteSet, 0x101F)).to.eql(true);
+    expect(byteSetContains(byteSet, 0x00FFFFFF)).to.eql(true);
+    expect(byteSetContains(byteSet, 0x0004)).to.eql(false);
+    expect(byteSetContains(byteSet, 0x2000)).to.eql(false);
+  });
+  it('succeeds if addresses returned in ascending order without duplicates', () => {
+    const byteSet = createByteSet([0x1000, 0x0020, 0x0020]);
+    addBytesToSet(byteSet, 0x0FFE, 3);
+    expect(getAddressesOfByteSet(byteSet)).to.eql([0x0020, 0x0FFE, 0x0FFF, 0x1000]);
+  });
+  it('succeeds if byte sets compared by content', () => {
+    const byteSet = createByteSet([0x0020]);
+    const otherByteSet = createByteSet([0x0020]);
+    otherByteSet.pages[0x5000] = new Uint32Array(128);
+    expect(byteSetsEqual(byteSet, otherByteSet)).to.eql(true);
+    addBytesToSet(otherByteSet, 0x5000, 1);
+    expect(byteSetsEqual(byteSet, otherByteSet)).to.eql(false);
+  });
+  it('succeeds if clone independent of original', () => {
+    const byteSet = createByteSet([0x0020]);
+    const clone = cloneByteSet(byteSet);
+    addBytesToSet(byteSet, 0x0021, 1);
+    expect(getAddressesOfByteSet(clone)).to.eql([0x0020]);
+  });
+});
@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import rfdc from 'rfdc';
+import {
+  appendChangeRecord,
+  createChangeHistoryLog,
+  formatChangeHistoryEntries,
+  formatChangeHistoryEntry,
+  getChangeHistoryLength,
+  internString,
+  shareChangeHistory,
+  truncateChangeHistory,
+} from '@/services/dataServices/changeHistoryService';
+import { getEmptyAccessedElements } from '@/services/dataServices/accessedElementsService';
+import AccessedElements from '@/services/interfaces/AccessedElements';
+import { testDataFlags, testDataRegisters } from './testDataCurrentState';
+
+const accessedElements: AccessedElements = {
+  ...getEmptyAccessedElements(),
+  memoryWriteAccess: [{
+    address: { address: '0010' },
+    dataBytes: [{ content: '13', locationId: 'immediate_0_0' }, { content: 'FF', locationId: 'immediate_0_1' }],
+  }],
+  registerWriteAccess: [testDataRegisters[0]],
+  flagWriteAccess: [testDataFlags[0], testDataFlags[1]],
+};
+
+function appendInstructions(retention: number, instructions: number) {
+  const log = createChangeHistoryLog();
+  for (let instruction = 0; instruction < instructions; instruction += 1) {
+    appendChangeRecord(log, `inc rax ; ${instruction}`, accessedElements, retention);
+  }
+  return log;
+}
+
+describe('changeHistoryService', () => {
+  it('formats the records only when they are shown', () => {
+    const log = createChangeHistoryLog();
+    appendChangeRecord(log, 'mov [rbx], ax', accessedElements, 10);
+    expect(log.records[0].instructionIndex).to.equal(0);
+    expect(formatChangeHistoryEntry(log, 0)).to.eql({
+      instruction: 'mov [rbx], ax',
+      changedElements: [
+        '[0x0010]: 13 FF',
+        'RAX: FF FF FF FF 00 00 00 00',
+        'Flags: CF: 0, OF: 0',
+      ],
+    });
+  });
+
+  it('interns instructions, names and byte contents', () => {
+    const log = createChangeHistoryLog();
+    appendChangeRecord(log, 'mov [rbx], ax', accessedElements, 10);
+    const { length } = log.strings;
+    appendChangeRecord(log, 'mov [rbx], ax', accessedElements, 10);
+    expect(log.strings.length).to.equal(length);
+    expect(log.records[1].instruction).to.equal(log.records[0].instruction);
+    expect(internString(log, 'FF')).to.equal(log.records[0].memory[0].content[1]);
+  });
+
+  it('keeps interning after the log was copied', () => {
+    const log = rfdc()(appendInstructions(10, 2));
+    const { length } = log.strings;
+    appendChangeRecord(log, 'inc rax ; 1', accessedElements, 10);
+    expect(log.strings.length).to.equal(length);
+    expect(formatChangeHistoryEntry(log, 2)).to.eql(formatChangeHistoryEntry(log, 1));
+  });
+
+  it('spills the records outside of the retention window', () => {
+    const log = appendInstructions(8, 100);
+    expect(getChangeHistoryLength(log)).to.equal(100);
+    expect(log.records.length).to.be.at.most(8);
+    expect(log.spilledCount + log.recordCount).to.equal(100);
+    expect(log.records[log.records.length - 1].instructionIndex).to.equal(99);
+    expect(formatChangeHistoryEntry(log, 0)).to.eql({ instruction: 'inc rax ; 0', changedElements: [] });
+    expect(formatChangeHistoryEntry(log, 99).instruction).to.equal('inc rax ; 99');
+    expect(formatChangeHistoryEntry(log, 99).changedElements).to.have.length(3);
+  });
+
+  it('formats a range of entries', () => {
+    const log = appendInstructions(8, 20);
+    const entries = formatChangeHistoryEntries(log, 15, 10);
+    expect(entries.map((entry) => entry.instruction)).to.eql(['inc rax ; 15', 'inc rax ; 16', 'inc rax ; 17', 'inc rax ; 18', 'inc rax ; 19']);
+  });
+
+  it('truncates the records and the spilled entries', () => {
+    const log = appendInstructions(8, 100);
+    truncateChangeHistory(log, 98);
+    expect(getChangeHistoryLength(log)).to.equal(98);
+    expect(formatChangeHistoryEntry(log, 97).instruction).to.equal('inc rax ; 97');
+
+    truncateChangeHistory(log, 10);
+    expect(getChangeHistoryLength(log)).to.equal(10);
+    expect(log.records).to.have.length(0);
+
+    appendChangeRecord(log, 'dec rax', accessedElements, 8);
+    expect(log.records[0].instructionIndex).to.equal(10);
+    expect(formatChangeHistoryEntry(log, 10).instruction).to.equal('dec rax');
+  });
+
+  it('prunes the strings of the spilled records', () => {
+    const log = createChangeHistoryLog();
+    for (let instruction = 0; instruction < 100; instruction += 1) {
+      const memoryLine = { address: { address: instruction.toString(16).padStart(4, '0') }, dataBytes: [] };
+      appendChangeRecord(log, 'push rax', { ...getEmptyAccessedElements(), memoryWriteAccess: [memoryLine] }, 8);
+    }
+    expect(log.strings.length).to.be.at.most(8);
+    expect(log.instructions).to.eql(['push rax']);
+    expect(formatChangeHistoryEntry(log, 99).changedElements[0]).to.contain('0063');
+  });
+
+  it('shares its storage with snapshots, which keep their entries', () => {
+    const log = appendInstructions(8, 6);
+    const snapshot = shareChangeHistory(log);
+    expect(snapshot.records).to.equal(log.records);
+
+    appendChangeRecord(log, 'dec rax', accessedElements, 8);
+    expect(getChangeHistoryLength(snapshot)).to.equal(6);
+    expect(getChangeHistoryLength(log)).to.equal(7);
+
+    truncateChangeHistory(log, 3);
+    appendChangeRecord(log, 'dec rbx', accessedElements, 8);
+    expect(formatChangeHistoryEntry(snapshot, 3).instruction).to.equal('inc rax ; 3');
+    expect(formatChangeHistoryEntry(log, 3).instruction).to.equal('dec rbx');
+
+    for (let instruction = 0; instruction < 20; instruction += 1) {
+      appendChangeRecord(log, 'dec rcx', accessedElements, 8);
+    }
+    expect(formatChangeHistoryEntries(snapshot, 0, 6).map((entry) => entry.instruction))
+      .to.eql(['inc rax ; 0', 'inc rax ; 1', 'inc rax ; 2', 'inc rax ; 3', 'inc rax ; 4', 'inc rax ; 5']);
+    expect(formatChangeHistoryEntry(snapshot, 5).changedElements).to.have.length(3);
+  });
+});
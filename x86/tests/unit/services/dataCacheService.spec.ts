@@ -0,0 +1,141 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import {
+  DataCache, defaultDataCacheConfiguration, getCacheCountsPerSourceLine, getDataCacheStatistics, setDataCache, validateDataCacheConfiguration,
+} from '@/services/dataServices/dataCacheService';
+import { DataCacheConfiguration, ReplacementPolicy } from '@/services/interfaces/DataCache';
+import EditorLine from '@/services/interfaces/codeEditor/EditorLine';
+import startEmulator from '@/services/startSimulatorService';
+import getStateWithEmptyInstruction from '@/services/dataServices/fillDataService';
+import { addMemoryAccessHook } from '@/services/dataServices/accessedElementsService';
+
+function configuration(sizeInBytes: number, associativity: number, replacementPolicy = ReplacementPolicy.LRU): DataCacheConfiguration {
+  return {
+    sizeInBytes, lineSizeInBytes: 64, associativity, replacementPolicy,
+  };
+}
+
+function accessAll(cache: DataCache, addresses: Array<number>) {
+  addresses.forEach((address) => cache.record(address, 4, 0x10));
+}
+
+describe('dataCacheService', () => {
+  it('validates the configuration', () => {
+    expect(validateDataCacheConfiguration(defaultDataCacheConfiguration)).to.equal(true);
+    expect(() => new DataCache(configuration(3000, 1))).to.throw('Cache size 3000 is not a power of two.');
+    expect(() => new DataCache({ ...configuration(32, 1), lineSizeInBytes: 64 })).to.throw('Cache line size 64');
+    expect(() => new DataCache(configuration(256, 8))).to.throw('Associativity 8');
+  });
+
+  it('misses on conflicts in a direct mapped cache', () => {
+    const directMapped = new DataCache(configuration(256, 1));
+    const twoWay = new DataCache(configuration(256, 2));
+    accessAll(directMapped, [0x000, 0x100, 0x000]);
+    accessAll(twoWay, [0x000, 0x100, 0x000]);
+
+    expect(directMapped.getStatistics()).to.include({ hits: 0, misses: 3 });
+    expect(twoWay.getStatistics()).to.include({ hits: 1, misses: 2 });
+  });
+
+  it('evicts by last use with LRU and by fill order with FIFO', () => {
+    const lru = new DataCache(configuration(128, 2, ReplacementPolicy.LRU));
+    const fifo = new DataCache(configuration(128, 2, ReplacementPolicy.FIFO));
+    accessAll(lru, [0x00, 0x40, 0x00, 0x80, 0x00]);
+    accessAll(fifo, [0x00, 0x40, 0x00, 0x80, 0x00]);
+
+    expect(lru.getStatistics()).to.include({ hits: 2, misses: 3 });
+    expect(fifo.getStatistics()).to.include({ hits: 1, misses: 4 });
+  });
+
+  it('replaces randomly but reproducibly', () => {
+    const addresses = Array.from({ length: 1000 }, (_, index) => ((index * 7919) % 64) * 64);
+    const first = new DataCache(configuration(1024, 4, ReplacementPolicy.RANDOM));
+    const second = new DataCache(configuration(1024, 4, ReplacementPolicy.RANDOM));
+    accessAll(first, addresses);
+    accessAll(second, addresses);
+
+    const statistics = first.getStatistics();
+    expect(statistics.hits + statistics.misses).to.equal(1000);
+    expect(second.getStatistics()).to.include({ hits: statistics.hits, misses: statistics.misses });
+  });
+
+  it('counts accesses spanning two lines for both lines', () => {
+    const cache = new DataCache(defaultDataCacheConfiguration);
+    cache.record(0x3E, 4, 0x10);
+    const statistics = cache.getStatistics();
+
+    expect(statistics.misses).to.equal(2);
+    expect(statistics.perInstruction.get(0x10)).to.eql({ hits: 0, misses: 2 });
+    expect(statistics.perMemoryLine.get(0x30)).to.eql({ hits: 0, misses: 1 });
+    expect(statistics.perMemoryLine.get(0x40)).to.eql({ hits: 0, misses: 1 });
+  });
+
+  it('copies the statistics only after they changed', () => {
+    const cache = new DataCache(defaultDataCacheConfiguration);
+    accessAll(cache, [0x000]);
+    const statistics = cache.getStatistics();
+    expect(cache.getStatistics()).to.equal(statistics);
+
+    accessAll(cache, [0x000]);
+    expect(cache.getStatistics()).to.not.equal(statistics).and.to.include({ hits: 1, misses: 1 });
+    expect(statistics).to.include({ hits: 0, misses: 1 });
+
+    const beforeReset = cache.getStatistics();
+    cache.reset();
+    expect(cache.getStatistics()).to.not.equal(beforeReset).and.to.include({ hits: 0, misses: 0 });
+  });
+
+  it('simulates the buffered accesses in batches', () => {
+    const cache = new DataCache(defaultDataCacheConfiguration);
+    for (let i = 0; i < 5000; i += 1) {
+      cache.record(0x100, 1, 0x10);
+    }
+    expect(cache.getStatistics()).to.include({ hits: 4999, misses: 1 });
+
+    cache.reset();
+    expect(cache.getStatistics()).to.include({ hits: 0, misses: 0 });
+  });
+
+  it('is fed by the memory hooks of the emulator', async () => {
+    // mov ecx, 100; loop: mov eax, [0x200]; mov [0x240], eax; dec ecx; jnz loop
+    const code = [0xB9, 100, 0, 0, 0, 0x8B, 0x04, 0x25, 0x00, 0x02, 0, 0, 0x89, 0x04, 0x25, 0x40, 0x02, 0, 0, 0xFF, 0xC9, 0x75, 0xEE];
+    const program = await startEmulator(code);
+    addMemoryAccessHook(getStateWithEmptyInstruction(program), program);
+    const loadLine = { line: 2, memoryAddressFrom: { address: '0005' } } as EditorLine;
+    setDataCache(defaultDataCacheConfiguration, new Map([[2, loadLine]]));
+    program.ucInstance.emu_start(0, code.length, 0, 0);
+
+    const statistics = getDataCacheStatistics();
+    setDataCache();
+    program.ucInstance.close();
+    expect(statistics).to.not.equal(undefined);
+    if (statistics !== undefined) {
+      expect(statistics.perInstruction.get(0x05)).to.eql({ hits: 99, misses: 1 });
+      expect(statistics.perInstruction.get(0x0C)).to.eql({ hits: 99, misses: 1 });
+      expect(statistics.perMemoryLine.get(0x200)).to.eql({ hits: 99, misses: 1 });
+      expect(statistics.perMemoryLine.get(0x240)).to.eql({ hits: 99, misses: 1 });
+      expect(Array.from(getCacheCountsPerSourceLine(statistics))).to.eql([[2, { hits: 99, misses: 1 }]]);
+    }
+  });
+});
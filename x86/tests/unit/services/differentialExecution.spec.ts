@@ -0,0 +1,122 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import runDifferentialExecution from '@/services/differentialService/differentialExecutionService';
+import { RegisterID } from '@/services/emulator/emulatorEnums';
+import { FlagID } from '@/services/interfaces/Flag';
+import { DifferentialRequest, LockstepMode } from '@/services/interfaces/DifferentialExecution';
+
+// mov ecx, iterations; loop: inc eax; dec ecx; jnz loop
+function countingLoop(iterations: number): Array<number> {
+  return [0xB9, iterations % 0x100, Math.floor(iterations / 0x100) % 0x100, 0, 0, 0xFF, 0xC0, 0xFF, 0xC9, 0x75, 0xFA];
+}
+
+function request(reference: Array<number>, candidate: Array<number>, mode = LockstepMode.INSTRUCTION): DifferentialRequest {
+  return {
+    reference: { code: reference },
+    candidate: { code: candidate },
+    mode,
+    registers: [RegisterID.RAX],
+    flags: [FlagID.ZF],
+    memoryRanges: [],
+    instructionLimit: 1000000,
+  };
+}
+
+describe('differentialExecutionService', () => {
+  it('runs equal programs to their end', async () => {
+    const result = await runDifferentialExecution(request(countingLoop(10000), countingLoop(10000)));
+
+    expect(result.divergence).to.equal(undefined);
+    expect(result.comparedPoints).to.equal(30001);
+    expect(result.reference.finished).to.equal(true);
+    expect(result.candidate.finished).to.equal(true);
+    expect(result.instructionLimitReached).to.equal(false);
+  });
+
+  it('locates the first diverging instruction within a chunk', async () => {
+    const result = await runDifferentialExecution(request(countingLoop(2000), countingLoop(3000)));
+
+    expect(result.comparedPoints).to.equal(5999);
+    expect(result.reference.executedInstructions).to.equal(6000);
+    expect(result.candidate.executedInstructions).to.equal(6000);
+    expect(result.divergence?.flags).to.eql(['ZF']);
+    expect(result.divergence?.registers).to.eql([]);
+  });
+
+  it('reports the differing memory ranges', async () => {
+    // mov eax, 7; mov [0x200], eax
+    const reference = [0xB8, 0x07, 0, 0, 0, 0x89, 0x04, 0x25, 0x00, 0x02, 0, 0];
+    // mov eax, 7; mov [0x201], eax
+    const candidate = [0xB8, 0x07, 0, 0, 0, 0x89, 0x04, 0x25, 0x01, 0x02, 0, 0];
+    const result = await runDifferentialExecution({ ...request(reference, candidate), memoryRanges: [{ address: 0x200, sizeInBytes: 16 }] });
+
+    expect(result.comparedPoints).to.equal(1);
+    expect(result.divergence?.memoryRanges).to.eql([0x200, 0x202]);
+    expect(Array.from(result.reference.memory[0].content.slice(0, 5))).to.eql([7, 0, 0, 0, 0]);
+    expect(Array.from(result.candidate.memory[0].content.slice(0, 5))).to.eql([0, 7, 0, 0, 0]);
+  });
+
+  it('reports a difference which vanishes again within the chunk', async () => {
+    // nop; nop; nop
+    const reference = [0x90, 0x90, 0x90];
+    // inc eax; dec eax; nop
+    const candidate = [0xFF, 0xC0, 0xFF, 0xC8, 0x90];
+    const result = await runDifferentialExecution(request(reference, candidate));
+
+    expect(result.comparedPoints).to.equal(0);
+    expect(result.candidate.executedInstructions).to.equal(1);
+    expect(result.divergence?.registers).to.eql(['RAX']);
+  });
+
+  it('reports a memory difference which vanishes again within the chunk', async () => {
+    // nop; nop; nop
+    const reference = [0x90, 0x90, 0x90];
+    // mov byte [0x200], 1; mov byte [0x200], 0; nop
+    const candidate = [0xC6, 0x04, 0x25, 0x00, 0x02, 0, 0, 0x01, 0xC6, 0x04, 0x25, 0x00, 0x02, 0, 0, 0x00, 0x90];
+    const result = await runDifferentialExecution({ ...request(reference, candidate), memoryRanges: [{ address: 0x200, sizeInBytes: 16 }] });
+
+    expect(result.comparedPoints).to.equal(0);
+    expect(result.candidate.executedInstructions).to.equal(1);
+    expect(result.divergence?.memoryRanges).to.eql([0x200, 0x201]);
+  });
+
+  it('compares only at system calls in observation point mode', async () => {
+    // mov eax, 3; syscall
+    const reference = [0xB8, 0x03, 0, 0, 0, 0x0F, 0x05];
+    // mov eax, 1; add eax, 2; syscall
+    const candidate = [0xB8, 0x01, 0, 0, 0, 0x83, 0xC0, 0x02, 0x0F, 0x05];
+    // mov eax, 4; syscall
+    const wrongCandidate = [0xB8, 0x04, 0, 0, 0, 0x0F, 0x05];
+
+    const result = await runDifferentialExecution(request(reference, candidate, LockstepMode.OBSERVATION_POINT));
+    expect(result.divergence).to.equal(undefined);
+    expect(result.reference.executedInstructions).to.equal(2);
+    expect(result.candidate.executedInstructions).to.equal(3);
+
+    const wrongResult = await runDifferentialExecution(request(reference, wrongCandidate, LockstepMode.OBSERVATION_POINT));
+    expect(wrongResult.comparedPoints).to.equal(0);
+    expect(wrongResult.divergence?.registers).to.eql(['RAX']);
+    expect(wrongResult.reference.executedInstructions).to.equal(1);
+  });
+});
@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import Unicorn from '@/services/emulator/emulatorService';
+import Disassembler from '@/services/disassembler/disassemblerService';
+import { getMemory } from '@/services/dataServices/memoryService';
+import {
+  getEmptyMemoryDataChange,
+  markMemoryLinesDirty,
+  revertMemoryDataChange,
+  updateDirtyMemoryLines,
+} from '@/services/dataServices/dirtyMemoryService';
+import { sectionedMemoryMap, markAccessedPagesResident } from '@/services/dataServices/memoryMapService';
+import startEmulator from '@/services/startSimulatorService';
+import { closeEmulator, startSimpleTestProgram } from './testEmulator';
+
+describe('dirtyMemoryService', async () => {
+  const ucInstance = new Unicorn();
+  const disassemblerInstance = new Disassembler();
+
+  await startSimpleTestProgram(ucInstance, disassemblerInstance).then(async (program) => {
+    const dirtyMemoryLines = new Set<number>();
+    program.dirtyMemoryLines = dirtyMemoryLines;
+    const memoryData = getMemory(program);
+    const unchangedLine = memoryData.memoryDataLines[0];
+    const originalLines = [...memoryData.memoryDataLines];
+
+    ucInstance.memory_write(0x801C, [1, 2, 3, 4, 5, 6, 7, 8]);
+    markMemoryLinesDirty(program, 0x801C, 8);
+    markMemoryLinesDirty(program, 0x8000 + 0x40, 1);
+    markMemoryLinesDirty(program, 0x8014, 2);
+    const dirtyLines = [...dirtyMemoryLines];
+
+    const memoryDataChange = getEmptyMemoryDataChange();
+    updateDirtyMemoryLines(memoryData, program, memoryDataChange);
+    const expectedMemory = getMemory(program);
+    const patchedLines = [...memoryData.memoryDataLines];
+
+    revertMemoryDataChange(memoryData, memoryDataChange, program);
+    closeEmulator(program);
+
+    it('succeeds if dirty lines unique', () => {
+      expect(dirtyLines).to.eql([0x8010, 0x8020, 0x8040]);
+    });
+    it('succeeds if dirty lines patched and cleared', () => {
+      expect({ memoryDataLines: patchedLines }).to.eql(expectedMemory);
+      expect(dirtyMemoryLines.size).to.eql(0);
+      expect(memoryDataChange.replacedLines.length).to.eql(3);
+    });
+    it('succeeds if clean lines keep their identity', () => {
+      expect(patchedLines[0]).to.equal(unchangedLine);
+    });
+    it('succeeds if change reverted', () => {
+      expect(memoryData.memoryDataLines).to.eql(originalLines);
+    });
+  });
+});
+
+describe('dirtyMemoryService with paged memory', () => {
+  it('succeeds if new resident page inserted and removed on revert', async () => {
+    const program = await startEmulator([0x6A, 0x06], sectionedMemoryMap);
+    program.dirtyMemoryLines = new Set();
+    const memoryData = getMemory(program);
+    markAccessedPagesResident(program, 0x00100000, 8);
+    markMemoryLinesDirty(program, 0x00100000, 8);
+
+    const memoryDataChange = getEmptyMemoryDataChange();
+    updateDirtyMemoryLines(memoryData, program, memoryDataChange);
+    expect(memoryData.memoryDataLines.length).to.eql(3 * 256);
+    expect(memoryData.memoryDataLines[256].address.address).to.eql('100000');
+    expect(memoryDataChange.insertedPages).to.eql([0x00100000]);
+
+    revertMemoryDataChange(memoryData, memoryDataChange, program);
+    expect(memoryData.memoryDataLines.length).to.eql(2 * 256);
+    expect(program.residentPages).to.not.include(0x00100000);
+    program.ucInstance.close();
+  });
+});
@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import Disassembler from '@/services/disassembler/disassemblerService';
+
+// mov rcx, 3 / inc rax / dec rcx / jnz -8 / mov [0x20], rbx / call 0x0
+const code = Uint8Array.from([
+  0x48, 0xC7, 0xC1, 0x03, 0x00, 0x00, 0x00, 0x48, 0xFF, 0xC0, 0x48, 0xFF, 0xC9, 0x75, 0xF8, 0x48, 0x89, 0x1C, 0x25, 0x20, 0x00, 0x00, 0x00, 0xE8, 0xE0, 0xFF, 0xFF, 0xFF,
+]);
+const codeAddress = 0x10000;
+
+describe('Decode instructions with cs_disasm_iter', () => {
+  const disassembler = new Disassembler();
+
+  before(async () => {
+    await disassembler.initialiseDisassembler();
+  });
+
+  after(() => {
+    disassembler.delete();
+  });
+
+  it('decodes single instructions like cs_disasm', () => {
+    const expectedInstructions = disassembler.disassemble(code, codeAddress, 0);
+    let offset = 0;
+    expectedInstructions.forEach((expectedInstruction) => {
+      expect(disassembler.decodeInstruction(code.subarray(offset), codeAddress + offset)).to.eql(expectedInstruction);
+      offset += expectedInstruction.length;
+    });
+    expect(offset).to.equal(code.length);
+  });
+
+  it('iterates over all instructions of the code', () => {
+    expect(Array.from(disassembler.iterateInstructions(code, codeAddress))).to.eql(disassembler.disassemble(code, codeAddress, 0));
+  });
+
+  it('keeps the position of an iteration while other instructions are decoded', () => {
+    const expectedInstructions = disassembler.disassemble(code, codeAddress, 0);
+    const instructions = [];
+    const iterator = disassembler.iterateInstructions(code, codeAddress);
+    for (let result = iterator.next(); !result.done; result = iterator.next()) {
+      instructions.push(result.value);
+      disassembler.decodeInstruction(Uint8Array.from([0x48, 0x01, 0xC3]), 0);
+    }
+    expect(instructions).to.eql(expectedInstructions);
+  });
+
+  it('returns no instruction for invalid bytes', () => {
+    expect(disassembler.decodeInstruction(Uint8Array.from([0x37]), 0)).to.equal(undefined);
+    expect(Array.from(disassembler.iterateInstructions(Uint8Array.from([0x48, 0x01, 0xC3, 0x37]), 0)).length).to.equal(1);
+  });
+
+  it('finds the instructions of a group behind undecodable bytes', () => {
+    // ret / data 0x06 0x06 (invalid in 64-bit mode) / mov eax, 1 / ret / trailing 0x0F
+    const codeWithData = Uint8Array.from([0xC3, 0x06, 0x06, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3, 0x0F]);
+    expect(disassembler.findInstructionsOfGroup(codeWithData, codeAddress, disassembler.cs.GRP_RET))
+      .to.eql([codeAddress, codeAddress + 8]);
+    expect(disassembler.findInstructionsOfGroup(code, codeAddress, disassembler.cs.GRP_CALL)).to.eql([codeAddress + 23]);
+  });
+});
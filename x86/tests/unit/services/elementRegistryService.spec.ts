@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import {
+  getElementByLocationId,
+  getElementKeyOfLocationId,
+  getRegisteredElement,
+  hasRegisteredElement,
+  registerElement,
+  unregisterElement,
+} from '@/services/helper/elementRegistryService';
+import { getAnimationKeyMemory } from '@/services/helper/htmlIdService';
+
+describe('element registry', () => {
+  it('keys memory bytes by their address and other elements by their id', () => {
+    expect(getElementKeyOfLocationId('8FF3')).to.equal(0x8FF3);
+    expect(getElementKeyOfLocationId('RAX_0')).to.equal('RAX_0');
+  });
+
+  it('resolves registered memory bytes by address', () => {
+    const element = document.createElement('div');
+    registerElement(0x8FF3, element);
+    expect(getRegisteredElement(0x8FF3)).to.equal(element);
+    expect(getElementByLocationId('8FF3')).to.equal(element);
+    unregisterElement(0x8FF3, element);
+    expect(hasRegisteredElement(0x8FF3)).to.equal(false);
+  });
+
+  it('keeps the key of an element which took it over', () => {
+    const oldElement = document.createElement('div');
+    const newElement = document.createElement('div');
+    registerElement('RAX_0', oldElement);
+    registerElement('RAX_0', newElement);
+    unregisterElement('RAX_0', oldElement);
+    expect(getRegisteredElement('RAX_0')).to.equal(newElement);
+    unregisterElement('RAX_0', newElement);
+  });
+
+  it('falls back to the document for named elements only', () => {
+    const element = document.createElement('div');
+    element.id = 'registryFallback';
+    document.body.appendChild(element);
+    expect(getRegisteredElement('registryFallback')).to.equal(element);
+    element.id = '1234';
+    expect(getElementByLocationId('1234')).to.equal(null);
+    document.body.removeChild(element);
+  });
+
+  it('separates memory animation keys by address, access and index', () => {
+    const keys = [
+      0xFFFFFFFF,
+      getAnimationKeyMemory(0, false, 0),
+      getAnimationKeyMemory(0, true, 0),
+      getAnimationKeyMemory(0, false, 1),
+      getAnimationKeyMemory(0xFFFFFFFF, false, 0),
+    ];
+    expect(new Set(keys).size).to.equal(keys.length);
+    expect(getAnimationKeyMemory(0x8FF3, true, 2) % 2 ** 32).to.equal(0x8FF3);
+  });
+});
@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import { instantiateCompressedEngine, loadEngine } from '@/services/helper/engineModuleService';
+
+// eslint-disable-next-line @typescript-eslint/no-var-requires
+const compressedEngineLoader = require('../../../scripts/compressedEngineLoader');
+
+// shaped like the Emscripten factories in lib/
+const engineSource = `var Module = (() => {
+  var scriptDirectory = typeof __filename !== 'undefined' ? __filename : 'unset';
+  return (function(Module) {
+    return Promise.resolve({ scriptDirectory, options: Module });
+  });
+})();
+export default Module;
+`;
+
+describe('Engine modules', () => {
+  it('loads an engine on first use and reuses its factory', async () => {
+    const firstLoad = loadEngine('ndisasm');
+    const secondLoad = loadEngine('ndisasm');
+    expect(secondLoad).to.equal(firstLoad);
+
+    const Module = await firstLoad;
+    const ndisasmInstance = await Module({ noInitialRun: true });
+    expect(ndisasmInstance.callMain).to.be.a('function');
+  });
+
+  it('evaluates an engine embedded by the compressed engine loader', async () => {
+    const loaded: string = compressedEngineLoader.call({ resourcePath: 'lib/engine.js' }, engineSource);
+    const compressedSource = JSON.parse(/compressedSource: ("[^"]*")/.exec(loaded)?.[1] ?? '""');
+    expect(loaded).to.not.contain('export default Module');
+
+    const Module = await instantiateCompressedEngine({ compressedSource });
+    expect(await Module({ noInitialRun: true })).to.eql({ scriptDirectory: '', options: { noInitialRun: true } });
+  });
+
+  it('rejects a library without a module export', () => {
+    expect(() => compressedEngineLoader.call({ resourcePath: 'lib/engine.js' }, 'var Module = 1;')).to.throw('lib/engine.js');
+  });
+});
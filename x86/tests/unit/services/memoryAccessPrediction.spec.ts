@@ -0,0 +1,173 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import Unicorn from '@/services/emulator/emulatorService';
+import Disassembler from '@/services/disassembler/disassemblerService';
+import { RegisterID } from '@/services/emulator/emulatorEnums';
+import { ReadWriteAccessMode } from '@/services/interfaces/InstructionOperands';
+import ResolvedMemoryAccess from '@/services/interfaces/ResolvedMemoryAccess';
+import predictMemoryAccesses, {
+  getPredictedReadAccesses,
+  getPredictedWriteAccesses,
+} from '@/services/dataServices/memoryAccessPredictionService';
+import {
+  addMemoryAccessHook, getReadAccessElements, getWriteAccessElements,
+} from '@/services/dataServices/accessedElementsService';
+import getStateWithEmptyInstruction from '@/services/dataServices/fillDataService';
+import { closeEmulator, startCallAndStackTestProgram } from './testEmulator';
+
+const { READ, WRITE, READ_WRITE } = ReadWriteAccessMode;
+
+function registerValue(value: number): Uint8Array {
+  const bytes = new Uint8Array(8);
+  new DataView(bytes.buffer).setBigUint64(0, BigInt(value), true);
+  return bytes;
+}
+
+function registerValues(values: Array<[RegisterID, number]>): Map<RegisterID, Uint8Array> {
+  return new Map(values.map(([registerId, value]) => [registerId, registerValue(value)]));
+}
+
+// The x86/lib build of Capstone predates resolve_memory_operands, the memory hooks are used then.
+// resolve_memory_operands is also checked natively by the ctest of libraryPatches/capstone.js/nativeBenchmark.
+describe('resolveMemoryAccesses', () => {
+  const disassemblerInstance = new Disassembler();
+
+  before(async function checkResolver() {
+    await disassemblerInstance.initialiseDisassembler();
+    if (!disassemblerInstance.hasMemoryOperandResolution()) {
+      this.skip();
+    }
+  });
+  after(() => {
+    disassemblerInstance.delete();
+  });
+
+  function resolve(code: Array<number>, address: number, values: Array<[RegisterID, number]>) {
+    return disassemblerInstance.resolveMemoryAccesses(new Uint8Array(code), address, registerValues(values));
+  }
+
+  it('succeeds if push resolves the memory read and the implicit stack write', () => {
+    // push qword [0x0]
+    expect(resolve([0xFF, 0x34, 0x25, 0x00, 0x00, 0x00, 0x00], 0x7, [[RegisterID.RSP, 0x120]])).to.eql([
+      { address: 0x0, size: 8, access: READ },
+      { address: 0x118, size: 8, access: WRITE },
+    ]);
+  });
+  it('succeeds if pop resolves the implicit stack read', () => {
+    // pop rbx
+    expect(resolve([0x5B], 0x0, [[RegisterID.RSP, 0x118]])).to.eql([
+      { address: 0x118, size: 8, access: READ },
+    ]);
+  });
+  it('succeeds if call resolves the return address write', () => {
+    // call 0x15
+    expect(resolve([0xE8, 0x00, 0x00, 0x00, 0x00], 0x10, [[RegisterID.RSP, 0x120]])).to.eql([
+      { address: 0x118, size: 8, access: WRITE },
+    ]);
+  });
+  it('succeeds if ret resolves the return address read', () => {
+    expect(resolve([0xC3], 0x0, [[RegisterID.RSP, 0x118]])).to.eql([
+      { address: 0x118, size: 8, access: READ },
+    ]);
+  });
+  it('succeeds if leave reads the saved frame pointer at RBP', () => {
+    expect(resolve([0xC9], 0x0, [[RegisterID.RSP, 0x80], [RegisterID.RBP, 0x100]])).to.eql([
+      { address: 0x100, size: 8, access: READ },
+    ]);
+  });
+  it('succeeds if RIP-relative operands are resolved relative to the next instruction', () => {
+    // mov rax, qword [rip + 0x10] at 0x20
+    expect(resolve([0x48, 0x8B, 0x05, 0x10, 0x00, 0x00, 0x00], 0x20, [[RegisterID.RIP, 0x20]])).to.eql([
+      { address: 0x37, size: 8, access: READ },
+    ]);
+  });
+  it('succeeds if base, index, scale and displacement are resolved', () => {
+    // mov dword [rbx + rcx*4 + 8], eax
+    expect(resolve([0x89, 0x44, 0x8B, 0x08], 0x0, [[RegisterID.RBX, 0x100], [RegisterID.RCX, 2]])).to.eql([
+      { address: 0x110, size: 4, access: WRITE },
+    ]);
+  });
+  it('succeeds if read-modify-write operands are resolved once', () => {
+    // add qword [rbx], rax
+    expect(resolve([0x48, 0x01, 0x03], 0x0, [[RegisterID.RBX, 0x40]])).to.eql([
+      { address: 0x40, size: 8, access: READ_WRITE },
+    ]);
+  });
+  it('succeeds if lea does not access memory', () => {
+    // lea rax, [rbx + 8]
+    expect(resolve([0x48, 0x8D, 0x43, 0x08], 0x0, [[RegisterID.RBX, 0x100]])).to.eql([]);
+  });
+});
+
+describe('predictMemoryAccesses', () => {
+  // push qword [0x0] at address 0x7
+  const pushInstructionBytes = [0xFF, 0x34, 0x25, 0x00, 0x00, 0x00, 0x00];
+  const expectedAccesses: Array<ResolvedMemoryAccess> = [
+    { address: 0x0, size: 8, access: READ },
+    { address: 0x118, size: 8, access: WRITE },
+  ];
+
+  it('succeeds if the accesses are resolved from the registers of the emulator', async function predictPush() {
+    const ucInstance = new Unicorn();
+    const disassemblerInstance = new Disassembler();
+    const program = await startCallAndStackTestProgram(ucInstance, disassemblerInstance);
+    if (!disassemblerInstance.hasMemoryOperandResolution()) {
+      closeEmulator(program);
+      this.skip();
+    }
+    ucInstance.register_write(RegisterID.RSP, [0x20, 0x01]);
+    const [instruction] = disassemblerInstance.disassemble(pushInstructionBytes, 0x7, 1);
+    expect(predictMemoryAccesses(program, instruction)).to.eql(expectedAccesses);
+    closeEmulator(program);
+  });
+  it('succeeds if predicted accesses are split into reads and writes', () => {
+    const readWriteAccess: ResolvedMemoryAccess = { address: 0x40, size: 8, access: READ_WRITE };
+    const accesses = expectedAccesses.concat([readWriteAccess]);
+    expect(getPredictedReadAccesses(accesses)).to.eql([expectedAccesses[0], readWriteAccess]);
+    expect(getPredictedWriteAccesses(accesses)).to.eql([expectedAccesses[1], readWriteAccess]);
+  });
+});
+
+describe('accessed memory elements', () => {
+  // with or without resolve_memory_operands, every access is shown once
+  it('succeeds if predicted and hook recorded accesses are not shown twice', async () => {
+    const ucInstance = new Unicorn();
+    const disassemblerInstance = new Disassembler();
+    const program = await startCallAndStackTestProgram(ucInstance, disassemblerInstance);
+    ucInstance.register_write(RegisterID.RSP, [0x20, 0x01]);
+    // push qword [0x0] at address 0x7
+    const [instruction] = disassemblerInstance.disassemble([0xFF, 0x34, 0x25, 0x00, 0x00, 0x00, 0x00], 0x7, 1);
+    const state = getStateWithEmptyInstruction(program);
+    state.currentInstruction = instruction;
+    addMemoryAccessHook(state, program);
+
+    getReadAccessElements(state, program);
+    ucInstance.executeInstruction(instruction);
+    const accessedElements = getWriteAccessElements(state, program);
+
+    expect(accessedElements.memoryReadAccess.map((line) => line.address.address)).to.eql(['0000']);
+    expect(accessedElements.memoryWriteAccess.map((line) => line.address.address)).to.eql(['0118']);
+    closeEmulator(program);
+  });
+});
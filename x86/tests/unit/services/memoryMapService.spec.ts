@@ -0,0 +1,109 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import { eUC } from '@/services/emulator/emulatorEnums';
+import MemoryMap from '@/services/interfaces/MemoryMap';
+import {
+  addResidentPages,
+  defaultMemoryMap,
+  getInitialResidentPages,
+  getOriginMismatch,
+  getOriginOfSource,
+  markAccessedPagesResident,
+  sectionedMemoryMap,
+  validateMemoryMap,
+} from '@/services/dataServices/memoryMapService';
+import startEmulator from '@/services/startSimulatorService';
+import { getMemory, readNextInstructionBytesFromMemory } from '@/services/dataServices/memoryService';
+
+function createMemoryMap(codePermissions: number, dataAddress: number): MemoryMap {
+  return {
+    regions: [{
+      name: 'code', address: 0x1000, sizeInBytes: 0x1000, permissions: codePermissions,
+    }, {
+      name: 'data', address: dataAddress, sizeInBytes: 0x2000, permissions: eUC.PROT_READ | eUC.PROT_WRITE,
+    }],
+    codeAddress: 0x1000,
+    stackPointerAddress: 0x2F00,
+  };
+}
+
+describe('memoryMapService', () => {
+  it('succeeds if valid memory maps accepted', () => {
+    expect(validateMemoryMap(defaultMemoryMap)).to.eql(true);
+    expect(validateMemoryMap(sectionedMemoryMap)).to.eql(true);
+    expect(validateMemoryMap(createMemoryMap(eUC.PROT_ALL, 0x2000))).to.eql(true);
+  });
+  it('succeeds if overlapping regions rejected', () => {
+    expect(() => validateMemoryMap(createMemoryMap(eUC.PROT_ALL, 0x1000))).to.throw('overlaps');
+  });
+  it('succeeds if regions not aligned to pages rejected', () => {
+    expect(() => validateMemoryMap(createMemoryMap(eUC.PROT_ALL, 0x2010))).to.throw('not valid');
+  });
+  it('succeeds if code in region without execute permission rejected', () => {
+    expect(() => validateMemoryMap(createMemoryMap(eUC.PROT_READ, 0x2000))).to.throw('executable');
+  });
+  it('succeeds if resident pages sorted and unique', () => {
+    const { regions } = createMemoryMap(eUC.PROT_ALL, 0x2000);
+    const residentPages = [0x2000];
+    addResidentPages(residentPages, regions, 0x1FFC, 8);
+    addResidentPages(residentPages, regions, 0x3004, 2);
+    addResidentPages(residentPages, regions, 0x5000, 4);
+    expect(residentPages).to.eql([0x1000, 0x2000, 0x3000]);
+  });
+  it('succeeds if code and stack pages initially resident', () => {
+    expect(getInitialResidentPages(defaultMemoryMap, 16)).to.eql([0x0000]);
+    expect(getInitialResidentPages(sectionedMemoryMap, 16)).to.eql([0x00010000, 0x008FF000]);
+  });
+  it('succeeds if the origin of a source is read from its org directive', () => {
+    expect(getOriginOfSource('mov rax, 1')).to.eql(0);
+    expect(getOriginOfSource('; org 0x10\nmov rax, 1')).to.eql(0);
+    expect(getOriginOfSource('org 0x10000\nmov rax, 1')).to.eql(0x10000);
+    expect(getOriginOfSource('  [ORG 10000h] ; code region\nmov rax, 1')).to.eql(0x10000);
+  });
+  it('succeeds if code assembled for another address rejected by the memory map', () => {
+    expect(getOriginMismatch('mov rax, [0x20]', 'default')).to.eql(undefined);
+    expect(getOriginMismatch('mov rax, [0x20]', 'sectioned')).to.contain('org 0x10000');
+    expect(getOriginMismatch('org 0x10000\nmov rax, [0x100000]', 'sectioned')).to.eql(undefined);
+    expect(getOriginMismatch('org 0x10000\nmov rax, [0x100000]', 'default')).to.contain('org 0x0');
+  });
+});
+
+describe('Paged memory of sectioned memory map', () => {
+  it('succeeds if only resident pages read', async () => {
+    const program = await startEmulator([0x6A, 0x06], sectionedMemoryMap);
+    expect(getMemory(program).memoryDataLines.length).to.eql(2 * 256);
+    expect(getMemory(program).memoryDataLines[256].address.address).to.eql('8FF000');
+
+    markAccessedPagesResident(program, 0x00100008, 8);
+    const memory = getMemory(program);
+    expect(memory.memoryDataLines.length).to.eql(3 * 256);
+    expect(memory.memoryDataLines[256].address.address).to.eql('100000');
+    program.ucInstance.close();
+  });
+  it('succeeds if instruction bytes read above 0xFFFF', async () => {
+    const program = await startEmulator([0x6A, 0x06], sectionedMemoryMap);
+    expect(Array.from(readNextInstructionBytesFromMemory('10000', program)).slice(0, 2)).to.eql([0x6A, 0x06]);
+    program.ucInstance.close();
+  });
+});
@@ -0,0 +1,87 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import startEmulator from '@/services/startSimulatorService';
+import { sectionedMemoryMap } from '@/services/dataServices/memoryMapService';
+import {
+  diffMemorySnapshot, searchMappedMemory, searchMappedMemoryValue, takeMemorySnapshot,
+} from '@/services/dataServices/memoryScanService';
+import { diffMemory, searchMemory, valueToBytes } from '@/services/helper/memoryScanHelper';
+
+describe('memoryScanHelper', () => {
+  it('returns the changed ranges', () => {
+    const snapshot = new Uint8Array(40);
+    const live = snapshot.slice();
+    live[3] = 1;
+    live[4] = 2;
+    live[17] = 3;
+    live[39] = 4;
+    expect(Array.from(diffMemory(live, snapshot, 0x100))).to.eql([0x103, 0x105, 0x111, 0x112, 0x127, 0x128]);
+    expect(diffMemory(snapshot, snapshot.slice(), 0x100)).to.have.length(0);
+  });
+
+  it('compares buffers which are not aligned to words', () => {
+    const buffer = new Uint8Array(33);
+    const live = buffer.subarray(1);
+    const snapshot = new Uint8Array(32);
+    live[8] = 1;
+    expect(Array.from(diffMemory(live, snapshot, 0))).to.eql([8, 9]);
+  });
+
+  it('finds overlapping and aligned matches', () => {
+    const memory = Uint8Array.from([0, 1, 1, 1, 0, 1, 1, 0]);
+    expect(Array.from(searchMemory(memory, 0x10, Uint8Array.from([1, 1])))).to.eql([0x11, 0x12, 0x15]);
+    expect(Array.from(searchMemory(memory, 0x10, Uint8Array.from([1, 1]), 2))).to.eql([0x12]);
+    expect(searchMemory(memory, 0x10, Uint8Array.from([2]))).to.have.length(0);
+  });
+
+  it('stores values in little endian', () => {
+    expect(Array.from(valueToBytes(BigInt(0x1234), 2))).to.eql([0x34, 0x12]);
+    expect(Array.from(valueToBytes(BigInt(-1), 4))).to.eql([0xFF, 0xFF, 0xFF, 0xFF]);
+  });
+});
+
+describe('memoryScanService', () => {
+  it('diffs a snapshot of guest memory', async () => {
+    const program = await startEmulator([0x90], sectionedMemoryMap);
+    const snapshot = takeMemorySnapshot(program, 0x00100000, 1024 * 1024);
+    program.ucInstance.memory_write(0x00100010, [1, 2, 3]);
+    program.ucInstance.memory_write(0x001FFFFF, [4]);
+
+    expect(Array.from(diffMemorySnapshot(program, snapshot))).to.eql([0x00100010, 0x00100013, 0x001FFFFF, 0x00200000]);
+    program.ucInstance.close();
+  });
+
+  it('searches values of every size in all mapped regions', async () => {
+    const program = await startEmulator([0x90], sectionedMemoryMap);
+    program.ucInstance.memory_write(0x00100008, Array.from(valueToBytes(BigInt('0x1122334455667788'), 8)));
+    program.ucInstance.memory_write(0x00200102, [0xCD, 0xAB]);
+    program.ucInstance.memory_write(0x00800101, [0xCD, 0xAB]);
+
+    expect(Array.from(searchMappedMemoryValue(program, BigInt('0x1122334455667788'), 8))).to.eql([0x00100008]);
+    expect(Array.from(searchMappedMemoryValue(program, BigInt(0x55667788), 4))).to.eql([0x00100008]);
+    expect(Array.from(searchMappedMemoryValue(program, BigInt(0xABCD), 2))).to.eql([0x00200102]);
+    expect(Array.from(searchMappedMemory(program, Uint8Array.from([0xCD, 0xAB])))).to.eql([0x00200102, 0x00800101]);
+    program.ucInstance.close();
+  });
+});
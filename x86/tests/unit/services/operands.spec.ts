@@ -31,10 +31,13 @@ import {
   ReadWriteAccessMode,
 } from '@/services/interfaces/InstructionOperands';
 import getInstructionInformationFromCapstone, {
+  getFlagAccessModesFromMasks,
   getFlagAccessModFromName,
   getReadWriteAccessModFromName,
 } from '@/services/disassembler/instructionOperandsService';
 import { RegisterID } from '@/services/emulator/emulatorEnums';
+import { FlagID } from '@/services/interfaces/Flag';
+import { createRegisterMask } from '@/services/dataServices/registerMaskService';
 import { closeEmulator, startOperandsTestProgram, stepOverOneInstruction } from './testEmulator';
 import { testDataEmptyAccessedElements } from './testDataCurrentState';
 
@@ -197,6 +200,26 @@ describe('getFlagAccessModFromName', () => {
   });
 });
 
+describe('getFlagAccessModesFromMasks', () => {
+  // adc: tests CF, modifies CF, ZF, SF, OF, PF and AF
+  const adcMasks = [2261, 0, 0, 1, 0, 0];
+  it('succeeds if FlagAccessModes MOD and TEST found', () => {
+    expect(getFlagAccessModesFromMasks(adcMasks, FlagID.CF)).to.eql([FlagAccessMode.MOD, FlagAccessMode.TEST]);
+  });
+  it('succeeds if FlagAccessMode MOD found', () => {
+    expect(getFlagAccessModesFromMasks(adcMasks, FlagID.OF)).to.eql([FlagAccessMode.MOD]);
+  });
+  it('succeeds if FlagAccessModes RESET and MOD found', () => {
+    // and: resets CF and OF, AF is undefined
+    const andMasks = [196, 16, 2049, 0, 0, 0];
+    expect(getFlagAccessModesFromMasks(andMasks, FlagID.OF)).to.eql([FlagAccessMode.RESET]);
+    expect(getFlagAccessModesFromMasks(andMasks, FlagID.ZF)).to.eql([FlagAccessMode.MOD]);
+  });
+  it('succeeds if not accessed flag has no FlagAccessMode', () => {
+    expect(getFlagAccessModesFromMasks([0, 0, 0, 0, 0, 0], FlagID.ZF)).to.eql([]);
+  });
+});
+
 describe('getReadWriteAccessModFromName', () => {
   it('succeeds if ReadWriteAccessMode READ found', () => {
     expect(getReadWriteAccessModFromName('READ')).to.eql(ReadWriteAccessMode.READ);
@@ -234,6 +257,18 @@ describe('getInstructionInformationFromCapstone', () => {
     expectedOutput.opcode = Uint8Array.from([1, 0, 0, 0, 0]);
     expect(getInstructionInformationFromCapstone(input)).to.eql(expectedOutput);
   });
+  it('succeeds if Operands created (register read, register write, flag masks)', () => {
+    const input = '{ "Opcode": "0x01 0x00 0x00 0x00 ", "operands": [{"type": "REG", "value": "rbx", "size": "8", "access": "READ_WRITE" }, {"type": "REG", "value": "rax", "size": "8", "access": "READ" }], "registers_read": [ "rbx", "rax"], "registers_modified": [ "rflags", "rbx"], "EFLAGS_MASKS": [ 2261, 0, 0, 0, 0, 0 ] }';
+    const expectedOutput = JSON.parse('{"opcode":"","operandCount":2,"memoryWrite":[],"memoryRead":[],"flagsTest":[],"flagsWrite":[0,11,6,7],"immediate":[],"registersRead":[37,35],"registersWrite":[37]}');
+    expectedOutput.opcode = Uint8Array.from([1, 0, 0, 0, 0]);
+    expect(getInstructionInformationFromCapstone(input)).to.eql(expectedOutput);
+  });
+  it('succeeds if Operands created (register masks)', () => {
+    const input = '{ "Opcode": "0x01 0x00 0x00 0x00 ", "operands": [{"type": "REG", "value": "rbx", "size": "8", "access": "READ_WRITE" }, {"type": "REG", "value": "rax", "size": "8", "access": "READ" }], "registers_read_mask": [ 0, 40, 0, 0, 0, 0, 0, 0 ], "registers_read": [ "rbx", "rax"], "registers_modified_mask": [ 0, 32, 0, 0, 0, 0, 0, 0 ], "registers_modified": [ "rflags", "rbx"] }';
+    const { registersReadMask, registersWriteMask } = getInstructionInformationFromCapstone(input);
+    expect(registersReadMask).to.eql(createRegisterMask([RegisterID.RAX, RegisterID.RBX]));
+    expect(registersWriteMask).to.eql(createRegisterMask([RegisterID.RBX]));
+  });
   it('succeeds if Operands created (push)', () => {
     const input = '{ "Prefix": "0x00 0x00 0x00 0x00 ", "Opcode": "0xff 0x00 0x00 0x00 ", "rex": "0x0", "addr_size": "8", "modrm": { "modrm_value": "0x34", "modrm_offset": "0x1" }, "disp": { "disp_value": "0x0", "disp_offset": "0x3", "disp_size": "0x4" }, "sib": { "sib_value": "0x25", "sib_scale": "1" }, "op_count": "1", "operands": [{"type": "MEM", "size": "8", "access": "READ" }], "registers_read": [ "rsp"], "registers_modified": [ "rsp"] }';
     const expectedOutput = JSON.parse('{"opcode":"","operandCount":1,"memoryWrite":[],"memoryRead":[{"size":8,"pointerArithmeticOperands":{},"access":0}],"flagsTest":[],"flagsWrite":[],"immediate":[],"registersRead":[44],"registersWrite":[44]}');
@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import { nasm } from '@/services/nasm/nasm';
+import demoPrograms from '@/services/editorService/demoPrograms';
+import demoProgramBundle from '@/services/editorService/demoProgramBundle';
+import { getPrebuiltInstruction, getPrebuiltMachineCode } from '@/services/editorService/prebuiltProgramService';
+import { disassembleCurrentInstruction } from '@/services/disassembler/instructionService';
+import Disassembler from '@/services/disassembler/disassemblerService';
+import Unicorn from '@/services/emulator/emulatorService';
+import { closeEmulator, initEmulator } from './testEmulator';
+
+describe('Prebuilt demo programs', () => {
+  it('succeeds if the bundle contains every demo program as NASM assembles it', async () => {
+    expect(demoProgramBundle.map((program) => program.label)).to.eql(demoPrograms.map((demo) => demo.label));
+    for (let i = 0; i < demoPrograms.length; i += 1) {
+      expect(getPrebuiltMachineCode(demoPrograms[i].program)).to.eql(await nasm(demoPrograms[i].program));
+    }
+  });
+
+  it('succeeds if prebuilt instructions equal the instructions decoded by Capstone and ndisasm', async () => {
+    for (let i = 0; i < demoProgramBundle.length; i += 1) {
+      const prebuiltProgram = demoProgramBundle[i];
+      const machineCode = Array.from(getPrebuiltMachineCode(prebuiltProgram.source) || []);
+      const program = await initEmulator(new Unicorn(), new Disassembler(), prebuiltProgram.codeAddress, [], [], machineCode, prebuiltProgram.codeAddress);
+      for (let j = 0; j < prebuiltProgram.instructions.length; j += 1) {
+        const { address } = prebuiltProgram.instructions[j];
+        const bytes: Uint8Array = program.ucInstance.memory_read(address, 16);
+        expect(getPrebuiltInstruction(bytes, address)).to.eql(await disassembleCurrentInstruction(program, bytes, address));
+      }
+      closeEmulator(program);
+    }
+  });
+
+  it('succeeds if changed bytes are not taken from the bundle', () => {
+    const { address, bytes } = demoProgramBundle[0].instructions[0];
+    expect(getPrebuiltInstruction(Uint8Array.from([0x90]), address)).to.equal(undefined);
+    expect(getPrebuiltInstruction(Uint8Array.from([0x48, 0x01, 0xC3]), address + bytes.length / 2 + 0x100)).to.equal(undefined);
+    expect(getPrebuiltMachineCode(`${demoPrograms[0].program}\n`)).to.equal(undefined);
+  });
+});
@@ -0,0 +1,53 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import { RegisterID } from '@/services/emulator/emulatorEnums';
+import {
+  createRegisterMask,
+  createRegisterMaskFromWords,
+  getRegisterIdsFromMask,
+  registerMaskContains,
+  registerMaskHasRegistersNotIn,
+} from '@/services/dataServices/registerMaskService';
+
+describe('registerMaskService', () => {
+  it('succeeds if mask contains added registers only', () => {
+    const mask = createRegisterMask([RegisterID.RAX, RegisterID.R15]);
+    expect(registerMaskContains(mask, RegisterID.RAX)).to.eql(true);
+    expect(registerMaskContains(mask, RegisterID.R15)).to.eql(true);
+    expect(registerMaskContains(mask, RegisterID.RBX)).to.eql(false);
+  });
+  it('succeeds if register ids read from mask in ascending order', () => {
+    const mask = createRegisterMask([RegisterID.R15, RegisterID.RSP, RegisterID.RAX, RegisterID.R15W]);
+    expect(getRegisterIdsFromMask(mask)).to.eql([RegisterID.RAX, RegisterID.RSP, RegisterID.R15, RegisterID.R15W]);
+  });
+  it('succeeds if mask created from words of Capstone', () => {
+    // RAX = 35 and RBX = 37 are in the second word
+    expect(createRegisterMaskFromWords([0, 40, 0, 0, 0, 0, 0, 0])).to.eql(createRegisterMask([RegisterID.RAX, RegisterID.RBX]));
+  });
+  it('succeeds if new registers detected', () => {
+    const shown = createRegisterMask([RegisterID.RAX, RegisterID.RBX]);
+    expect(registerMaskHasRegistersNotIn(createRegisterMask([RegisterID.RBX]), shown)).to.eql(false);
+    expect(registerMaskHasRegistersNotIn(createRegisterMask([RegisterID.RBX, RegisterID.RSP]), shown)).to.eql(true);
+  });
+});
@@ -0,0 +1,221 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import StepController from '@/services/stepController';
+import DebuggerController from '@/services/debuggerController';
+import mapLinesToMemory from '@/services/debuggerService/mapLinesToMemoryService';
+import startEmulator from '@/services/startSimulatorService';
+import { RegisterID } from '@/services/emulator/emulatorEnums';
+import { formatChangeHistoryEntry, getChangeHistoryLength } from '@/services/dataServices/changeHistoryService';
+
+// 0x00: jmp 0x0C
+// 0x02: dec ecx          ; recursive function, calls itself until ecx is zero
+// 0x04: jz 0x0B
+// 0x06: call 0x02
+// 0x0B: ret
+// 0x0C: mov ecx, 5
+// 0x11: call 0x02
+// 0x16: mov rax, rcx
+const recursiveProgram = [
+  0xEB, 0x0A, 0xFF, 0xC9, 0x74, 0x05, 0xE8, 0xF7, 0xFF, 0xFF, 0xFF, 0xC3,
+  0xB9, 0x05, 0x00, 0x00, 0x00, 0xE8, 0xEC, 0xFF, 0xFF, 0xFF, 0x48, 0x89, 0xC8,
+];
+
+// 0x00: call 0x06
+// 0x05: nop
+// 0x06: jmp 0x06        ; endless callee
+const endlessCallProgram = [0xE8, 0x01, 0x00, 0x00, 0x00, 0x90, 0xEB, 0xFE];
+
+// 0x00: call 0x06
+// 0x05: nop
+// 0x06: xor eax, eax    ; the callee runs off the end of the code
+const unreturnedCallProgram = [0xE8, 0x01, 0x00, 0x00, 0x00, 0x90, 0x31, 0xC0];
+
+// 0x00: call 0x06
+// 0x05: nop
+// 0x06: ret             ; the callee does not change any flag
+const flagPreservingCallProgram = [0xE8, 0x01, 0x00, 0x00, 0x00, 0x90, 0xC3];
+
+async function createDebuggerController(code = recursiveProgram) {
+  const program = await startEmulator(code);
+  const stepController = new StepController(program);
+  const editorLines = await mapLinesToMemory(program);
+  return { stepController, debuggerController: new DebuggerController(stepController, editorLines) };
+}
+
+const instructionPointer = (stepController: StepController) => parseInt(stepController.getState().instructionPointer.address.address, 16);
+
+const readRegister = (stepController: StepController, register: RegisterID) => stepController.getProgram().ucInstance.register_read_number(register);
+
+async function stepIntoFunction(stepController: StepController) {
+  // jmp, mov and call, each in three steps
+  for (let step = 0; step < 9; step += 1) {
+    await stepController.nextStep();
+  }
+}
+
+describe('Run to return', () => {
+  it('steps over other instructions and over a recursive call as a whole', async () => {
+    const { stepController, debuggerController } = await createDebuggerController();
+    const stackPointer = readRegister(stepController, RegisterID.RSP);
+
+    await debuggerController.stepOver();
+    await debuggerController.stepOver();
+    expect(instructionPointer(stepController)).to.equal(0x11);
+
+    await debuggerController.stepOver();
+    expect(instructionPointer(stepController)).to.equal(0x16);
+    expect(readRegister(stepController, RegisterID.RCX)).to.equal(0);
+    expect(readRegister(stepController, RegisterID.RSP)).to.equal(stackPointer);
+
+    const { changeHistory } = stepController.getState();
+    expect(getChangeHistoryLength(changeHistory)).to.equal(3);
+    const stepOverEntry = formatChangeHistoryEntry(changeHistory, 2);
+    expect(stepOverEntry.instruction).to.contain('step over');
+    expect(stepOverEntry.changedElements.some((element) => element.startsWith('[0x'))).to.equal(true);
+
+    stepController.getProgram().ucInstance.close();
+  });
+
+  it('replays a call stepped over when stepping back', async () => {
+    const { stepController, debuggerController } = await createDebuggerController();
+    for (let command = 0; command < 4; command += 1) {
+      await debuggerController.stepOver();
+    }
+
+    // stepping back over the last instruction rebuilds the emulator from the recorded instructions
+    for (let step = 0; step < 3; step += 1) {
+      await stepController.previousStep();
+    }
+    expect(instructionPointer(stepController)).to.equal(0x16);
+    await stepController.nextStep();
+    expect(readRegister(stepController, RegisterID.RAX)).to.equal(0);
+
+    for (let step = 0; step < 4; step += 1) {
+      await stepController.previousStep();
+    }
+    expect(instructionPointer(stepController)).to.equal(0x11);
+    expect(getChangeHistoryLength(stepController.getState().changeHistory)).to.equal(2);
+
+    await debuggerController.stepOver();
+    expect(instructionPointer(stepController)).to.equal(0x16);
+    expect(readRegister(stepController, RegisterID.RCX)).to.equal(0);
+
+    stepController.getProgram().ucInstance.close();
+  });
+
+  it('steps out of the outermost call of a recursion', async () => {
+    const { stepController, debuggerController } = await createDebuggerController();
+    const stackPointer = readRegister(stepController, RegisterID.RSP);
+    await stepIntoFunction(stepController);
+    expect(instructionPointer(stepController)).to.equal(0x02);
+
+    await debuggerController.stepOut();
+    expect(instructionPointer(stepController)).to.equal(0x16);
+    expect(readRegister(stepController, RegisterID.RSP)).to.equal(stackPointer);
+    expect(formatChangeHistoryEntry(stepController.getState().changeHistory, 3).instruction).to.contain('step out');
+
+    stepController.getProgram().ucInstance.close();
+  });
+
+  it('runs to the return of the current call and stops before it', async () => {
+    const { stepController, debuggerController } = await createDebuggerController();
+    const stackPointer = readRegister(stepController, RegisterID.RSP);
+    await stepIntoFunction(stepController);
+
+    await debuggerController.runToReturn();
+    expect(instructionPointer(stepController)).to.equal(0x0B);
+    expect(readRegister(stepController, RegisterID.RSP)).to.equal(stackPointer - 8);
+    expect(readRegister(stepController, RegisterID.RCX)).to.equal(0);
+
+    // the next instruction is the return, so there is nothing left to run
+    await debuggerController.runToReturn();
+    expect(instructionPointer(stepController)).to.equal(0x0B);
+
+    stepController.getProgram().ucInstance.close();
+  });
+
+  it('steps over a call whose cycle is in progress by leaving the callee', async () => {
+    const { stepController, debuggerController } = await createDebuggerController();
+    await debuggerController.stepOver();
+    await debuggerController.stepOver();
+    // fetching the call already executes it in the emulator
+    await stepController.nextStep();
+
+    await debuggerController.stepOver();
+    expect(instructionPointer(stepController)).to.equal(0x16);
+    expect(readRegister(stepController, RegisterID.RCX)).to.equal(0);
+
+    stepController.getProgram().ucInstance.close();
+  });
+
+  it('marks a step over which stops at the instruction limit before the return', async () => {
+    const { stepController, debuggerController } = await createDebuggerController(endlessCallProgram);
+
+    await debuggerController.stepOver();
+    expect(debuggerController.isRunToReturnIncomplete()).to.equal(true);
+    expect(instructionPointer(stepController)).to.equal(0x06);
+    expect(formatChangeHistoryEntry(stepController.getState().changeHistory, 0).instruction)
+      .to.contain('step over, no return within 1000000 instructions');
+
+    stepController.getProgram().ucInstance.close();
+  });
+
+  it('marks a step over which reaches the end of the code before the return', async () => {
+    const { stepController, debuggerController } = await createDebuggerController(unreturnedCallProgram);
+
+    await debuggerController.stepOver();
+    expect(debuggerController.isRunToReturnIncomplete()).to.equal(true);
+    expect(formatChangeHistoryEntry(stepController.getState().changeHistory, 0).instruction)
+      .to.contain('step over, no return before the end of the code');
+
+    stepController.getProgram().ucInstance.close();
+  });
+
+  it('does not mark a call which returned', async () => {
+    const { stepController, debuggerController } = await createDebuggerController();
+    await debuggerController.stepOver();
+    await debuggerController.stepOver();
+    await debuggerController.stepOver();
+    expect(debuggerController.isRunToReturnIncomplete()).to.equal(false);
+    expect(formatChangeHistoryEntry(stepController.getState().changeHistory, 2).instruction).not.to.contain('no return');
+
+    stepController.getProgram().ucInstance.close();
+  });
+
+  it('records only the flags a call stepped over changed', async () => {
+    const { stepController, debuggerController } = await createDebuggerController();
+    for (let command = 0; command < 3; command += 1) {
+      await debuggerController.stepOver();
+    }
+    const { changeHistory } = stepController.getState();
+    const flagNames = (log: typeof changeHistory) => log.records[log.records.length - 1].flags.map((flag) => log.strings[flag.name]);
+    expect(flagNames(changeHistory)).to.eql(['ZF']);
+    stepController.getProgram().ucInstance.close();
+
+    const preserving = await createDebuggerController(flagPreservingCallProgram);
+    await preserving.debuggerController.stepOver();
+    expect(flagNames(preserving.stepController.getState().changeHistory)).to.eql([]);
+    preserving.stepController.getProgram().ucInstance.close();
+  });
+});
@@ -0,0 +1,105 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import {
+  decodeShareCode,
+  decodeSharedMachineCode,
+  decodeSharedMemoryMap,
+  decodeSharedProgram,
+  encodeSharedProgram,
+  SharedProgram,
+} from '@/services/editorService/shareLinkService';
+import demoPrograms from '@/services/editorService/demoPrograms';
+
+const sharedProgram: SharedProgram = {
+  source: demoPrograms[0].program,
+  machineCode: [0x48, 0x8B, 0x04, 0x25, 0x00, 0x00, 0x00, 0x00, 0x48, 0x01, 0xC3],
+  breakpoints: [{ line: 3 }, { line: 4, condition: { value: 'rax == 0x10' } }],
+  watchpoints: [{ condition: { value: 'rbx > 2' } }],
+};
+
+describe('Share links', () => {
+  it('restores the shared program from its share code', async () => {
+    const shareCode = await encodeSharedProgram(sharedProgram);
+    expect(await decodeSharedProgram(shareCode)).to.eql(sharedProgram);
+  });
+
+  it('only uses URL safe characters', async () => {
+    const shareCode = await encodeSharedProgram(sharedProgram);
+    expect(shareCode).to.match(/^[A-Za-z0-9_-]+$/);
+  });
+
+  it('reads the machine code without decoding the source', async () => {
+    const shareCode = await encodeSharedProgram({ source: 'BITS 64', machineCode: sharedProgram.machineCode });
+    expect(decodeSharedMachineCode(shareCode)).to.eql(sharedProgram.machineCode);
+    const decoded = await decodeSharedProgram(shareCode);
+    expect(decoded.breakpoints).to.equal(undefined);
+  });
+
+  it('stores machine code longer than one varint byte', async () => {
+    const machineCode = Array.from({ length: 300 }, (value, index) => index % 256);
+    const shareCode = await encodeSharedProgram({ source: '', machineCode });
+    expect(decodeSharedMachineCode(shareCode)).to.eql(machineCode);
+  });
+
+  it('stores the selected memory map next to the machine code', async () => {
+    const sectionedProgram: SharedProgram = { ...sharedProgram, memoryMap: 'sectioned' };
+    const shareCode = await encodeSharedProgram(sectionedProgram);
+    expect(decodeSharedMemoryMap(shareCode)).to.equal('sectioned');
+    expect(decodeSharedMachineCode(shareCode)).to.eql(sharedProgram.machineCode);
+    expect(await decodeSharedProgram(shareCode)).to.eql(sectionedProgram);
+  });
+
+  it('derives the emulator start and the program from one decoding', async () => {
+    const sectionedProgram: SharedProgram = { ...sharedProgram, memoryMap: 'sectioned' };
+    const { emulatorStart, program } = decodeShareCode(await encodeSharedProgram(sectionedProgram));
+    expect(emulatorStart).to.eql({ machineCode: sharedProgram.machineCode, memoryMap: 'sectioned' });
+    expect(await program).to.eql(sectionedProgram);
+  });
+
+  it('does not store the default memory map', async () => {
+    const shareCode = await encodeSharedProgram({ ...sharedProgram, memoryMap: 'default' });
+    expect(shareCode).to.equal(await encodeSharedProgram(sharedProgram));
+    expect(decodeSharedMemoryMap(shareCode)).to.equal(undefined);
+  });
+
+  it('stores the source uncompressed if the browser does not support deflate-raw', async () => {
+    const globalStreams = globalThis as unknown as { CompressionStream?: unknown };
+    const { CompressionStream } = globalStreams;
+    globalStreams.CompressionStream = class {
+      constructor(format: string) {
+        throw new TypeError(`Unsupported compression format: ${format}`);
+      }
+    };
+    try {
+      const shareCode = await encodeSharedProgram(sharedProgram);
+      expect(await decodeSharedProgram(shareCode)).to.eql(sharedProgram);
+    } finally {
+      globalStreams.CompressionStream = CompressionStream;
+    }
+  });
+
+  it('rejects share codes of an unknown version', () => {
+    expect(() => decodeSharedMachineCode('AgA')).to.throw('version 2');
+  });
+});
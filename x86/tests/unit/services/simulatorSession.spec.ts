@@ -0,0 +1,122 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import StepController from '@/services/stepController';
+import DebuggerController from '@/services/debuggerController';
+import mapLinesToMemory from '@/services/debuggerService/mapLinesToMemoryService';
+import startEmulator from '@/services/startSimulatorService';
+import { RegisterID } from '@/services/emulator/emulatorEnums';
+import {
+  captureSession, decodeSession, encodeSession, restoreSession, sessionFormatVersion,
+} from '@/services/simulatorSessionService';
+
+// 0x00: mov ecx, 3
+// 0x05: push rcx
+// 0x06: dec ecx
+// 0x08: jnz 0x05
+// 0x0A: mov rax, rcx
+const pushLoopProgram = [
+  0xB9, 0x03, 0x00, 0x00, 0x00, 0x51, 0xFF, 0xC9, 0x75, 0xFB, 0x48, 0x89, 0xC8,
+];
+
+async function createDebuggerController() {
+  const program = await startEmulator(pushLoopProgram);
+  const stepController = new StepController(program);
+  const editorLines = await mapLinesToMemory(program);
+  return { stepController, debuggerController: new DebuggerController(stepController, editorLines) };
+}
+
+const instructionPointer = (stepController: StepController) => parseInt(stepController.getState().instructionPointer.address.address, 16);
+
+const readRegister = (stepController: StepController, register: RegisterID) => stepController.getProgram().ucInstance.register_read_number(register);
+
+async function executeInstructions(stepController: StepController, instructions: number) {
+  for (let step = 0; step < instructions * 3; step += 1) {
+    await stepController.nextStep();
+  }
+}
+
+describe('Simulator session', () => {
+  it('restores registers, memory and state without executing the program again', async () => {
+    const { stepController, debuggerController } = await createDebuggerController();
+    debuggerController.setBreakpoint({ line: 5 });
+    await executeInstructions(stepController, 5);
+    const stackPointer = readRegister(stepController, RegisterID.RSP);
+
+    const session = captureSession('mov ecx, 3', stepController, debuggerController);
+    // the recorded program states hold the program fields, not the emulator, the disassembler or the component
+    session.stepController.reverseDebugger.transactionStore.programStates.forEach(({ value }) => {
+      expect(value).to.not.have.any.keys('ucInstance', 'disassemblerInstance', 'vm');
+    });
+    const restored = await restoreSession(await decodeSession(await encodeSession(session)));
+
+    expect(instructionPointer(restored.stepController)).to.equal(instructionPointer(stepController));
+    expect(readRegister(restored.stepController, RegisterID.RCX)).to.equal(readRegister(stepController, RegisterID.RCX));
+    expect(readRegister(restored.stepController, RegisterID.RSP)).to.equal(stackPointer);
+    expect(restored.program.ucInstance.memory_read(stackPointer, 16))
+      .to.deep.equal(stepController.getProgram().ucInstance.memory_read(stackPointer, 16));
+    expect(restored.stepController.getState().changeHistory).to.deep.equal(stepController.getState().changeHistory);
+    expect(restored.debuggerController.getBreakpoints()).to.deep.equal([{ line: 5 }]);
+    expect(restored.editorLines.size).to.equal(debuggerController.getEditorLines().size);
+
+    stepController.getProgram().ucInstance.close();
+    restored.program.ucInstance.close();
+  });
+
+  it('continues and steps back in a restored session', async () => {
+    const { stepController, debuggerController } = await createDebuggerController();
+    await executeInstructions(stepController, 3);
+    const session = captureSession('', stepController, debuggerController);
+    await executeInstructions(stepController, 4);
+
+    const restored = await restoreSession(await decodeSession(await encodeSession(session)));
+    await executeInstructions(restored.stepController, 4);
+    expect(instructionPointer(restored.stepController)).to.equal(instructionPointer(stepController));
+    expect(readRegister(restored.stepController, RegisterID.RCX)).to.equal(readRegister(stepController, RegisterID.RCX));
+
+    // back to where the session was saved and one instruction further, into the restored history
+    for (let step = 0; step < 5 * 3; step += 1) {
+      await restored.stepController.previousStep();
+    }
+    expect(instructionPointer(restored.stepController)).to.equal(0x06);
+    expect(restored.stepController.isInitialStep()).to.equal(false);
+
+    stepController.getProgram().ucInstance.close();
+    restored.program.ucInstance.close();
+  });
+
+  it('rejects sessions of another format version', async () => {
+    const { stepController, debuggerController } = await createDebuggerController();
+    const session = captureSession('', stepController, debuggerController);
+    const encoded = await encodeSession({ ...session, version: sessionFormatVersion + 1 });
+    stepController.getProgram().ucInstance.close();
+
+    let error: Error | undefined;
+    try {
+      await decodeSession(encoded);
+    } catch (e) {
+      error = e as Error;
+    }
+    expect(error?.message).to.contain('not supported');
+  });
+});
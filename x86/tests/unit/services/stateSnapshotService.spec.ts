@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import { isReactive, reactive, toRaw } from 'vue';
+import rfdc from 'rfdc';
+import State from '@/services/interfaces/State';
+import { createStateSnapshot } from '@/services/dataServices/stateSnapshotService';
+import { addByteToSet } from '@/services/dataServices/byteSetService';
+import { appendChangeRecord, getChangeHistoryLength } from '@/services/dataServices/changeHistoryService';
+import { testDataCurrentInstruction, testDataEmptyAccessedElements, testDataState } from './testDataCurrentState';
+
+const clone = rfdc();
+
+describe('state snapshots', () => {
+  let state: State;
+
+  beforeEach(() => {
+    state = clone(testDataState);
+  });
+
+  it('copies every slice of the state into a frozen snapshot', () => {
+    const snapshot = createStateSnapshot(state);
+    expect(snapshot.state).to.eql(state);
+    expect(Object.isFrozen(snapshot.state)).to.equal(true);
+  });
+
+  it('keeps unchanged slices of the previous snapshot', () => {
+    const previous = createStateSnapshot(state);
+    state.registers = clone(state.registers);
+    const snapshot = createStateSnapshot(state, previous);
+
+    expect(snapshot.state.registers).to.not.equal(previous.state.registers);
+    expect(snapshot.state.flags).to.equal(previous.state.flags);
+    expect(snapshot.state.byteInformation).to.equal(previous.state.byteInformation);
+    expect(snapshot.state.changeHistory).to.equal(previous.state.changeHistory);
+    expect(snapshot.state.memoryData).to.equal(previous.state.memoryData);
+  });
+
+  it('replaces the memory data only if a line was replaced', () => {
+    const previous = createStateSnapshot(state);
+    const [firstLine] = state.memoryData.memoryDataLines;
+    state.memoryData.memoryDataLines[0] = { ...firstLine };
+    const snapshot = createStateSnapshot(state, previous);
+
+    expect(snapshot.state.memoryData).to.not.equal(previous.state.memoryData);
+    expect(snapshot.state.memoryData.memoryDataLines[0]).to.not.equal(firstLine);
+    expect(previous.state.memoryData.memoryDataLines[0]).to.equal(firstLine);
+  });
+
+  it('detects slices which are changed in place', () => {
+    const previous = createStateSnapshot(state);
+    addByteToSet(state.byteInformation.usedBytes, 0x8000);
+    state.byteInformation.stackPointerInformation.pointerAddress = 0x8FF0;
+    appendChangeRecord(state.changeHistory, testDataCurrentInstruction.assemblyInterpretation, testDataEmptyAccessedElements, 10);
+    const snapshot = createStateSnapshot(state, previous);
+
+    expect(snapshot.state.byteInformation.usedBytes).to.not.equal(previous.state.byteInformation.usedBytes);
+    expect(snapshot.state.byteInformation.stackPointerInformation.pointerAddress).to.equal(0x8FF0);
+    expect(previous.state.byteInformation.stackPointerInformation.pointerAddress).to.not.equal(0x8FF0);
+    expect(snapshot.state.byteInformation.basePointerInformation).to.equal(previous.state.byteInformation.basePointerInformation);
+    expect(getChangeHistoryLength(snapshot.state.changeHistory)).to.equal(1);
+    expect(getChangeHistoryLength(previous.state.changeHistory)).to.equal(0);
+    expect(snapshot.state.byteInformation).to.not.equal(previous.state.byteInformation);
+    expect(snapshot.state.changeHistory).to.not.equal(previous.state.changeHistory);
+  });
+
+  it('is never converted into a reactive proxy', () => {
+    const snapshot = createStateSnapshot(state);
+    expect(isReactive(reactive({ snapshot }).snapshot)).to.equal(false);
+    // slices handed on as props on their own are not converted either
+    const { registers, memoryData } = reactive({ registers: snapshot.state.registers, memoryData: snapshot.state.memoryData });
+    expect(isReactive(registers)).to.equal(false);
+    expect(isReactive(memoryData)).to.equal(false);
+    expect(toRaw(registers)).to.equal(snapshot.state.registers);
+  });
+});
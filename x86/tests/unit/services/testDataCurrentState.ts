@@ -35,6 +35,7 @@ import ByteInformation, {
   PointerInformation,
 } from '@/services/interfaces/ByteInformation';
 import JumpDestination from '@/services/interfaces/JumpDestination';
+import { createByteSet } from '@/services/dataServices/byteSetService';
 
 export const testDataRegisters = [
   {
@@ -94,9 +95,9 @@ const pointerWithBytesInfo: PointerInformation = {
   ],
 };
 
-const usedBytes = [
+const usedBytes = createByteSet([
   0, 0,
-];
+]);
 
 const codeInformation: CodeInformation = {
   from: 0,
@@ -109,8 +110,8 @@ export const testDataEmptyPointerInformation: ByteInformation = {
   instructionPointerInformation: zeroPointerInfo,
   usedBytes,
   code: codeInformation,
-  evenInstructionBytes: [],
-  unevenInstructionBytes: [],
+  evenInstructionBytes: createByteSet(),
+  unevenInstructionBytes: createByteSet(),
 };
 
 export const testDataGetInstructionInformation: ByteInformation = {
@@ -126,8 +127,8 @@ export const testDataGetInstructionInformation: ByteInformation = {
   },
   usedBytes,
   code: codeInformation,
-  evenInstructionBytes: [],
-  unevenInstructionBytes: [],
+  evenInstructionBytes: createByteSet(),
+  unevenInstructionBytes: createByteSet(),
 };
 
 export const testDataExecuteInstructionInformation: ByteInformation = {
@@ -139,8 +140,8 @@ export const testDataExecuteInstructionInformation: ByteInformation = {
   },
   usedBytes,
   code: codeInformation,
-  evenInstructionBytes: [],
-  unevenInstructionBytes: [],
+  evenInstructionBytes: createByteSet(),
+  unevenInstructionBytes: createByteSet(),
 };
 
 export const testDataIncrementInstructionInformation: ByteInformation = {
@@ -152,8 +153,8 @@ export const testDataIncrementInstructionInformation: ByteInformation = {
   },
   usedBytes,
   code: codeInformation,
-  evenInstructionBytes: [],
-  unevenInstructionBytes: [],
+  evenInstructionBytes: createByteSet(),
+  unevenInstructionBytes: createByteSet(),
 };
 
 export const testDataGetInstructionSecondInformation: ByteInformation = {
@@ -169,8 +170,8 @@ export const testDataGetInstructionSecondInformation: ByteInformation = {
   },
   usedBytes,
   code: codeInformation,
-  evenInstructionBytes: [],
-  unevenInstructionBytes: [],
+  evenInstructionBytes: createByteSet(),
+  unevenInstructionBytes: createByteSet(),
 };
 
 export const testDataInstructionOperands: InstructionOperands = {
@@ -5669,5 +5670,7 @@ export const testDataState: State = {
   registers: testDataRegisters,
   flags: testDataFlags,
   byteInformation: testDataEmptyPointerInformation,
-  changeHistory: [],
+  changeHistory: {
+    instructions: [], strings: [], spilledInstructions: new Uint32Array(0), spilledCount: 0, records: [], recordCount: 0,
+  },
 };
@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import {
+  clearTraces,
+  countTrace,
+  enableTracing,
+  exportChromeTrace,
+  getTraceCounters,
+  getTraceSpanStatistics,
+  hasTraceQueryFlag,
+  traceCcall,
+  traceSpan,
+} from '@/services/helper/traceService';
+
+describe('Trace service', () => {
+  afterEach(() => {
+    enableTracing(false);
+    clearTraces();
+  });
+
+  it('records nothing while tracing is disabled', async () => {
+    const ccall = (name: string) => name;
+    expect(traceSpan('disabled', () => 1)).to.equal(1);
+    expect(await traceSpan('disabledAsync', async () => 2)).to.equal(2);
+    countTrace('disabledCounter');
+    expect(traceCcall('library', ccall)).to.equal(ccall);
+    expect(getTraceSpanStatistics()).to.eql([]);
+    expect(getTraceCounters().size).to.equal(0);
+  });
+
+  it('records synchronous and asynchronous spans and counters', async () => {
+    enableTracing();
+    traceSpan('sync', () => 1);
+    traceSpan('sync', () => 2);
+    await traceSpan('async', () => new Promise((resolve) => { setTimeout(resolve, 5); }));
+    expect(() => traceSpan('throwing', () => { throw new Error('failed'); })).to.throw('failed');
+    countTrace('counter', 2);
+    countTrace('counter');
+
+    const statistics = getTraceSpanStatistics();
+    const spanCount = (name: string) => statistics.find((span) => span.name === name)?.count;
+    expect(spanCount('sync')).to.equal(2);
+    expect(spanCount('async')).to.equal(1);
+    expect(spanCount('throwing')).to.equal(1);
+    expect(statistics.find((span) => span.name === 'async')?.p95InMs).to.be.greaterThan(1);
+    expect(getTraceCounters().get('counter')).to.equal(3);
+  });
+
+  it('traces the ccalls of a library by function name', () => {
+    enableTracing();
+    const ccall = traceCcall('library', (name: string, returnType: string) => `${name}:${returnType}`);
+    expect(ccall('cs_open', 'number')).to.equal('cs_open:number');
+    expect(getTraceSpanStatistics().map((span) => span.name)).to.eql(['library.cs_open']);
+  });
+
+  it('exports complete and counter events in the Chrome trace event format', () => {
+    enableTracing();
+    traceSpan('span', () => undefined);
+    countTrace('counter');
+    const { traceEvents } = JSON.parse(exportChromeTrace());
+    expect(traceEvents.map((event: { name: string; ph: string }) => [event.name, event.ph])).to.eql([['span', 'X'], ['counter', 'C']]);
+    expect(traceEvents[0].dur).to.be.a('number');
+  });
+
+  it('reads the trace flag from the query and from the query of the hash route', () => {
+    expect(hasTraceQueryFlag({ search: '?trace', hash: '' })).to.equal(true);
+    expect(hasTraceQueryFlag({ search: '', hash: '#/run/abc?trace=1' })).to.equal(true);
+    expect(hasTraceQueryFlag({ search: '?other', hash: '#/run/trace' })).to.equal(false);
+  });
+});
@@ -0,0 +1,87 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * CPUSim
+ *
+ * Copyright © 2021 by Eliane Schmidli <seliane.github@gmail.com> and Yves Boillat <yvbo@protonmail.com>
+ * Modified 2022 by Michael Schneider <michael.schneider@hispeed.com> and Tobias Petter <tobiaspetter@chello.at>
+ *
+ * This file is part of CPUSim
+ *
+ * CPUSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 2 of the License only.
+ *
+ * CPUSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CPUSim.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+import { expect } from 'chai';
+import StepController from '@/services/stepController';
+import DebuggerController from '@/services/debuggerController';
+import mapLinesToMemory from '@/services/debuggerService/mapLinesToMemoryService';
+import Program from '@/services/interfaces/Program';
+import { getChangeHistoryLength } from '@/services/dataServices/changeHistoryService';
+import { startStackExampleProgram } from './testEmulator';
+
+async function createDebuggerController(program: Program) {
+  const stepController = new StepController(program);
+  const editorLines = await mapLinesToMemory(program);
+  return { stepController, debuggerController: new DebuggerController(stepController, editorLines) };
+}
+
+describe('Turbo playback', () => {
+  it('commits the state and the change history during runs', async () => {
+    const referenceProgram = await startStackExampleProgram();
+    const reference = await createDebuggerController(referenceProgram);
+    await reference.debuggerController.runToEndOfProgram();
+
+    const program = await startStackExampleProgram();
+    const { stepController, debuggerController } = await createDebuggerController(program);
+    const committedHistoryLengths: Array<number> = [];
+    debuggerController.setTurboPlayback({
+      instructionsPerCommit: 2,
+      frameBudgetInMs: Number.MAX_VALUE,
+      commit: async () => {
+        committedHistoryLengths.push(getChangeHistoryLength(stepController.getState().changeHistory));
+      },
+    });
+    await debuggerController.runToEndOfProgram();
+
+    const expectedChangeHistory = reference.stepController.getState().changeHistory;
+    expect(committedHistoryLengths.length).to.be.greaterThan(1);
+    expect(committedHistoryLengths[0]).to.equal(2);
+    expect(stepController.getState().changeHistory).to.eql(expectedChangeHistory);
+
+    referenceProgram.ucInstance.close();
+    stepController.getProgram().ucInstance.close();
+  });
+
+  it('restores the change history when stepping back after a turbo run', async () => {
+    const referenceProgram = await startStackExampleProgram();
+    const reference = await createDebuggerController(referenceProgram);
+    await reference.debuggerController.runToEndOfProgram();
+
+    const program = await startStackExampleProgram();
+    const { stepController, debuggerController } = await createDebuggerController(program);
+    debuggerController.setTurboPlayback({
+      instructionsPerCommit: 4,
+      frameBudgetInMs: Number.MAX_VALUE,
+      commit: async () => Promise.resolve(),
+    });
+    await debuggerController.runToEndOfProgram();
+
+    for (let step = 0; step < 4; step += 1) {
+      await reference.stepController.previousStep();
+      await stepController.previousStep();
+      expect(stepController.getState().changeHistory).to.eql(reference.stepController.getState().changeHistory);
+    }
+
+    reference.stepController.getProgram().ucInstance.close();
+    stepController.getProgram().ucInstance.close();
+  });
+});
@@ -25,9 +25,19 @@
 
 // const HtmlWebpackPlugin = require('html-webpack-plugin');
 // const HtmlWebpackInlineSourcePlugin = require('@effortlessmotion/html-webpack-inline-source-plugin');
+const path = require('path');
+const webpack = require('webpack');
 const { defineConfig } = require('@vue/cli-service');
 const NodePolyfillPlugin = require('node-polyfill-webpack-plugin');
 
+// The engines in lib/ are imported on first use, production builds embed them compressed (see engineModuleService.ts)
+const engineRules = process.env.NODE_ENV === 'production' ? [{
+  test: /\.js$/,
+  include: path.resolve(__dirname, 'lib'),
+  enforce: 'pre',
+  use: path.resolve(__dirname, 'scripts/compressedEngineLoader.js'),
+}] : [];
+
 module.exports = defineConfig({
   publicPath: process.env.NODE_ENV === "production" ? "/CPUSim/" : "./",
   productionSourceMap: false,
@@ -52,8 +62,13 @@ module.exports = defineConfig({
         fs: false,
       },
     },
+    module: {
+      rules: engineRules,
+    },
     plugins: [
       new NodePolyfillPlugin(),
+      // lazily imported engines stay in the single bundle, their modules are evaluated on first import
+      new webpack.optimize.LimitChunkCountPlugin({ maxChunks: 1 }),
       //   new HtmlWebpackPlugin({
       //     template: 'public/index.html', // template file to embed the source
       //     inlineSource: '.(js|css)$', // embed all javascript and css inline